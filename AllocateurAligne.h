@@ -0,0 +1,76 @@
+/**
+ * \file AllocateurAligne.h
+ * \brief Allocateur STL qui aligne les blocs alloués (pour les chargements SIMD).
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+#ifndef _ALLOCATEURALIGNE__H
+#define _ALLOCATEURALIGNE__H
+
+namespace TP2
+{
+
+/**
+ * \class AllocateurAligne
+ * \brief Allocateur dont les blocs commencent sur une frontière de Alignement octets
+ */
+    template <typename T, std::size_t Alignement = 32>
+    class AllocateurAligne
+    {
+    public:
+        typedef T value_type;
+
+        template <typename U>
+        struct rebind { typedef AllocateurAligne<U, Alignement> other; };
+
+        AllocateurAligne() {}
+
+        template <typename U>
+        AllocateurAligne(const AllocateurAligne<U, Alignement>&) {}
+
+        T* allocate(std::size_t n)
+        {
+            void* bloc = nullptr;
+#ifdef _WIN32
+            bloc = _aligned_malloc(n * sizeof(T), Alignement);
+#else
+            if (posix_memalign(&bloc, Alignement, n * sizeof(T)) != 0)
+                bloc = nullptr;
+#endif
+            if (bloc == nullptr)
+                throw std::bad_alloc();
+            return static_cast<T*>(bloc);
+        }
+
+        void deallocate(T* bloc, std::size_t)
+        {
+#ifdef _WIN32
+            _aligned_free(bloc);
+#else
+            std::free(bloc);
+#endif
+        }
+    };
+
+    template <typename T, typename U, std::size_t A>
+    bool operator==(const AllocateurAligne<T, A>&, const AllocateurAligne<U, A>&) { return true; }
+
+    template <typename T, typename U, std::size_t A>
+    bool operator!=(const AllocateurAligne<T, A>&, const AllocateurAligne<U, A>&) { return false; }
+
+    // Vecteur dont les données sont alignées sur 32 octets (un registre AVX)
+    template <typename T>
+    using VecteurAligne = std::vector<T, AllocateurAligne<T, 32> >;
+
+}//Fin du namespace
+
+#endif
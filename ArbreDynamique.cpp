@@ -0,0 +1,261 @@
+/**
+ * \file ArbreDynamique.cpp
+ * \brief Implémentation de l'arbre dynamique des plus courts chemins.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <limits>
+
+#include "ArbreDynamique.h"
+
+namespace TP2
+{
+
+    namespace
+    {
+        const float INFINI = std::numeric_limits<float>::infinity();
+        const unsigned int AUCUN = UINT_MAX;
+
+        typedef std::pair<float, unsigned int> Entree;
+    }
+
+    /**
+     * @brief Constructeur : copie le graphe sous forme de vues directe et inverse.
+     * @param graphe Le graphe.
+     * @throws std::logic_error Si un arc est négatif.
+     */
+    VuesArbres::VuesArbres(const Graphe& graphe) :
+            vue(graphe.construireVueAdjacence()), inverse(graphe.construireVueAdjacence(true))
+    {
+        if (!graphe.arcsSontNonNegatifs())
+        {
+            throw std::logic_error("ArbreDynamique : les arcs ne sont pas tous non négatifs");
+        }
+    }
+
+    /**
+     * @brief Change les pondérations d'un arc dans les deux vues.
+     * @param source Le sommet source de l'arc.
+     * @param destination Le sommet destination de l'arc.
+     * @param duree La nouvelle durée de l'arc.
+     * @param cout Le nouveau coût de l'arc.
+     * @return Les pondérations de l'arc avant le changement.
+     * @throws std::logic_error Si l'arc n'existe pas ou si une pondération est négative.
+     */
+    Ponderations VuesArbres::modifier(size_t source, size_t destination, float duree, float cout)
+    {
+        if (duree < 0 || cout < 0)
+        {
+            throw std::logic_error("ArbreDynamique::modifierPonderations : pondération négative");
+        }
+
+        size_t arc = indiceArc(vue, source, destination);
+        size_t arcInverse = indiceArc(inverse, destination, source);
+        Ponderations anciennes(vue.durees[arc], vue.couts[arc]);
+        vue.durees[arc] = inverse.durees[arcInverse] = duree;
+        vue.couts[arc] = inverse.couts[arcInverse] = cout;
+        return anciennes;
+    }
+
+    /**
+     * @brief Constructeur : calcule l'arbre complet avec Dijkstra.
+     * @param vues La copie du graphe, partagée avec les arbres de toutes les origines suivies.
+     * @param origine Le sommet d'origine.
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @throws std::logic_error Si l'origine est invalide.
+     */
+    ArbreDynamique::ArbreDynamique(const std::shared_ptr<const VuesArbres>& vues, size_t origine, bool dureeCout) :
+            origine(origine), dureeCout(dureeCout), vues(vues)
+    {
+        const size_t n = vues->vue.nbSommets();
+        if (origine >= n)
+        {
+            throw std::logic_error("ArbreDynamique : origine invalide");
+        }
+
+        distances.assign(n, INFINI);
+        predecesseurs.assign(n, AUCUN);
+        estTouche.assign(n, false);
+        distances[origine] = 0.0;
+
+        std::vector<Entree> tas(1, Entree(0.0f, static_cast<unsigned int>(origine)));
+        propager(tas);
+    }
+
+    /**
+     * @brief Répare l'arbre après un changement de pondération déjà appliqué aux vues.
+     * @param source Le sommet source de l'arc modifié.
+     * @param destination Le sommet destination de l'arc modifié.
+     * @param anciennes Les pondérations de l'arc avant le changement.
+     * @throws std::logic_error Si l'arc n'existe pas.
+     */
+    void ArbreDynamique::reparer(size_t source, size_t destination, const Ponderations& anciennes)
+    {
+        const VueAdjacence& vue = vues->vue;
+        const std::vector<float>& poidsVue = vue.ponderations(dureeCout);
+        float poids = poidsVue[VuesArbres::indiceArc(vue, source, destination)];
+        if (poids == (dureeCout ? anciennes.duree : anciennes.cout))
+        {
+            // Seule la pondération de l'autre critère a changé
+            return;
+        }
+
+        std::vector<Entree> tas;
+        if (distances[source] + poids < distances[destination])
+        {
+            // Baisse : la destination s'améliore, et l'amélioration se propage à ses descendants
+            distances[destination] = distances[source] + poids;
+            predecesseurs[destination] = static_cast<unsigned int>(source);
+            tas.push_back(Entree(distances[destination], static_cast<unsigned int>(destination)));
+            propager(tas);
+        }
+        else if (predecesseurs[destination] == source)
+        {
+            // Hausse sur un arc de l'arbre : le sous-arbre de destination est invalidé
+            touches.assign(1, static_cast<unsigned int>(destination));
+            estTouche[destination] = true;
+            for (size_t i = 0; i < touches.size(); ++i)
+            {
+                unsigned int u = touches[i];
+                for (size_t a = vue.debut[u]; a < vue.debut[u + 1]; ++a)
+                {
+                    unsigned int v = vue.destinations[a];
+                    if (predecesseurs[v] == u && !estTouche[v])
+                    {
+                        estTouche[v] = true;
+                        touches.push_back(v);
+                    }
+                }
+            }
+
+            // Chaque sommet touché repart du meilleur arc entrant venant d'un sommet intact
+            const VueAdjacence& inverse = vues->inverse;
+            const std::vector<float>& poidsInverse = inverse.ponderations(dureeCout);
+            for (auto v : touches)
+            {
+                distances[v] = INFINI;
+                predecesseurs[v] = AUCUN;
+                for (size_t a = inverse.debut[v]; a < inverse.debut[v + 1]; ++a)
+                {
+                    unsigned int u = inverse.destinations[a];
+                    if (!estTouche[u] && distances[u] + poidsInverse[a] < distances[v])
+                    {
+                        distances[v] = distances[u] + poidsInverse[a];
+                        predecesseurs[v] = u;
+                    }
+                }
+                if (distances[v] != INFINI)
+                {
+                    tas.push_back(Entree(distances[v], v));
+                }
+            }
+            for (auto v : touches)
+            {
+                estTouche[v] = false;
+            }
+            std::make_heap(tas.begin(), tas.end(), std::greater<Entree>());
+            propager(tas);
+        }
+        // Sinon : hausse sur un arc hors de l'arbre, aucune distance ne change
+    }
+
+    /**
+     * @brief Dijkstra à partir des entrées du tas; les distances ne peuvent que diminuer.
+     * @param tas Un tas (min) d'entrées (distance provisoire, sommet).
+     */
+    void ArbreDynamique::propager(std::vector<Entree>& tas)
+    {
+        const VueAdjacence& vue = vues->vue;
+        const std::vector<float>& poids = vue.ponderations(dureeCout);
+        while (!tas.empty())
+        {
+            std::pop_heap(tas.begin(), tas.end(), std::greater<Entree>());
+            Entree entree = tas.back();
+            tas.pop_back();
+
+            unsigned int u = entree.second;
+            // Une entrée périmée : le sommet a été amélioré depuis
+            if (entree.first > distances[u])
+            {
+                continue;
+            }
+
+            for (size_t a = vue.debut[u]; a < vue.debut[u + 1]; ++a)
+            {
+                unsigned int v = vue.destinations[a];
+                float tmp = distances[u] + poids[a];
+                if (tmp < distances[v])
+                {
+                    distances[v] = tmp;
+                    predecesseurs[v] = u;
+                    tas.push_back(Entree(tmp, v));
+                    std::push_heap(tas.begin(), tas.end(), std::greater<Entree>());
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Retourne l'indice d'un arc dans une vue d'adjacence.
+     * @throws std::logic_error Si l'arc n'existe pas.
+     */
+    size_t VuesArbres::indiceArc(const VueAdjacence& vue, size_t source, size_t destination)
+    {
+        if (source >= vue.nbSommets() || destination >= vue.nbSommets())
+        {
+            throw std::logic_error("ArbreDynamique : sommet invalide");
+        }
+        for (size_t a = vue.debut[source]; a < vue.debut[source + 1]; ++a)
+        {
+            if (vue.destinations[a] == destination)
+            {
+                return a;
+            }
+        }
+        throw std::logic_error("ArbreDynamique : l'arc n'existe pas");
+    }
+
+    /**
+     * @brief Retourne la distance d'un sommet depuis l'origine.
+     * @throws std::logic_error Si le sommet est invalide.
+     */
+    float ArbreDynamique::getDistance(size_t sommet) const
+    {
+        if (sommet >= distances.size())
+        {
+            throw std::logic_error("ArbreDynamique::getDistance : sommet invalide");
+        }
+        return distances[sommet];
+    }
+
+    /**
+     * @brief Retourne le prédécesseur d'un sommet dans l'arbre.
+     * @throws std::logic_error Si le sommet est invalide.
+     */
+    unsigned int ArbreDynamique::getPredecesseur(size_t sommet) const
+    {
+        if (sommet >= predecesseurs.size())
+        {
+            throw std::logic_error("ArbreDynamique::getPredecesseur : sommet invalide");
+        }
+        return predecesseurs[sommet];
+    }
+
+    size_t ArbreDynamique::getOrigine() const
+    {
+        return origine;
+    }
+
+    bool ArbreDynamique::getDureeCout() const
+    {
+        return dureeCout;
+    }
+
+}//Fin du namespace TP2
@@ -0,0 +1,94 @@
+/**
+ * \file ArbreDynamique.h
+ * \brief Arbre des plus courts chemins d'une origine, réparé à chaque changement de pondération.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include "Graphe.h"
+#include <memory>
+#include <vector>
+
+#ifndef _ARBREDYNAMIQUE__H
+#define _ARBREDYNAMIQUE__H
+
+namespace TP2
+{
+
+/**
+ * \struct VuesArbres
+ * \brief Copie d'un graphe (vues directe et inverse) partagée par les arbres de toutes les origines suivies
+ */
+    struct VuesArbres
+    {
+        VueAdjacence vue;		// Pondérations tenues à jour par modifier
+        VueAdjacence inverse;
+
+        // Copie le graphe
+        // Exception logic_error si un arc est négatif
+        explicit VuesArbres(const Graphe& graphe);
+
+        // Change les pondérations de l'arc source -> destination et retourne les anciennes
+        // Exception logic_error si l'arc n'existe pas ou si une pondération est négative
+        Ponderations modifier(size_t source, size_t destination, float duree, float cout);
+
+        // Retourne l'indice de l'arc source -> destination dans une vue
+        // Exception logic_error si l'arc n'existe pas
+        static size_t indiceArc(const VueAdjacence& vue, size_t source, size_t destination);
+    };
+
+/**
+ * \class ArbreDynamique
+ * \brief Plus courts chemins depuis une origine pour un critère, maintenus incrémentalement
+ *
+ * Lorsqu'une pondération change, seule la partie touchée de l'arbre est recalculée (à la manière de
+ * Ramalingam et Reps) : une baisse se propage depuis la destination de l'arc, une hausse sur un arc de
+ * l'arbre invalide le sous-arbre de sa destination, qui est ensuite reconstruit à partir de ses bords.
+ * Les arbres de toutes les origines suivies lisent la même copie du graphe (VuesArbres), mise à jour une
+ * seule fois par modification avant leurs réparations.
+ */
+    class ArbreDynamique
+    {
+    public:
+
+        // Calcule l'arbre des plus courts chemins de origine dans le graphe copié par vues
+        // si dureeCout = true, on utilise la durée comme pondération, sinon le coût
+        // Exception logic_error si origine supérieur au nombre de sommets
+        ArbreDynamique(const std::shared_ptr<const VuesArbres>& vues, size_t origine, bool dureeCout);
+
+        // Répare l'arbre après que vues->modifier a changé l'arc source -> destination.
+        // anciennes : les pondérations de l'arc avant le changement. Rien à faire si celle du critère est inchangée.
+        void reparer(size_t source, size_t destination, const Ponderations& anciennes);
+
+        // Retourne la distance depuis l'origine (+infini si le sommet n'est pas atteignable)
+        float getDistance(size_t sommet) const;
+
+        // Retourne le prédécesseur d'un sommet dans l'arbre (UINT_MAX pour l'origine et les sommets non atteints)
+        unsigned int getPredecesseur(size_t sommet) const;
+
+        size_t getOrigine() const;
+        bool getDureeCout() const;
+
+    private:
+
+        size_t origine;
+        bool dureeCout;
+
+        std::shared_ptr<const VuesArbres> vues;
+
+        std::vector<float> distances;
+        std::vector<unsigned int> predecesseurs;
+
+        std::vector<unsigned int> touches;	// Sous-arbre invalidé par une hausse
+        std::vector<bool> estTouche;		// Marques des sommets de touches, remises à false après chaque réparation
+
+        // Dijkstra depuis les sommets déjà dans le tas (distances provisoires posées par l'appelant)
+        void propager(std::vector<std::pair<float, unsigned int> >& tas);
+    };
+
+}//Fin du namespace
+
+#endif
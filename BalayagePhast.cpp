@@ -0,0 +1,430 @@
+/**
+ * \file BalayagePhast.cpp
+ * \brief Implémentation de la hiérarchie de contraction et du balayage PHAST.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+#include "BalayagePhast.h"
+#include "AllocateurAligne.h"
+#include "Parallelisme.h"
+
+namespace TP2
+{
+
+    namespace
+    {
+        const float INFINI = std::numeric_limits<float>::infinity();
+
+        // Nombre maximal de sommets solutionnés par une recherche de témoin; au-delà, le raccourci est ajouté
+        const size_t LIMITE_TEMOINS = 500;
+
+        typedef std::pair<float, uint32_t> Element;
+
+        struct ArcContraction
+        {
+            uint32_t sommet;
+            float poids;
+        };
+
+        struct Raccourci
+        {
+            uint32_t source;
+            uint32_t destination;
+            float poids;
+        };
+
+        // Graphe restant pendant la contraction
+        class Contraction
+        {
+        public:
+            std::vector<std::vector<ArcContraction> > sortants;
+            std::vector<std::vector<ArcContraction> > entrants;
+            std::vector<uint32_t> nbVoisinsContractes;
+
+            Contraction(const VueAdjacence& vue, bool dureeCout) :
+                    sortants(vue.nbSommets()), entrants(vue.nbSommets()), nbVoisinsContractes(vue.nbSommets(), 0),
+                    distances(vue.nbSommets(), INFINI), cible(vue.nbSommets(), 0)
+            {
+                const std::vector<float>& poids = vue.ponderations(dureeCout);
+                for (uint32_t u = 0; u < vue.nbSommets(); ++u)
+                {
+                    for (size_t a = vue.debut[u]; a < vue.debut[u + 1]; ++a)
+                    {
+                        if (vue.destinations[a] != u)
+                            ajouter(u, vue.destinations[a], poids[a]);
+                    }
+                }
+            }
+
+            // Ajoute l'arc u -> w, ou diminue son poids s'il existe déjà
+            void ajouter(uint32_t u, uint32_t w, float poids)
+            {
+                for (auto& arc : sortants[u])
+                {
+                    if (arc.sommet == w)
+                    {
+                        if (poids < arc.poids)
+                        {
+                            arc.poids = poids;
+                            for (auto& inverse : entrants[w])
+                            {
+                                if (inverse.sommet == u)
+                                    inverse.poids = poids;
+                            }
+                        }
+                        return;
+                    }
+                }
+                ArcContraction sortant = {w, poids};
+                ArcContraction entrant = {u, poids};
+                sortants[u].push_back(sortant);
+                entrants[w].push_back(entrant);
+            }
+
+            // Raccourcis nécessaires pour contracter v
+            void raccourcis(uint32_t v, std::vector<Raccourci>& resultat)
+            {
+                resultat.clear();
+                for (const auto& entrant : entrants[v])
+                {
+                    float limite = -1.0;
+                    for (const auto& sortant : sortants[v])
+                    {
+                        if (sortant.sommet != entrant.sommet)
+                            limite = std::max(limite, entrant.poids + sortant.poids);
+                    }
+                    if (limite < 0)
+                        continue;
+
+                    size_t nbCibles = 0;
+                    for (const auto& sortant : sortants[v])
+                    {
+                        if (sortant.sommet != entrant.sommet && !cible[sortant.sommet])
+                        {
+                            cible[sortant.sommet] = 1;
+                            nbCibles++;
+                        }
+                    }
+                    temoins(entrant.sommet, v, limite, nbCibles);
+                    for (const auto& sortant : sortants[v])
+                    {
+                        float via = entrant.poids + sortant.poids;
+                        if (sortant.sommet != entrant.sommet && distances[sortant.sommet] > via)
+                        {
+                            Raccourci raccourci = {entrant.sommet, sortant.sommet, via};
+                            resultat.push_back(raccourci);
+                        }
+                        cible[sortant.sommet] = 0;
+                    }
+                    for (auto w : touches)
+                        distances[w] = INFINI;
+                    touches.clear();
+                }
+            }
+
+            // Différence d'arcs de la contraction de v (raccourcis comptés double), plus ses voisins déjà contractés
+            int priorite(uint32_t v, std::vector<Raccourci>& tampon)
+            {
+                raccourcis(v, tampon);
+                return 2 * static_cast<int>(tampon.size()) - static_cast<int>(sortants[v].size() + entrants[v].size())
+                       + static_cast<int>(nbVoisinsContractes[v]);
+            }
+
+            // Retire v du graphe restant
+            void retirer(uint32_t v)
+            {
+                for (const auto& sortant : sortants[v])
+                {
+                    std::vector<ArcContraction>& liste = entrants[sortant.sommet];
+                    liste.erase(std::remove_if(liste.begin(), liste.end(),
+                                               [v](const ArcContraction& arc) { return arc.sommet == v; }), liste.end());
+                    nbVoisinsContractes[sortant.sommet]++;
+                }
+                for (const auto& entrant : entrants[v])
+                {
+                    std::vector<ArcContraction>& liste = sortants[entrant.sommet];
+                    liste.erase(std::remove_if(liste.begin(), liste.end(),
+                                               [v](const ArcContraction& arc) { return arc.sommet == v; }), liste.end());
+                    nbVoisinsContractes[entrant.sommet]++;
+                }
+                std::vector<ArcContraction>().swap(sortants[v]);
+                std::vector<ArcContraction>().swap(entrants[v]);
+            }
+
+        private:
+            std::vector<float> distances;
+            std::vector<uint8_t> cible;		// Arrivées des arcs sortants du sommet contracté
+            std::vector<uint32_t> touches;
+            std::vector<Element> tas;
+
+            // Dijkstra depuis u sans passer par exclu, arrêté quand les nbCibles cibles sont solutionnées, à la
+            // distance limite ou après LIMITE_TEMOINS sommets
+            void temoins(uint32_t u, uint32_t exclu, float limite, size_t nbCibles)
+            {
+                distances[u] = 0.0;
+                touches.push_back(u);
+                tas.push_back(Element(0.0f, u));
+                size_t nbSolutionnes = 0;
+                while (!tas.empty())
+                {
+                    std::pop_heap(tas.begin(), tas.end(), std::greater<Element>());
+                    Element courant = tas.back();
+                    tas.pop_back();
+                    if (courant.first > distances[courant.second])
+                        continue;
+                    if (courant.first > limite || ++nbSolutionnes > LIMITE_TEMOINS)
+                        break;
+                    if (cible[courant.second] && --nbCibles == 0)
+                        break;
+                    for (const auto& arc : sortants[courant.second])
+                    {
+                        if (arc.sommet == exclu)
+                            continue;
+                        float tmp = courant.first + arc.poids;
+                        if (tmp < distances[arc.sommet])
+                        {
+                            if (distances[arc.sommet] == INFINI)
+                                touches.push_back(arc.sommet);
+                            distances[arc.sommet] = tmp;
+                            tas.push_back(Element(tmp, arc.sommet));
+                            std::push_heap(tas.begin(), tas.end(), std::greater<Element>());
+                        }
+                    }
+                }
+                tas.clear();
+            }
+        };
+
+        // Range des arcs (sommet -> liste) dans un CSR indexé par position de balayage
+        void ranger(const std::vector<std::vector<ArcContraction> >& listes, const std::vector<uint32_t>& position,
+                    const std::vector<uint32_t>& sommetPosition, std::vector<size_t>& debut,
+                    std::vector<uint32_t>& sommets, std::vector<float>& poids)
+        {
+            const size_t n = position.size();
+            debut.assign(n + 1, 0);
+            for (size_t i = 0; i < n; ++i)
+                debut[i + 1] = debut[i] + listes[sommetPosition[i]].size();
+            sommets.resize(debut[n]);
+            poids.resize(debut[n]);
+            for (size_t i = 0; i < n; ++i)
+            {
+                size_t a = debut[i];
+                for (const auto& arc : listes[sommetPosition[i]])
+                {
+                    sommets[a] = position[arc.sommet];
+                    poids[a++] = arc.poids;
+                }
+            }
+        }
+    }
+
+    const size_t BalayagePhast::LARGEUR;
+
+    struct BalayagePhast::Espace
+    {
+        VecteurAligne<float> distances;	// distances[i * LARGEUR + voie] : position i, origine de la voie
+        std::vector<Element> tas;
+    };
+
+    /**
+     * @brief Constructeur : contraction des sommets, puis rangement des arcs par position de balayage.
+     * Quand v est contracté, ses arcs restants mènent tous à des sommets de rang supérieur : ses arcs sortants
+     * deviennent ses arcs montants, et ses arcs entrants ses arcs descendants.
+     * @param vue La vue d'adjacence du graphe.
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @throws std::logic_error Si un arc est négatif.
+     */
+    BalayagePhast::BalayagePhast(const VueAdjacence& vue, bool dureeCout) :
+            nbRaccourcis(0)
+    {
+        const size_t n = vue.nbSommets();
+        for (auto p : vue.ponderations(dureeCout))
+        {
+            if (p < 0)
+                throw std::logic_error("BalayagePhast : les arcs ne sont pas tous non négatifs");
+        }
+
+        Contraction graphe(vue, dureeCout);
+        std::vector<std::vector<ArcContraction> > arcsMontants(n), arcsDescendants(n);
+        std::vector<Raccourci> tampon;
+        std::vector<int> priorites(n);
+        std::vector<uint8_t> contracte(n, 0);
+        typedef std::pair<int, uint32_t> Candidat;
+        std::vector<Candidat> file;
+        for (uint32_t v = 0; v < n; ++v)
+        {
+            priorites[v] = graphe.priorite(v, tampon);
+            file.push_back(Candidat(priorites[v], v));
+        }
+        std::make_heap(file.begin(), file.end(), std::greater<Candidat>());
+
+        position.resize(n);
+        sommetPosition.resize(n);
+        size_t rang = 0;
+        while (!file.empty())
+        {
+            std::pop_heap(file.begin(), file.end(), std::greater<Candidat>());
+            Candidat candidat = file.back();
+            file.pop_back();
+            const uint32_t v = candidat.second;
+            if (contracte[v] || candidat.first != priorites[v])
+                continue;
+
+            // Mise à jour paresseuse : la priorité a pu augmenter depuis son dernier calcul
+            priorites[v] = graphe.priorite(v, tampon);
+            if (!file.empty() && priorites[v] > file.front().first)
+            {
+                file.push_back(Candidat(priorites[v], v));
+                std::push_heap(file.begin(), file.end(), std::greater<Candidat>());
+                continue;
+            }
+
+            contracte[v] = 1;
+            position[v] = static_cast<uint32_t>(n - 1 - rang);
+            sommetPosition[n - 1 - rang] = v;
+            ++rang;
+            arcsMontants[v] = graphe.sortants[v];
+            arcsDescendants[v] = graphe.entrants[v];
+            for (const auto& raccourci : tampon)
+                graphe.ajouter(raccourci.source, raccourci.destination, raccourci.poids);
+            nbRaccourcis += tampon.size();
+
+            std::vector<uint32_t> voisins;
+            for (const auto& arc : arcsMontants[v])
+                voisins.push_back(arc.sommet);
+            for (const auto& arc : arcsDescendants[v])
+                voisins.push_back(arc.sommet);
+            graphe.retirer(v);
+            std::sort(voisins.begin(), voisins.end());
+            voisins.erase(std::unique(voisins.begin(), voisins.end()), voisins.end());
+            for (auto w : voisins)
+            {
+                priorites[w] = graphe.priorite(w, tampon);
+                file.push_back(Candidat(priorites[w], w));
+                std::push_heap(file.begin(), file.end(), std::greater<Candidat>());
+            }
+        }
+
+        ranger(arcsMontants, position, sommetPosition, debutMontants, montants, poidsMontants);
+        ranger(arcsDescendants, position, sommetPosition, debutDescendants, origines, poidsDescendants);
+    }
+
+    /**
+     * @brief Distances de chaque origine vers tous les sommets, par groupes de LARGEUR origines.
+     * @param sources Les origines.
+     * @param distances Reçoit sources.size() lignes de nbSommets distances.
+     * @param nbThreads Le nombre de threads (0 = tous les coeurs).
+     * @throws std::logic_error Si une origine est hors du graphe.
+     */
+    void BalayagePhast::calculer(const std::vector<unsigned int>& sources, std::vector<float>& distances,
+                                 unsigned int nbThreads) const
+    {
+        const size_t n = position.size();
+        for (auto s : sources)
+        {
+            if (s >= n)
+                throw std::logic_error("BalayagePhast::calculer : origine hors du graphe");
+        }
+        distances.resize(sources.size() * n);
+
+        const size_t nbGroupes = (sources.size() + LARGEUR - 1) / LARGEUR;
+        nbThreads = nombreThreads(nbThreads);
+        std::vector<Espace> espaces(std::min<size_t>(nbThreads, std::max<size_t>(nbGroupes, 1)));
+        executerEnParallele(nbGroupes, [&](size_t groupe, unsigned int numero)
+        {
+            size_t debut = groupe * LARGEUR;
+            size_t nombre = std::min(LARGEUR, sources.size() - debut);
+            balayer(sources.data() + debut, nombre, espaces[numero], distances.data() + debut * n);
+        }, static_cast<unsigned int>(espaces.size()));
+    }
+
+    size_t BalayagePhast::getNombreRaccourcis() const
+    {
+        return nbRaccourcis;
+    }
+
+    /**
+     * @brief Une recherche vers le haut par origine (chacune dans sa voie), puis le balayage descendant commun.
+     * Les positions sont parcourues par rang décroissant : l'origine d'un arc descendant est déjà définitive.
+     */
+    void BalayagePhast::balayer(const unsigned int* sources, size_t nbSources, Espace& espace, float* distances) const
+    {
+        const size_t n = position.size();
+        espace.distances.assign(n * LARGEUR, INFINI);
+        float* d = espace.distances.data();
+
+        for (size_t voie = 0; voie < nbSources; ++voie)
+        {
+            uint32_t depart = position[sources[voie]];
+            d[depart * LARGEUR + voie] = 0.0;
+            espace.tas.push_back(Element(0.0f, depart));
+            while (!espace.tas.empty())
+            {
+                std::pop_heap(espace.tas.begin(), espace.tas.end(), std::greater<Element>());
+                Element courant = espace.tas.back();
+                espace.tas.pop_back();
+                if (courant.first > d[courant.second * LARGEUR + voie])
+                    continue;
+                for (size_t a = debutMontants[courant.second]; a < debutMontants[courant.second + 1]; ++a)
+                {
+                    float tmp = courant.first + poidsMontants[a];
+                    float& dw = d[montants[a] * LARGEUR + voie];
+                    if (tmp < dw)
+                    {
+                        dw = tmp;
+                        espace.tas.push_back(Element(tmp, montants[a]));
+                        std::push_heap(espace.tas.begin(), espace.tas.end(), std::greater<Element>());
+                    }
+                }
+            }
+        }
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            float* di = d + i * LARGEUR;
+#if defined(__AVX2__)
+            __m256 courantes = _mm256_load_ps(di);
+            for (size_t a = debutDescendants[i]; a < debutDescendants[i + 1]; ++a)
+            {
+                __m256 candidats = _mm256_add_ps(_mm256_load_ps(d + origines[a] * LARGEUR),
+                                                 _mm256_set1_ps(poidsDescendants[a]));
+                courantes = _mm256_min_ps(courantes, candidats);
+            }
+            _mm256_store_ps(di, courantes);
+#else
+            for (size_t a = debutDescendants[i]; a < debutDescendants[i + 1]; ++a)
+            {
+                const float* du = d + origines[a] * LARGEUR;
+                const float poids = poidsDescendants[a];
+                for (size_t voie = 0; voie < LARGEUR; ++voie)
+                {
+                    float candidat = du[voie] + poids;
+                    if (candidat < di[voie])
+                        di[voie] = candidat;
+                }
+            }
+#endif
+        }
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            const uint32_t v = sommetPosition[i];
+            for (size_t voie = 0; voie < nbSources; ++voie)
+                distances[voie * n + v] = d[i * LARGEUR + voie];
+        }
+    }
+
+}//Fin du namespace TP2
@@ -0,0 +1,76 @@
+/**
+ * \file BalayagePhast.h
+ * \brief Distances d'un groupe d'origines vers tous les sommets par balayage d'une hiérarchie de contraction (PHAST).
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include "Graphe.h"
+#include <cstdint>
+#include <vector>
+
+#ifndef _BALAYAGEPHAST__H
+#define _BALAYAGEPHAST__H
+
+namespace TP2
+{
+
+/**
+ * \class BalayagePhast
+ * \brief PHAST (Delling et al.) sur une hiérarchie de contraction, plusieurs origines par balayage
+ *
+ * Prétraitement : les sommets sont contractés un à un (ordre par différence d'arcs, mis à jour paresseusement);
+ * un raccourci u -> w remplace u -> v -> w quand une recherche de témoin limitée ne trouve pas de chemin aussi court
+ * sans v. Les sommets sont ensuite numérotés par rang décroissant (la position de balayage) et les arcs vers un
+ * sommet de rang inférieur sont rangés de façon contiguë par sommet d'arrivée.
+ *
+ * Requête : une recherche vers le haut depuis chaque origine (seulement les arcs vers un rang supérieur), puis un
+ * seul balayage linéaire des positions où chaque sommet prend le minimum sur ses arcs descendants. LARGEUR origines
+ * partagent le balayage : leurs distances sont entrelacées (une voie par origine) et chaque arc est relâché pour
+ * toutes les voies à la fois (une instruction AVX2 si TP2_AVX2 est activé).
+ */
+    class BalayagePhast
+    {
+    public:
+
+        // Nombre d'origines traitées par balayage (voies d'un registre AVX)
+        static const size_t LARGEUR = 8;
+
+        // Construit la hiérarchie du critère dureeCout
+        // Exception logic_error si un arc est négatif
+        BalayagePhast(const VueAdjacence& vue, bool dureeCout);
+
+        // distances[i * nbSommets + v] reçoit la distance de sources[i] à v (+infini si v n'est pas atteignable).
+        // Les groupes de LARGEUR origines sont répartis sur nbThreads threads (0 = tous les coeurs).
+        // Exception logic_error si une origine est hors du graphe
+        void calculer(const std::vector<unsigned int>& sources, std::vector<float>& distances,
+                      unsigned int nbThreads = 0) const;
+
+        // Nombre de raccourcis ajoutés par la contraction
+        size_t getNombreRaccourcis() const;
+
+    private:
+
+        // Tableaux de travail d'un thread (définis dans BalayagePhast.cpp)
+        struct Espace;
+
+        std::vector<uint32_t> position;			// Position de balayage de chaque sommet (0 : rang le plus élevé)
+        std::vector<uint32_t> sommetPosition;	// Sommet de chaque position
+        std::vector<size_t> debutMontants;		// Arcs vers un rang supérieur de la position i : [debutMontants[i], debutMontants[i+1])
+        std::vector<uint32_t> montants;			// Position d'arrivée
+        std::vector<float> poidsMontants;
+        std::vector<size_t> debutDescendants;	// Arcs d'un rang supérieur vers la position i
+        std::vector<uint32_t> origines;			// Position de départ (toujours inférieure à i)
+        std::vector<float> poidsDescendants;
+        size_t nbRaccourcis;
+
+        // Recherches vers le haut et balayage pour au plus LARGEUR origines; écrit leurs lignes de distances
+        void balayer(const unsigned int* sources, size_t nbSources, Espace& espace, float* distances) const;
+    };
+
+}//Fin du namespace
+
+#endif
@@ -0,0 +1,1390 @@
+/**
+ * \file BancEssai.cpp
+ * \brief Banc d'essai des moteurs de recherche : comparaison différentielle avec les algorithmes de référence et
+ * mesure des performances par rapport à une base enregistrée.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ * Utilisation : BancEssai [--graine N] [--reseaux N] [--requetes N] [--villes N] [--base fichier] [--seuil s]
+ *                         [--enregistrer] [--sans-performance]
+ * Code de retour : 0 si tout concorde et qu'aucune mesure ne régresse, 1 si un moteur diverge de la référence,
+ * 2 si une mesure régresse de plus que le seuil.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <queue>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ReseauInterurbain.h"
+#include "ComposantesParalleles.h"
+#include "GrapheCompact.h"
+#include "PlanificateurCellules.h"
+#include "ReseauFedere.h"
+
+using namespace std;
+using namespace TP2;
+
+namespace
+{
+    const float INFINI = numeric_limits<float>::infinity();
+
+    struct Options
+    {
+        uint32_t graine = 1;
+        size_t nbReseaux = 40;			// Réseaux aléatoires de la comparaison différentielle
+        size_t nbRequetes = 200;		// Requêtes par réseau et par critère
+        size_t villesPerformance = 3000;	// Taille du réseau des mesures de performance
+        string base = "BancEssai.base";
+        double seuil = 0.25;			// Régression tolérée (fraction du débit ou de la latence de la base)
+        bool enregistrer = false;
+        bool performance = true;
+    };
+
+    // Une mesure de performance : débit (opérations par seconde) et latences (microsecondes)
+    struct Mesure
+    {
+        double debit;
+        double latenceMediane;
+        double latence99;
+    };
+
+    // Divergences trouvées, par moteur
+    map<string, size_t> divergences;
+    size_t nbComparaisons = 0;
+    bool ponderationsExactes = true;	// Pondérations du réseau courant multiples de 1/4 (voir tirerPonderation)
+
+    void signaler(const string& moteur, const string& detail)
+    {
+        if (divergences[moteur]++ < 3)
+            cout << "  DIVERGENCE [" << moteur << "] " << detail << endl;
+    }
+
+    string nomVille(size_t i)
+    {
+        return "V" + to_string(i);
+    }
+
+    /**
+     * @brief Tire une pondération. Multiples de 1/4 : les sommes sont exactes en float, et tous les moteurs doivent
+     * trouver exactement les mêmes distances. Deux décimales (comme dans le format de fichier) : les sommes sont
+     * arrondies, et seul l'ordre d'addition du chemin (celui de Dijkstra) redonne le total de la référence.
+     * Avec poidsNuls, un huitième des pondérations est nul.
+     * @param maximum La pondération maximale (exclue).
+     */
+    float tirerPonderation(mt19937& generateur, unsigned int maximum, bool deuxDecimales, bool poidsNuls)
+    {
+        if (poidsNuls && generateur() % 8 == 0)
+            return 0.0f;
+        if (deuxDecimales)
+            return static_cast<float>(1 + generateur() % (100 * maximum - 1)) / 100.0f;
+        if (poidsNuls)
+            return static_cast<float>(generateur() % (4 * maximum)) * 0.25f;
+        return static_cast<float>(1 + generateur() % (4 * maximum - 1)) * 0.25f;
+    }
+
+    /**
+     * @brief Remplit un réseau aléatoire (pondérations : voir tirerPonderation). Quelques villes restent sans
+     * trajet (recherches sans chemin).
+     */
+    void genererReseau(ReseauInterurbain& reseau, mt19937& generateur, size_t nbVilles, size_t nbTrajets,
+                       bool deuxDecimales = false, bool poidsNuls = true)
+    {
+        reseau.resize(nbVilles);
+        for (size_t i = 0; i < nbVilles; ++i)
+            reseau.nommer(i, nomVille(i));
+
+        const size_t nbRelies = nbVilles - nbVilles / 10;
+        set<pair<size_t, size_t> > existants;
+        for (size_t k = 0; k < nbTrajets && nbRelies > 1; ++k)
+        {
+            size_t u = generateur() % nbRelies, v = generateur() % nbRelies;
+            if (u == v || !existants.insert(make_pair(u, v)).second)
+                continue;
+            float duree = tirerPonderation(generateur, 10, deuxDecimales, poidsNuls);
+            float cout = tirerPonderation(generateur, 15, deuxDecimales, poidsNuls);
+            reseau.ajouterArc(nomVille(u), nomVille(v), duree, cout);
+        }
+    }
+
+    /**
+     * @brief Vérifie un chemin : extrémités, trajets existants et somme des pondérations égale au total.
+     * @return Une description du problème, vide si le chemin est valide.
+     */
+    string verifierChemin(const ReseauInterurbain& reseau, const Chemin& chemin, const string& origine,
+                          const string& destination, bool dureeCout)
+    {
+        if (chemin.listeVilles.empty())
+            return "chemin vide";
+        if (chemin.listeVilles.front() != origine || chemin.listeVilles.back() != destination)
+            return "extrémités " + chemin.listeVilles.front() + " -> " + chemin.listeVilles.back();
+
+        const Graphe& graphe = reseau.getGraphe();
+        float somme = 0.0;
+        for (size_t i = 0; i + 1 < chemin.listeVilles.size(); ++i)
+        {
+            size_t u = graphe.getNumeroSommet(chemin.listeVilles[i]);
+            size_t v = graphe.getNumeroSommet(chemin.listeVilles[i + 1]);
+            if (!graphe.arcExiste(u, v))
+                return "trajet inexistant " + chemin.listeVilles[i] + " -> " + chemin.listeVilles[i + 1];
+            Ponderations p = graphe.getPonderationsArc(u, v);
+            somme += dureeCout ? p.duree : p.cout;
+        }
+        float total = dureeCout ? chemin.dureeTotale : chemin.coutTotal;
+        if (somme != total)
+            return "somme des trajets " + to_string(somme) + " != total " + to_string(total);
+        return "";
+    }
+
+
+    /**
+     * @brief Somme exacte, en centièmes, des pondérations d'un chemin (pondérations à deux décimales au plus).
+     * @return La somme, UINT64_MAX si un trajet du chemin n'existe pas.
+     */
+    uint64_t sommeCentiemes(const ReseauInterurbain& reseau, const Chemin& chemin, bool dureeCout)
+    {
+        const Graphe& graphe = reseau.getGraphe();
+        uint64_t somme = 0;
+        for (size_t i = 0; i + 1 < chemin.listeVilles.size(); ++i)
+        {
+            size_t u = graphe.getNumeroSommet(chemin.listeVilles[i]);
+            size_t v = graphe.getNumeroSommet(chemin.listeVilles[i + 1]);
+            if (!graphe.arcExiste(u, v))
+                return UINT64_MAX;
+            Ponderations p = graphe.getPonderationsArc(u, v);
+            somme += static_cast<uint64_t>(llround((dureeCout ? p.duree : p.cout) * 100.0));
+        }
+        return somme;
+    }
+
+    /**
+     * @brief Compare un chemin à celui de la référence : réussite, total, validité. Le total doit être celui de la
+     * référence si les sommes sont exactes; sinon les deux chemins doivent avoir la même somme exacte (à égalité
+     * exacte, deux chemins peuvent différer d'un ulp en float et les moteurs sont libres de choisir l'un ou l'autre).
+     * Dans tous les cas, le total doit être la somme des trajets dans l'ordre du chemin.
+     */
+    void comparerChemin(const ReseauInterurbain& reseau, const string& moteur, const Chemin& reference,
+                        const Chemin& chemin, const string& origine, const string& destination, bool dureeCout)
+    {
+        ++nbComparaisons;
+        string requete = origine + " -> " + destination + (dureeCout ? " (durée)" : " (coût)");
+        if (chemin.reussi != reference.reussi)
+        {
+            signaler(moteur, requete + " : reussi = " + to_string(chemin.reussi) + ", référence "
+                             + to_string(reference.reussi));
+            return;
+        }
+        if (!reference.reussi)
+            return;
+        float attendu = dureeCout ? reference.dureeTotale : reference.coutTotal;
+        float obtenu = dureeCout ? chemin.dureeTotale : chemin.coutTotal;
+        if (ponderationsExactes ? obtenu != attendu
+                                : sommeCentiemes(reseau, chemin, dureeCout) != sommeCentiemes(reseau, reference, dureeCout))
+        {
+            signaler(moteur, requete + " : total " + to_string(obtenu) + ", référence " + to_string(attendu));
+            return;
+        }
+        string probleme = verifierChemin(reseau, chemin, origine, destination, dureeCout);
+        if (!probleme.empty())
+            signaler(moteur, requete + " : " + probleme);
+    }
+
+    // Compare une distance (+infini : pas de chemin) au chemin de la référence. Pour les moteurs de la famille de
+    // Dijkstra, qui additionnent dans l'ordre du chemin : l'égalité est exacte quelles que soient les pondérations.
+    void comparerDistance(const string& moteur, const Chemin& reference, float distance, const string& requete,
+                          bool dureeCout)
+    {
+        ++nbComparaisons;
+        float attendu = reference.reussi ? (dureeCout ? reference.dureeTotale : reference.coutTotal) : INFINI;
+        if (distance != attendu)
+            signaler(moteur, requete + " : distance " + to_string(distance) + ", référence " + to_string(attendu));
+    }
+
+    // Même chose pour un moteur qui additionne dans un autre ordre (raccourcis, étiquettes, recherche inverse) :
+    // avec des pondérations à deux décimales, la distance arrondie au centième doit être la somme exacte du
+    // chemin de la référence.
+    void comparerDistanceReordonnee(const ReseauInterurbain& reseau, const string& moteur, const Chemin& reference,
+                                    float distance, const string& requete, bool dureeCout)
+    {
+        if (ponderationsExactes || !reference.reussi || distance == INFINI)
+        {
+            comparerDistance(moteur, reference, distance, requete, dureeCout);
+            return;
+        }
+        ++nbComparaisons;
+        uint64_t attendu = sommeCentiemes(reseau, reference, dureeCout);
+        if (static_cast<uint64_t>(llround(distance * 100.0)) != attendu)
+            signaler(moteur, requete + " : distance " + to_string(distance) + ", référence " + to_string(attendu)
+                             + " centièmes");
+    }
+
+    /**
+     * @brief Compare GrapheCompact à la référence en arithmétique exacte : sa distance en centièmes doit être la
+     * somme exacte du chemin de la référence, et son chemin doit relier les extrémités avec cette même somme.
+     */
+    void comparerCompact(const ReseauInterurbain& reseau, const GrapheCompact& compact, const Chemin& reference,
+                         const string& origine, const string& destination, bool dureeCout)
+    {
+        ++nbComparaisons;
+        const string requete = origine + " -> " + destination + (dureeCout ? " (durée)" : " (coût)");
+        size_t u = compact.getNumeroSommet(origine), v = compact.getNumeroSommet(destination);
+        uint64_t exacte = compact.distanceExacte(u, v, dureeCout);
+        Chemin chemin = compact.rechercheChemin(u, v, dureeCout);
+        if (chemin.reussi != reference.reussi || (exacte != UINT64_MAX) != reference.reussi)
+        {
+            signaler("GrapheCompact", requete + " : reussi = " + to_string(chemin.reussi) + ", référence "
+                                      + to_string(reference.reussi));
+            return;
+        }
+        if (!reference.reussi)
+            return;
+        uint64_t attendu = sommeCentiemes(reseau, reference, dureeCout);
+        if (exacte != attendu)
+        {
+            signaler("GrapheCompact", requete + " : distance " + to_string(exacte) + " centièmes, référence "
+                                      + to_string(attendu));
+            return;
+        }
+        if (chemin.listeVilles.front() != origine || chemin.listeVilles.back() != destination
+            || sommeCentiemes(reseau, chemin, dureeCout) != exacte)
+        {
+            signaler("GrapheCompact", requete + " : chemin invalide ou de somme différente");
+        }
+    }
+
+    /**
+     * @brief Pondération exacte d'un trajet pour la métrique coefDuree * duree + coefCout * cout (coefficients
+     * multiples de 1/2, pondérations à deux décimales au plus), en deux-centièmes.
+     */
+    uint64_t poidsMixte(const Ponderations& poids, float coefDuree, float coefCout)
+    {
+        return static_cast<uint64_t>(llround(coefDuree * 2.0)) * static_cast<uint64_t>(llround(poids.duree * 100.0))
+               + static_cast<uint64_t>(llround(coefCout * 2.0)) * static_cast<uint64_t>(llround(poids.cout * 100.0));
+    }
+
+    /**
+     * @brief Distances de référence pour une métrique mixte, en arithmétique exacte (voir poidsMixte) : Dijkstra
+     * sur les listes d'adjacence du graphe.
+     * @param source Le sommet de départ (numéro du graphe).
+     * @return La distance de chaque sommet en deux-centièmes, UINT64_MAX s'il n'est pas atteint.
+     */
+    vector<uint64_t> distancesMixtesReference(const Graphe& graphe, size_t source, float coefDuree, float coefCout)
+    {
+        typedef pair<uint64_t, size_t> Entree;
+        vector<uint64_t> distances(graphe.getNombreSommets(), UINT64_MAX);
+        priority_queue<Entree, vector<Entree>, greater<Entree> > tas;
+        distances[source] = 0;
+        tas.push(Entree(0, source));
+        while (!tas.empty())
+        {
+            Entree entree = tas.top();
+            tas.pop();
+            size_t u = entree.second;
+            if (entree.first != distances[u])
+                continue;
+            for (auto v : graphe.listerSommetsAdjacents(u))
+            {
+                uint64_t distance = distances[u] + poidsMixte(graphe.getPonderationsArc(u, v), coefDuree, coefCout);
+                if (distance < distances[v])
+                {
+                    distances[v] = distance;
+                    tas.push(Entree(distance, v));
+                }
+            }
+        }
+        return distances;
+    }
+
+    // Numéro dans le graphe de chaque nom de ville (getNumeroSommet est linéaire)
+    unordered_map<string, size_t> indexerNoms(const Graphe& graphe)
+    {
+        unordered_map<string, size_t> numeros;
+        for (size_t s = 0; s < static_cast<size_t>(graphe.getNombreSommets()); ++s)
+            numeros.emplace(graphe.getNomSommet(s), s);
+        return numeros;
+    }
+
+    /**
+     * @brief Compare un chemin (numéros du graphe) d'une métrique mixte à la distance exacte de la référence : il
+     * doit relier source à destination par des trajets existants dont la somme exacte est cette distance.
+     * @param distance La distance trouvée par le moteur (+infini : pas de chemin), vérifiée au deux-centième près.
+     */
+    void comparerCheminMixte(const Graphe& graphe, const string& moteur, const vector<uint64_t>& reference,
+                             size_t source, size_t destination, bool reussi, const vector<size_t>& sommets,
+                             float distance, float coefDuree, float coefCout)
+    {
+        ++nbComparaisons;
+        ostringstream requete;
+        requete << graphe.getNomSommet(source) << " -> " << graphe.getNomSommet(destination) << " (" << coefDuree
+                << " durée + " << coefCout << " coût)";
+        uint64_t attendu = reference[destination];
+        if (reussi != (attendu != UINT64_MAX))
+        {
+            signaler(moteur, requete.str() + " : reussi = " + to_string(reussi) + ", référence "
+                             + to_string(attendu != UINT64_MAX));
+            return;
+        }
+        if (!reussi)
+            return;
+        uint64_t somme = 0;
+        for (size_t i = 0; i + 1 < sommets.size() && somme != UINT64_MAX; ++i)
+        {
+            if (!graphe.arcExiste(sommets[i], sommets[i + 1]))
+                somme = UINT64_MAX;
+            else
+                somme += poidsMixte(graphe.getPonderationsArc(sommets[i], sommets[i + 1]), coefDuree, coefCout);
+        }
+        if (sommets.empty() || sommets.front() != source || sommets.back() != destination || somme != attendu)
+        {
+            signaler(moteur, requete.str() + " : chemin invalide ou de somme " + to_string(somme)
+                             + ", référence " + to_string(attendu) + " deux-centièmes");
+            return;
+        }
+        if (static_cast<uint64_t>(llround(distance * 200.0)) != attendu)
+            signaler(moteur, requete.str() + " : distance " + to_string(distance) + ", référence "
+                             + to_string(attendu) + " deux-centièmes");
+    }
+
+    // Même chose pour un Chemin de rechercheCheminPersonnalise (villes nommées, totaux par critère)
+    void comparerPersonnalise(const ReseauInterurbain& reseau, const unordered_map<string, size_t>& numeros,
+                              const vector<uint64_t>& reference, size_t source, size_t destination,
+                              float coefDuree, float coefCout)
+    {
+        Chemin chemin = reseau.rechercheCheminPersonnalise(reseau.getGraphe().getNomSommet(source),
+                                                           reseau.getGraphe().getNomSommet(destination),
+                                                           coefDuree, coefCout);
+        vector<size_t> sommets;
+        for (const auto& nom : chemin.listeVilles)
+            sommets.push_back(numeros.at(nom));
+        comparerCheminMixte(reseau.getGraphe(), "Personnalise mixte", reference, source, destination, chemin.reussi,
+                            sommets, coefDuree * chemin.dureeTotale + coefCout * chemin.coutTotal, coefDuree,
+                            coefCout);
+    }
+
+    /**
+     * @brief Compare PlanificateurCellules, partitionné en petites cellules pour avoir plusieurs niveaux, à la
+     * référence exacte pour la durée, le coût et une métrique mixte.
+     */
+    void comparerPlanificateur(const ReseauInterurbain& reseau, mt19937& generateur, size_t nbRequetes)
+    {
+        const Graphe& graphe = reseau.getGraphe();
+        const size_t n = reseau.getNombreVilles();
+        shared_ptr<const VueAdjacence> vue = reseau.getVueAdjacence();
+        auto inverse = make_shared<const VueAdjacence>(graphe.construireVueAdjacence(true));
+        PlanificateurCellules planificateur(vue, inverse, vector<size_t>{4, 16, 64}, 2);
+
+        const float coefficients[][2] = {{1.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 0.5f}};
+        vector<unsigned int> chemin;
+        for (const auto& coefs : coefficients)
+        {
+            auto metrique = planificateur.personnaliser(*vue, *inverse, coefs[0], coefs[1]);
+            for (size_t k = 0; k < 3; ++k)
+            {
+                size_t source = generateur() % n;
+                vector<uint64_t> reference = distancesMixtesReference(graphe, source, coefs[0], coefs[1]);
+                for (size_t q = 0; q < nbRequetes / 10 + 1; ++q)
+                {
+                    size_t destination = generateur() % n;
+                    float total = INFINI;
+                    bool reussi = planificateur.chemin(*metrique, static_cast<unsigned int>(source),
+                                                       static_cast<unsigned int>(destination), chemin, total);
+                    comparerCheminMixte(graphe, "PlanificateurCellules", reference, source, destination, reussi,
+                                        vector<size_t>(chemin.begin(), chemin.end()), reussi ? total : 0.0f,
+                                        coefs[0], coefs[1]);
+                    float distance = planificateur.distance(*metrique, static_cast<unsigned int>(source),
+                                                            static_cast<unsigned int>(destination));
+                    ++nbComparaisons;
+                    if ((distance == INFINI) != (reference[destination] == UINT64_MAX)
+                        || (distance != INFINI
+                            && static_cast<uint64_t>(llround(distance * 200.0)) != reference[destination]))
+                        signaler("PlanificateurCellules::distance", graphe.getNomSommet(source) + " -> "
+                                                                    + graphe.getNomSommet(destination));
+                }
+            }
+        }
+    }
+
+    // Chemins de la référence d'une origine vers toutes les villes
+    vector<Chemin> cheminsReference(const ReseauInterurbain& reseau, size_t origine, bool dureeCout)
+    {
+        vector<Chemin> references;
+        for (size_t v = 0; v < reseau.getNombreVilles(); ++v)
+        {
+            references.push_back(reseau.rechercheCheminDijkstra(nomVille(origine), nomVille(v), dureeCout,
+                                                                MoteurRecherche::Reference));
+        }
+        return references;
+    }
+
+    float totalReference(const Chemin& reference, bool dureeCout)
+    {
+        return reference.reussi ? (dureeCout ? reference.dureeTotale : reference.coutTotal) : INFINI;
+    }
+
+    /**
+     * @brief Compare les deux versions de villesAtteignables à l'ensemble des villes dont la distance de la
+     * référence ne dépasse pas le budget. Les budgets sont des distances de la référence (cas limites d'égalité).
+     */
+    void comparerAtteignables(const ReseauInterurbain& reseau, mt19937& generateur, size_t origine,
+                              const vector<Chemin>& references, bool dureeCout)
+    {
+        const size_t n = reseau.getNombreVilles();
+        for (size_t k = 0; k < 2; ++k)
+        {
+            float budget = totalReference(references[generateur() % n], dureeCout);
+            if (budget == INFINI)
+                budget = k == 0 ? 0.0f : 20.0f;
+            const string requete = nomVille(origine) + ", budget " + to_string(budget) + (dureeCout ? " (durée)" : " (coût)");
+
+            vector<unsigned int> attendues;
+            for (size_t v = 0; v < n; ++v)
+            {
+                if (totalReference(references[v], dureeCout) <= budget)
+                    attendues.push_back(static_cast<unsigned int>(v));
+            }
+
+            // Version simple : noms par distance croissante
+            ++nbComparaisons;
+            vector<string> noms = reseau.villesAtteignables(nomVille(origine), budget, dureeCout);
+            vector<unsigned int> obtenues;
+            float precedente = 0.0;
+            bool ordonnees = true;
+            for (const auto& nom : noms)
+            {
+                size_t v = reseau.getNumeroVille(nom);
+                obtenues.push_back(static_cast<unsigned int>(v));
+                ordonnees = ordonnees && totalReference(references[v], dureeCout) >= precedente;
+                precedente = totalReference(references[v], dureeCout);
+            }
+            sort(obtenues.begin(), obtenues.end());
+            if (obtenues != attendues || !ordonnees)
+                signaler("villesAtteignables", requete + " : " + to_string(obtenues.size()) + " villes, référence "
+                                               + to_string(attendues.size()) + (ordonnees ? "" : ", ordre faux"));
+
+            // Version par lots
+            ++nbComparaisons;
+            vector<size_t> origines(2, origine);
+            auto lots = reseau.villesAtteignables(origines, budget, dureeCout, 2);
+            if (lots[0] != attendues || lots[1] != attendues)
+                signaler("villesAtteignables (lots)", requete);
+        }
+    }
+
+    /**
+     * @brief Compare hubsLesPlusProches à la référence : pour chaque ville, le hub retourné doit être à la plus
+     * petite distance (exacte) parmi les hubs, et la distance retournée doit être celle de ce hub.
+     */
+    void comparerHubs(const ReseauInterurbain& reseau, mt19937& generateur, bool dureeCout)
+    {
+        const size_t n = reseau.getNombreVilles();
+        vector<size_t> hubs;
+        vector<string> nomsHubs;
+        for (size_t k = 0; k < 3; ++k)
+        {
+            hubs.push_back(generateur() % n);
+            nomsHubs.push_back(nomVille(hubs.back()));
+        }
+        vector<HubLePlusProche> resultats = reseau.hubsLesPlusProches(nomsHubs, dureeCout);
+
+        for (size_t v = 0; v < n; ++v)
+        {
+            const string requete = nomVille(v) + " -> hubs" + (dureeCout ? " (durée)" : " (coût)");
+            uint64_t meilleure = UINT64_MAX;
+            map<size_t, Chemin> references;
+            for (auto hub : hubs)
+            {
+                Chemin reference = reseau.rechercheCheminDijkstra(nomVille(v), nomVille(hub), dureeCout,
+                                                                  MoteurRecherche::Reference);
+                if (reference.reussi)
+                    meilleure = min(meilleure, sommeCentiemes(reseau, reference, dureeCout));
+                references[hub] = reference;
+            }
+
+            ++nbComparaisons;
+            const HubLePlusProche& resultat = resultats[v];
+            if (resultat.hub == n || meilleure == UINT64_MAX)
+            {
+                if (resultat.hub != n || meilleure != UINT64_MAX || resultat.distance != INFINI)
+                    signaler("hubsLesPlusProches", requete + " : atteignabilité différente de la référence");
+                continue;
+            }
+            auto itr = references.find(resultat.hub);
+            if (itr == references.end() || !itr->second.reussi
+                || sommeCentiemes(reseau, itr->second, dureeCout) != meilleure)
+            {
+                signaler("hubsLesPlusProches", requete + " : " + nomVille(resultat.hub) + " n'est pas le plus proche");
+                continue;
+            }
+            comparerDistanceReordonnee(reseau, "hubsLesPlusProches", itr->second, resultat.distance,
+                                       requete + " " + nomVille(resultat.hub), dureeCout);
+        }
+    }
+
+    /**
+     * @brief Centralité de référence, séquentielle et indépendante de Centralite : pour chaque origine, les distances
+     * de plusCourtsCheminsDepuis (identiques à celles de la référence) définissent le DAG des plus courts chemins
+     * (d[u] + poids == d[v]); on y compte les chemins par distance croissante, puis on accumule les dépendances par
+     * distance décroissante. Pondérations strictement positives seulement : avec des trajets de pondération nulle,
+     * le DAG dépend de l'ordre de solution.
+     * @param villes Reçoit le score de chaque ville.
+     * @param trajets Reçoit le score de chaque trajet (numéros de villes).
+     */
+    void centraliteReference(const ReseauInterurbain& reseau, bool dureeCout, vector<double>& villes,
+                             map<pair<size_t, size_t>, double>& trajets)
+    {
+        const size_t n = reseau.getNombreVilles();
+        const Graphe& graphe = reseau.getGraphe();
+        vector<vector<pair<size_t, float> > > sortants(n);
+        trajets.clear();
+        for (size_t u = 0; u < n; ++u)
+        {
+            size_t ville = reseau.getNumeroVille(graphe.getNomSommet(u));
+            for (auto v : graphe.listerSommetsAdjacents(u))
+            {
+                Ponderations p = graphe.getPonderationsArc(u, v);
+                size_t arrivee = reseau.getNumeroVille(graphe.getNomSommet(v));
+                sortants[ville].push_back(make_pair(arrivee, dureeCout ? p.duree : p.cout));
+                trajets[make_pair(ville, arrivee)] = 0.0;
+            }
+        }
+
+        villes.assign(n, 0.0);
+        for (size_t s = 0; s < n; ++s)
+        {
+            vector<float> d;
+            vector<unsigned int> predecesseurs;
+            reseau.plusCourtsCheminsDepuis(s, dureeCout, d, predecesseurs);
+            vector<size_t> ordre;
+            for (size_t v = 0; v < n; ++v)
+            {
+                if (d[v] != INFINI)
+                    ordre.push_back(v);
+            }
+            stable_sort(ordre.begin(), ordre.end(), [&](size_t a, size_t b) { return d[a] < d[b]; });
+
+            vector<double> sigma(n, 0.0), delta(n, 0.0);
+            sigma[s] = 1.0;
+            for (auto v : ordre)
+            {
+                for (const auto& arc : sortants[v])
+                {
+                    float candidat = d[v] + arc.second;
+                    if (candidat == d[arc.first])
+                        sigma[arc.first] += sigma[v];
+                }
+            }
+            for (size_t i = ordre.size(); i-- > 0;)
+            {
+                size_t v = ordre[i];
+                for (const auto& arc : sortants[v])
+                {
+                    float candidat = d[v] + arc.second;
+                    if (candidat == d[arc.first])
+                    {
+                        double contribution = sigma[v] / sigma[arc.first] * (1.0 + delta[arc.first]);
+                        delta[v] += contribution;
+                        trajets[make_pair(v, arc.first)] += contribution;
+                    }
+                }
+                if (v != s)
+                    villes[v] += delta[v];
+            }
+        }
+    }
+
+    bool procheScore(double obtenu, double attendu)
+    {
+        return fabs(obtenu - attendu) <= 1e-9 * max(1.0, fabs(attendu));
+    }
+
+    // Compare la centralité (calcul exact, deux threads) à la référence séquentielle
+    void comparerCentralite(const ReseauInterurbain& reseau, bool dureeCout)
+    {
+        vector<double> villes;
+        map<pair<size_t, size_t>, double> trajets;
+        centraliteReference(reseau, dureeCout, villes, trajets);
+        CentraliteReseau centralite = reseau.centralite(dureeCout, 0, 0, 2);
+        const string critere = dureeCout ? " (durée)" : " (coût)";
+
+        ++nbComparaisons;
+        if (centralite.nbSources != villes.size() || centralite.villes.size() != villes.size()
+            || centralite.trajets.size() != trajets.size())
+        {
+            signaler("centralite", "tailles différentes" + critere);
+            return;
+        }
+        for (size_t v = 0; v < villes.size(); ++v)
+        {
+            ++nbComparaisons;
+            if (!procheScore(centralite.villes[v], villes[v]))
+                signaler("centralite", nomVille(v) + critere + " : " + to_string(centralite.villes[v])
+                                       + ", référence " + to_string(villes[v]));
+        }
+        for (const auto& trajet : centralite.trajets)
+        {
+            ++nbComparaisons;
+            auto itr = trajets.find(make_pair(trajet.source, trajet.destination));
+            if (itr == trajets.end() || !procheScore(trajet.score, itr->second))
+                signaler("centralite", nomVille(trajet.source) + " -> " + nomVille(trajet.destination) + critere);
+        }
+    }
+
+    /**
+     * @brief Répartit les trajets d'un réseau entre deux opérateurs qui desservent toutes ses villes. Avec des
+     * correspondances gratuites et instantanées, le réseau fédéré équivaut au réseau d'origine.
+     */
+    void partagerEntreOperateurs(const ReseauInterurbain& reseau, mt19937& generateur,
+                                 ReseauInterurbain& operateur1, ReseauInterurbain& operateur2)
+    {
+        const size_t n = reseau.getNombreVilles();
+        const Graphe& graphe = reseau.getGraphe();
+        operateur1.resize(n);
+        operateur2.resize(n);
+        for (size_t v = 0; v < n; ++v)
+        {
+            operateur1.nommer(v, nomVille(v));
+            operateur2.nommer(v, nomVille(v));
+        }
+        for (size_t u = 0; u < n; ++u)
+        {
+            for (auto v : graphe.listerSommetsAdjacents(u))
+            {
+                Ponderations p = graphe.getPonderationsArc(u, v);
+                ReseauInterurbain& operateur = generateur() % 2 == 0 ? operateur1 : operateur2;
+                operateur.ajouterArc(graphe.getNomSommet(u), graphe.getNomSommet(v), p.duree, p.cout);
+            }
+        }
+    }
+
+    /**
+     * @brief Modifie le réseau pendant que des origines sont suivies : changements de pondérations (dont des
+     * changements du seul coût), chacun suivi d'une lecture des arbres réparés, puis ajouts et retraits de trajets.
+     */
+    void modifierReseau(ReseauInterurbain& reseau, mt19937& generateur, const vector<size_t>& suivies,
+                        bool deuxDecimales, bool poidsNuls)
+    {
+        const size_t n = reseau.getNombreVilles();
+        const Graphe& graphe = reseau.getGraphe();
+        vector<pair<string, string> > trajets;
+        for (size_t u = 0; u < n; ++u)
+        {
+            for (auto v : graphe.listerSommetsAdjacents(u))
+                trajets.push_back(make_pair(graphe.getNomSommet(u), graphe.getNomSommet(v)));
+        }
+        if (trajets.empty())
+            return;
+
+        for (size_t k = 0; k < 10; ++k)
+        {
+            const pair<string, string>& trajet = trajets[generateur() % trajets.size()];
+            Ponderations p = graphe.getPonderationsArc(graphe.getNumeroSommet(trajet.first),
+                                                       graphe.getNumeroSommet(trajet.second));
+            float duree = k % 3 == 0 ? p.duree : tirerPonderation(generateur, 10, deuxDecimales, poidsNuls);
+            float cout = k % 3 == 1 ? p.cout : tirerPonderation(generateur, 15, deuxDecimales, poidsNuls);
+            reseau.modifierPonderations(trajet.first, trajet.second, duree, cout);
+
+            for (auto o : suivies)
+            {
+                const string origine = nomVille(o), destination = nomVille(generateur() % n);
+                for (bool dureeCout : {true, false})
+                {
+                    comparerChemin(reseau, "Dynamique (réparé)",
+                                   reseau.rechercheCheminDijkstra(origine, destination, dureeCout,
+                                                                  MoteurRecherche::Reference),
+                                   reseau.rechercheCheminDijkstra(origine, destination, dureeCout,
+                                                                  MoteurRecherche::Dynamique),
+                                   origine, destination, dureeCout);
+                }
+            }
+        }
+
+        for (size_t k = 0; k < 3; ++k)
+        {
+            size_t i = generateur() % trajets.size();
+            reseau.enleverArc(trajets[i].first, trajets[i].second);
+            trajets[i] = trajets.back();
+            trajets.pop_back();
+            if (trajets.empty())
+                break;
+        }
+        for (size_t k = 0; k < 6; ++k)
+        {
+            size_t u = generateur() % n, v = generateur() % n;
+            if (u == v || graphe.arcExiste(graphe.getNumeroSommet(nomVille(u)), graphe.getNumeroSommet(nomVille(v))))
+                continue;
+            reseau.ajouterArc(nomVille(u), nomVille(v), tirerPonderation(generateur, 10, deuxDecimales, poidsNuls),
+                              tirerPonderation(generateur, 15, deuxDecimales, poidsNuls));
+        }
+    }
+
+    /**
+     * @brief Partition canonique : chaque ville reçoit le plus petit numéro de sa composante.
+     * @param composante La composante de chaque ville (numéros de villes).
+     */
+    vector<size_t> canonique(const vector<size_t>& composante)
+    {
+        map<size_t, size_t> representant;
+        vector<size_t> resultat(composante.size());
+        for (size_t v = 0; v < composante.size(); ++v)
+        {
+            auto itr = representant.insert(make_pair(composante[v], v)).first;
+            resultat[v] = itr->second;
+        }
+        return resultat;
+    }
+
+    /**
+     * @brief Composantes fortement connexes de référence : u et v sont dans la même composante si chacun atteint
+     * l'autre (un parcours par ville, O(V (V + E))).
+     */
+    vector<size_t> composantesNaives(const ReseauInterurbain& reseau)
+    {
+        const size_t n = reseau.getNombreVilles();
+        const Graphe& graphe = reseau.getGraphe();
+        vector<vector<char> > atteint(n, vector<char>(n, 0));
+        for (size_t s = 0; s < n; ++s)
+        {
+            size_t depart = graphe.getNumeroSommet(nomVille(s));
+            vector<size_t> pile(1, depart);
+            vector<char> vu(n, 0);
+            vu[depart] = 1;
+            while (!pile.empty())
+            {
+                size_t u = pile.back();
+                pile.pop_back();
+                atteint[s][reseau.getNumeroVille(graphe.getNomSommet(u))] = 1;
+                for (auto v : graphe.listerSommetsAdjacents(u))
+                {
+                    if (!vu[v])
+                    {
+                        vu[v] = 1;
+                        pile.push_back(v);
+                    }
+                }
+            }
+        }
+        vector<size_t> composante(n);
+        for (size_t v = 0; v < n; ++v)
+        {
+            composante[v] = v;
+            for (size_t u = 0; u < v; ++u)
+            {
+                if (atteint[u][v] && atteint[v][u])
+                {
+                    composante[v] = composante[u];
+                    break;
+                }
+            }
+        }
+        return canonique(composante);
+    }
+
+    void comparerPartition(const string& moteur, const vector<size_t>& reference, const vector<size_t>& partition)
+    {
+        ++nbComparaisons;
+        if (partition != reference)
+        {
+            size_t v = 0;
+            while (v < reference.size() && v < partition.size() && reference[v] == partition[v])
+                ++v;
+            signaler(moteur, "partition différente à partir de " + nomVille(v));
+        }
+    }
+
+    // Compare toutes les sources de composantes fortement connexes à la référence naïve
+    void comparerComposantes(ReseauInterurbain& reseau, mt19937& generateur)
+    {
+        const size_t n = reseau.getNombreVilles();
+        const vector<size_t> reference = composantesNaives(reseau);
+        const size_t nbReference = set<size_t>(reference.begin(), reference.end()).size();
+
+        // algorithmeKosaraju
+        vector<size_t> composante(n);
+        auto composantes = reseau.algorithmeKosaraju();
+        for (size_t c = 0; c < composantes.size(); ++c)
+        {
+            for (const auto& nom : composantes[c])
+                composante[reseau.getNumeroVille(nom)] = c;
+        }
+        comparerPartition("Kosaraju", reference, canonique(composante));
+
+        // ComposantesParalleles, directement sur les vues (numéros internes)
+        const Graphe& graphe = reseau.getGraphe();
+        VueAdjacence inverse = graphe.construireVueAdjacence(true);
+        vector<unsigned int> parInterne;
+        ComposantesParalleles(2).calculer(*reseau.getVueAdjacence(), inverse, parInterne);
+        for (size_t v = 0; v < n; ++v)
+            composante[v] = parInterne[graphe.getNumeroSommet(nomVille(v))];
+        comparerPartition("ComposantesParalleles", reference, canonique(composante));
+
+        // Composantes de référence du simulateur de fermetures (scénario vide)
+        AnalyseFermetures analyse = reseau.analyserFermetures(vector<vector<PaireVilles> >(1),
+                                                              vector<PaireVilles>(), true, 2);
+        composante.assign(analyse.scenarios[0].composante.begin(), analyse.scenarios[0].composante.end());
+        comparerPartition("SimulateurFermetures", reference, canonique(composante));
+
+        // getNombreComposantes et memeComposante
+        ++nbComparaisons;
+        if (reseau.getNombreComposantes() != nbReference)
+            signaler("getNombreComposantes", to_string(reseau.getNombreComposantes()) + " composantes, référence "
+                                             + to_string(nbReference));
+        for (size_t k = 0; k < 200; ++k)
+        {
+            size_t u = generateur() % n, v = generateur() % n;
+            ++nbComparaisons;
+            if (reseau.memeComposante(nomVille(u), nomVille(v)) != (reference[u] == reference[v]))
+                signaler("memeComposante", nomVille(u) + ", " + nomVille(v));
+        }
+    }
+
+
+    // Compare toutes les recherches (chemins, distances, atteignabilité, hubs) à la référence sur l'état courant
+    void comparerRequetes(ReseauInterurbain& reseau, mt19937& generateur, size_t nbRequetes,
+                          const vector<size_t>& suivies)
+    {
+        const size_t n = reseau.getNombreVilles();
+        const MoteurRecherche moteurs[] = {MoteurRecherche::Automatique, MoteurRecherche::Dense,
+                                           MoteurRecherche::Tas, MoteurRecherche::ToutesPaires,
+                                           MoteurRecherche::Etiquettes};
+        const char* nomsMoteurs[] = {"Automatique", "Dense", "Tas", "ToutesPaires", "Etiquettes"};
+
+        GrapheCompact compact(reseau.getGraphe());
+        const unordered_map<string, size_t> numeros = indexerNoms(reseau.getGraphe());
+
+        // Les trajets répartis entre deux opérateurs, correspondances gratuites : mêmes chemins que le réseau
+        ReseauInterurbain operateur1("Operateur 1"), operateur2("Operateur 2");
+        partagerEntreOperateurs(reseau, generateur, operateur1, operateur2);
+        ReseauFedere federe;
+        federe.ajouterOperateur(operateur1);
+        federe.ajouterOperateur(operateur2);
+        federe.definirCorrespondance(0, 1, 0.0f, 0.0f);
+
+        TamponChemin tampon;
+        for (bool dureeCout : {true, false})
+        {
+            for (size_t q = 0; q < nbRequetes; ++q)
+            {
+                size_t o = q % 4 == 0 ? suivies[q % suivies.size()] : generateur() % n;
+                size_t d = q % 16 == 1 ? o : generateur() % n;
+                const string origine = nomVille(o), destination = nomVille(d);
+                const string requete = origine + " -> " + destination + (dureeCout ? " (durée)" : " (coût)");
+                Chemin reference = reseau.rechercheCheminDijkstra(origine, destination, dureeCout,
+                                                                  MoteurRecherche::Reference);
+
+                for (size_t m = 0; m < sizeof(moteurs) / sizeof(moteurs[0]); ++m)
+                {
+                    comparerChemin(reseau, nomsMoteurs[m], reference,
+                                   reseau.rechercheCheminDijkstra(origine, destination, dureeCout, moteurs[m]),
+                                   origine, destination, dureeCout);
+                }
+                if (find(suivies.begin(), suivies.end(), o) != suivies.end())
+                {
+                    comparerChemin(reseau, "Dynamique", reference,
+                                   reseau.rechercheCheminDijkstra(origine, destination, dureeCout,
+                                                                  MoteurRecherche::Dynamique),
+                                   origine, destination, dureeCout);
+                }
+                comparerCompact(reseau, compact, reference, origine, destination, dureeCout);
+                comparerChemin(reseau, "Personnalise", reference,
+                               reseau.rechercheCheminPersonnalise(origine, destination, dureeCout ? 1.0f : 0.0f,
+                                                                  dureeCout ? 0.0f : 1.0f),
+                               origine, destination, dureeCout);
+                if (dureeCout)
+                {
+                    // Métrique mixte : la référence est un Dijkstra exact sur durée + coût / 2
+                    size_t source = numeros.at(origine);
+                    vector<uint64_t> mixte = distancesMixtesReference(reseau.getGraphe(), source, 1.0f, 0.5f);
+                    comparerPersonnalise(reseau, numeros, mixte, source, numeros.at(destination), 1.0f, 0.5f);
+                }
+
+                CheminFedere trouve = federe.rechercheChemin(origine, destination, dureeCout);
+                Chemin cheminFedere;
+                cheminFedere.listeVilles = trouve.listeVilles;
+                cheminFedere.dureeTotale = trouve.dureeTotale;
+                cheminFedere.coutTotal = trouve.coutTotal;
+                cheminFedere.reussi = trouve.reussi;
+                comparerChemin(reseau, "ReseauFedere", reference, cheminFedere, origine, destination, dureeCout);
+
+                CheminIds ids = reseau.rechercheCheminIds(o, d, dureeCout, tampon, MoteurRecherche::Tas);
+                comparerDistance("rechercheCheminIds", reference, ids.reussi ? ids.total : INFINI, requete, dureeCout);
+                comparerDistanceReordonnee(reseau, "distanceEtiquettes", reference,
+                                           reseau.distanceEtiquettes(o, d, dureeCout), requete, dureeCout);
+            }
+
+            // Plus courts chemins depuis une origine, séquentiels, parallèles et par balayage PHAST, et villes
+            // atteignables avec un budget depuis ces origines
+            vector<size_t> origines;
+            for (size_t k = 0; k < 2; ++k)
+                origines.push_back(generateur() % n);
+            vector<float> balayage;
+            reseau.distancesMultiOrigines(origines, dureeCout, balayage, 2);
+            for (size_t k = 0; k < origines.size(); ++k)
+            {
+                vector<float> distances, distancesParallele;
+                vector<unsigned int> predecesseurs, predecesseursParallele;
+                reseau.plusCourtsCheminsDepuis(origines[k], dureeCout, distances, predecesseurs);
+                reseau.plusCourtsCheminsDepuisParallele(origines[k], dureeCout, distancesParallele,
+                                                        predecesseursParallele, 2);
+                ++nbComparaisons;
+                if (distancesParallele != distances || predecesseursParallele != predecesseurs)
+                    signaler("plusCourtsCheminsDepuisParallele", "origine " + nomVille(origines[k]));
+                vector<Chemin> references = cheminsReference(reseau, origines[k], dureeCout);
+                for (size_t v = 0; v < n; ++v)
+                {
+                    const string requete = nomVille(origines[k]) + " -> " + nomVille(v);
+                    comparerDistance("plusCourtsCheminsDepuis", references[v], distances[v], requete, dureeCout);
+                    comparerDistanceReordonnee(reseau, "distancesMultiOrigines", references[v], balayage[k * n + v],
+                                               requete, dureeCout);
+                }
+                comparerAtteignables(reseau, generateur, origines[k], references, dureeCout);
+            }
+            comparerHubs(reseau, generateur, dureeCout);
+        }
+        comparerPlanificateur(reseau, generateur, nbRequetes);
+    }
+
+    // Trajets du réseau, indexés par numéros externes
+    map<pair<size_t, size_t>, pair<float, float> > trajetsExternes(const ReseauInterurbain& reseau)
+    {
+        const Graphe& graphe = reseau.getGraphe();
+        map<pair<size_t, size_t>, pair<float, float> > trajets;
+        for (size_t u = 0; u < reseau.getNombreVilles(); ++u)
+        {
+            for (auto v : graphe.listerSommetsAdjacents(u))
+            {
+                Ponderations poids = graphe.getPonderationsArc(u, v);
+                trajets[make_pair(reseau.getNumeroVille(graphe.getNomSommet(u)),
+                                  reseau.getNumeroVille(graphe.getNomSommet(v)))] = make_pair(poids.duree, poids.cout);
+            }
+        }
+        return trajets;
+    }
+
+    /**
+     * @brief Agrandit puis réduit le réseau (renuméroté ou non) : chaque numéro externe doit garder sa ville et
+     * ses trajets, et la réduction ne doit retirer que les dernières villes du fichier.
+     * @param suivies Les origines suivies, dont celles retirées du réseau sont enlevées.
+     */
+    void comparerRedimensionnement(ReseauInterurbain& reseau, vector<size_t>& suivies)
+    {
+        const size_t n = reseau.getNombreVilles();
+        map<pair<size_t, size_t>, pair<float, float> > avant = trajetsExternes(reseau);
+
+        reseau.resize(n + 1);
+        reseau.nommer(n, nomVille(n));
+        const size_t nouvelleTaille = max<size_t>(n / 2, 2);
+        reseau.resize(nouvelleTaille);
+
+        for (size_t v = 0; v < nouvelleTaille; ++v)
+        {
+            ++nbComparaisons;
+            if (reseau.getNomVille(v) != nomVille(v))
+                signaler("resize", "ville " + to_string(v) + " devenue " + reseau.getNomVille(v));
+        }
+        for (auto itr = avant.begin(); itr != avant.end();)
+        {
+            if (itr->first.first >= nouvelleTaille || itr->first.second >= nouvelleTaille)
+                itr = avant.erase(itr);
+            else
+                ++itr;
+        }
+        ++nbComparaisons;
+        if (trajetsExternes(reseau) != avant)
+            signaler("resize", "trajets différents après redimensionnement");
+
+        suivies.erase(remove_if(suivies.begin(), suivies.end(),
+                                [nouvelleTaille](size_t ville) { return ville >= nouvelleTaille; }),
+                      suivies.end());
+        if (suivies.empty())
+        {
+            suivies.push_back(0);
+            reseau.suivreOrigine(nomVille(0));
+        }
+    }
+
+    /**
+     * @brief Comparaison différentielle de tous les moteurs sur un réseau, avant et après des modifications
+     * faites pendant que des origines sont suivies et que les index sont construits, puis après un
+     * redimensionnement.
+     */
+    void comparerReseau(ReseauInterurbain& reseau, mt19937& generateur, size_t nbRequetes, bool deuxDecimales,
+                        bool poidsNuls)
+    {
+        const size_t n = reseau.getNombreVilles();
+
+        // Quelques origines suivies (moteur Dynamique)
+        vector<size_t> suivies;
+        for (size_t k = 0; k < 3; ++k)
+        {
+            suivies.push_back(generateur() % n);
+            reseau.suivreOrigine(nomVille(suivies.back()));
+        }
+        reseau.activerTableToutesPaires(true, 2);
+        reseau.activerEtiquettesHubs(true);
+
+        comparerRequetes(reseau, generateur, nbRequetes, suivies);
+        comparerComposantes(reseau, generateur);
+        if (!poidsNuls)
+        {
+            comparerCentralite(reseau, true);
+            comparerCentralite(reseau, false);
+        }
+
+        // Les arbres, les composantes incrémentales et les caches doivent suivre les modifications
+        modifierReseau(reseau, generateur, suivies, deuxDecimales, poidsNuls);
+        comparerRequetes(reseau, generateur, nbRequetes / 2, suivies);
+        comparerComposantes(reseau, generateur);
+
+        // Les numéros externes doivent survivre à un redimensionnement, même après renumérotation
+        comparerRedimensionnement(reseau, suivies);
+        comparerRequetes(reseau, generateur, nbRequetes / 4, suivies);
+        comparerComposantes(reseau, generateur);
+
+        reseau.activerTableToutesPaires(false);
+        reseau.activerEtiquettesHubs(false);
+    }
+
+    /**
+     * @brief Grand réseau clairsemé, presque sans cycle, pour les chemins réservés aux grandes entrées : index
+     * d'accessibilité calculé par ComposantesParalleles (plus de 65536 villes), parcours en largeur parallèles
+     * (composantes de plus de 4096 villes), accessibilité sans fermeture transitive (plus de 16384 composantes)
+     * et surcouche à plusieurs niveaux du planificateur par défaut. Les trajets vont vers une ville de numéro
+     * inférieur, sauf deux anneaux : les composantes sont connues par construction.
+     */
+    void comparerGrandReseau(mt19937& generateur, size_t nbRequetes)
+    {
+        const size_t n = 70000, tailleAnneau = 5000;
+        const size_t debutsAnneaux[] = {0, n / 2};
+
+        // Chargé depuis un fichier : ajouterArc cherche les villes par leur nom en temps linéaire
+        const string nomFichier = "BancEssai.grand.txt";
+        {
+            ofstream fichier(nomFichier);
+            fichier << "Reseau Interurbain: Grand" << endl << n << " villes" << endl << "Liste des villes:" << endl;
+            for (size_t v = 0; v < n; ++v)
+                fichier << nomVille(v) << '\n';
+            fichier << "Liste des trajets:" << endl;
+            auto trajet = [&](size_t u, size_t v)
+            {
+                fichier << nomVille(u) << '\n' << nomVille(v) << '\n' << tirerPonderation(generateur, 10, false, false)
+                        << ' ' << tirerPonderation(generateur, 15, false, false) << '\n';
+            };
+            // Un ou deux trajets (aucun pour une ville sur seize) vers des villes proches (localité d'un réseau routier : des cellules du
+            // planificateur à petite frontière)
+            for (size_t v = 1; v < n; ++v)
+            {
+                size_t fenetre = min<size_t>(v, 40);
+                size_t u1 = v - 1 - generateur() % fenetre, u2 = v - 1 - generateur() % fenetre;
+                size_t nbTrajets = generateur() % 16 == 0 ? 0 : 1 + generateur() % 2;
+                if (nbTrajets >= 1)
+                    trajet(v, u1);
+                if (nbTrajets == 2 && u2 != u1)
+                    trajet(v, u2);
+            }
+            for (auto debut : debutsAnneaux)
+            {
+                for (size_t i = 0; i < tailleAnneau; ++i)
+                {
+                    if (i + 1 < tailleAnneau)
+                        trajet(debut + i, debut + i + 1);
+                    else
+                        trajet(debut + i, debut);
+                }
+            }
+        }
+        ReseauInterurbain reseau("Grand");
+        {
+            ifstream fichier(nomFichier);
+            reseau.chargerReseau(fichier);
+        }
+        remove(nomFichier.c_str());
+        ponderationsExactes = true;
+        const Graphe& graphe = reseau.getGraphe();
+        const unordered_map<string, size_t> numeros = indexerNoms(graphe);
+
+        // Composantes : chaque anneau, puis une composante par ville hors des anneaux
+        vector<size_t> reference(n);
+        for (size_t v = 0; v < n; ++v)
+        {
+            reference[v] = v;
+            for (auto debut : debutsAnneaux)
+            {
+                if (v >= debut && v < debut + tailleAnneau)
+                    reference[v] = debut;
+            }
+        }
+        reference = canonique(reference);
+        vector<unsigned int> parInterne;
+        VueAdjacence inverse = graphe.construireVueAdjacence(true);
+        ComposantesParalleles(2).calculer(*reseau.getVueAdjacence(), inverse, parInterne);
+        vector<size_t> composante(n);
+        for (size_t v = 0; v < n; ++v)
+            composante[v] = parInterne[numeros.at(nomVille(v))];
+        comparerPartition("ComposantesParalleles (grand réseau)", reference, canonique(composante));
+        ++nbComparaisons;
+        if (reseau.getNombreComposantes() != n - 2 * (tailleAnneau - 1))
+            signaler("getNombreComposantes (grand réseau)", to_string(reseau.getNombreComposantes()));
+        for (size_t k = 0; k < nbRequetes / 4; ++k)
+        {
+            size_t u = generateur() % n;
+            size_t v = k % 2 == 0 ? generateur() % n : u - u % tailleAnneau + generateur() % tailleAnneau;
+            ++nbComparaisons;
+            if (reseau.memeComposante(nomVille(u), nomVille(v)) != (reference[u] == reference[v]))
+                signaler("memeComposante (grand réseau)", nomVille(u) + ", " + nomVille(v));
+        }
+
+        // Accessibilité, recherches avec court-circuit des paires inaccessibles et métrique mixte
+        for (size_t k = 0; k < 8; ++k)
+        {
+            size_t origine = n / 2 + generateur() % (n / 2);
+            size_t source = numeros.at(nomVille(origine));
+            vector<uint64_t> duree = distancesMixtesReference(graphe, source, 1.0f, 0.0f);
+            vector<uint64_t> mixte = distancesMixtesReference(graphe, source, 1.0f, 0.5f);
+            for (size_t q = 0; q < nbRequetes / 8; ++q)
+            {
+                size_t destination = numeros.at(nomVille(q % 2 == 0 ? generateur() % n : generateur() % origine));
+                ++nbComparaisons;
+                if (reseau.estAtteignable(nomVille(origine), graphe.getNomSommet(destination))
+                    != (duree[destination] != UINT64_MAX))
+                    signaler("estAtteignable (grand réseau)", nomVille(origine) + " -> "
+                                                              + graphe.getNomSommet(destination));
+                if (q % 4 == 0)
+                {
+                    Chemin chemin = reseau.rechercheCheminDijkstra(nomVille(origine), graphe.getNomSommet(destination),
+                                                                   true, MoteurRecherche::Automatique);
+                    vector<size_t> sommets;
+                    for (const auto& nom : chemin.listeVilles)
+                        sommets.push_back(numeros.at(nom));
+                    comparerCheminMixte(graphe, "Automatique (grand réseau)", duree, source, destination,
+                                        chemin.reussi, sommets, chemin.dureeTotale, 1.0f, 0.0f);
+                    comparerPersonnalise(reseau, numeros, mixte, source, destination, 1.0f, 0.5f);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Chronomètre operation(i) pour i dans [0, nbOperations).
+     * @return Le débit et les latences médiane et au 99e centile.
+     */
+    template <typename Operation>
+    Mesure mesurer(size_t nbOperations, Operation operation)
+    {
+        vector<double> latences(nbOperations);
+        auto debut = chrono::steady_clock::now();
+        for (size_t i = 0; i < nbOperations; ++i)
+        {
+            auto avant = chrono::steady_clock::now();
+            operation(i);
+            latences[i] = chrono::duration<double, micro>(chrono::steady_clock::now() - avant).count();
+        }
+        double total = chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+        sort(latences.begin(), latences.end());
+        Mesure mesure;
+        mesure.debit = nbOperations / total;
+        mesure.latenceMediane = latences[latences.size() / 2];
+        mesure.latence99 = latences[min(latences.size() - 1, latences.size() * 99 / 100)];
+        return mesure;
+    }
+
+    // Mesures de performance sur un réseau fixe (indépendant de la graine, pour rester comparable à la base)
+    map<string, Mesure> mesurerPerformances(size_t nbVilles, size_t nbRequetes)
+    {
+        mt19937 generateur(2023);
+        ReseauInterurbain reseau("Performance");
+        genererReseau(reseau, generateur, nbVilles, 3 * nbVilles);
+        vector<pair<string, string> > requetes;
+        vector<PaireVilles> numeros;
+        for (size_t q = 0; q < nbRequetes; ++q)
+        {
+            PaireVilles paire = {generateur() % nbVilles, generateur() % nbVilles};
+            numeros.push_back(paire);
+            requetes.push_back(make_pair(nomVille(paire.origine), nomVille(paire.destination)));
+        }
+
+        map<string, Mesure> mesures;
+        const MoteurRecherche moteurs[] = {MoteurRecherche::Automatique, MoteurRecherche::Tas,
+                                           MoteurRecherche::Etiquettes};
+        const char* nomsMoteurs[] = {"Automatique", "Tas", "Etiquettes"};
+        for (size_t m = 0; m < sizeof(moteurs) / sizeof(moteurs[0]); ++m)
+        {
+            reseau.rechercheCheminDijkstra(requetes[0].first, requetes[0].second, true, moteurs[m]);	// Index
+            mesures[nomsMoteurs[m]] = mesurer(nbRequetes, [&](size_t i)
+            {
+                reseau.rechercheCheminDijkstra(requetes[i].first, requetes[i].second, true, moteurs[m]);
+            });
+        }
+        reseau.rechercheCheminPersonnalise(requetes[0].first, requetes[0].second, 1.0f, 0.5f);
+        mesures["Personnalise"] = mesurer(nbRequetes, [&](size_t i)
+        {
+            reseau.rechercheCheminPersonnalise(requetes[i].first, requetes[i].second, 1.0f, 0.5f);
+        });
+
+        TamponChemin tampon;
+        mesures["rechercheCheminIds"] = mesurer(nbRequetes, [&](size_t i)
+        {
+            reseau.rechercheCheminIds(numeros[i].origine, numeros[i].destination, true, tampon, MoteurRecherche::Tas);
+        });
+
+        vector<size_t> origines(BalayagePhast::LARGEUR);
+        vector<float> distances;
+        reseau.distancesMultiOrigines(origines, true, distances, 1);
+        mesures["distancesMultiOrigines"] = mesurer(nbRequetes / 50 + 1, [&](size_t i)
+        {
+            for (size_t k = 0; k < origines.size(); ++k)
+                origines[k] = numeros[(i * origines.size() + k) % numeros.size()].origine;
+            reseau.distancesMultiOrigines(origines, true, distances, 1);
+        });
+
+        mesures["Kosaraju"] = mesurer(10, [&](size_t)
+        {
+            reseau.viderCaches();
+            reseau.algorithmeKosaraju();
+        });
+        return mesures;
+    }
+
+    map<string, Mesure> lireBase(const string& nomFichier)
+    {
+        map<string, Mesure> base;
+        ifstream fichier(nomFichier);
+        string nom;
+        Mesure mesure;
+        while (fichier >> nom >> mesure.debit >> mesure.latenceMediane >> mesure.latence99)
+            base[nom] = mesure;
+        return base;
+    }
+
+    void ecrireBase(const string& nomFichier, const map<string, Mesure>& mesures)
+    {
+        ofstream fichier(nomFichier);
+        if (!fichier)
+            throw logic_error("BancEssai : impossible d'écrire la base " + nomFichier);
+        for (const auto& mesure : mesures)
+        {
+            fichier << mesure.first << ' ' << mesure.second.debit << ' ' << mesure.second.latenceMediane << ' '
+                    << mesure.second.latence99 << '\n';
+        }
+    }
+
+    Options lireOptions(int argc, char* argv[])
+    {
+        Options options;
+        for (int i = 1; i < argc; ++i)
+        {
+            string option = argv[i];
+            bool valeur = i + 1 < argc;
+            if (option == "--graine" && valeur)
+                options.graine = static_cast<uint32_t>(strtoul(argv[++i], nullptr, 10));
+            else if (option == "--reseaux" && valeur)
+                options.nbReseaux = strtoul(argv[++i], nullptr, 10);
+            else if (option == "--requetes" && valeur)
+                options.nbRequetes = strtoul(argv[++i], nullptr, 10);
+            else if (option == "--villes" && valeur)
+                options.villesPerformance = max<size_t>(strtoul(argv[++i], nullptr, 10), 2);
+            else if (option == "--base" && valeur)
+                options.base = argv[++i];
+            else if (option == "--seuil" && valeur)
+                options.seuil = strtod(argv[++i], nullptr);
+            else if (option == "--enregistrer")
+                options.enregistrer = true;
+            else if (option == "--sans-performance")
+                options.performance = false;
+            else
+                throw logic_error("BancEssai : option inconnue ou incomplète " + option);
+        }
+        return options;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        Options options = lireOptions(argc, argv);
+
+        cout << "Comparaison différentielle : " << options.nbReseaux << " réseaux, graine " << options.graine << endl;
+        mt19937 generateur(options.graine);
+        const OrdreSommets ordres[] = {OrdreSommets::Fichier, OrdreSommets::ParcoursLargeur,
+                                       OrdreSommets::CuthillMcKeeInverse};
+        for (size_t r = 0; r < options.nbReseaux; ++r)
+        {
+            ReseauInterurbain reseau("Aleatoire");
+            size_t nbVilles = 2 + generateur() % 150;
+            if (r % 2 == 1)
+                reseau.activerComposantesIncrementales(true);
+            bool deuxDecimales = r % 4 >= 2;
+            bool poidsNuls = r % 8 < 4;
+            ponderationsExactes = !deuxDecimales;
+            genererReseau(reseau, generateur, nbVilles, generateur() % (4 * nbVilles), deuxDecimales, poidsNuls);
+            reseau.renumeroterVilles(ordres[r % 3]);
+            comparerReseau(reseau, generateur, options.nbRequetes, deuxDecimales, poidsNuls);
+        }
+        comparerGrandReseau(generateur, options.nbRequetes);
+
+        size_t nbDivergences = 0;
+        for (const auto& moteur : divergences)
+        {
+            cout << "  " << moteur.first << " : " << moteur.second << " divergence(s)" << endl;
+            nbDivergences += moteur.second;
+        }
+        cout << nbComparaisons << " comparaisons, " << nbDivergences << " divergence(s)" << endl;
+
+        bool regression = false;
+        if (options.performance)
+        {
+            cout << endl << "Performances : " << options.villesPerformance << " villes, "
+                 << 3 * options.villesPerformance << " trajets tirés" << endl;
+            map<string, Mesure> mesures = mesurerPerformances(options.villesPerformance, options.nbRequetes * 10);
+            map<string, Mesure> base = lireBase(options.base);
+            cout << left << setw(26) << "mesure" << right << setw(14) << "débit (op/s)" << setw(12) << "p50 (us)"
+                 << setw(12) << "p99 (us)" << "  base" << endl;
+            for (const auto& mesure : mesures)
+            {
+                const Mesure& m = mesure.second;
+                cout << left << setw(26) << mesure.first << right << fixed << setprecision(1) << setw(14) << m.debit
+                     << setw(12) << m.latenceMediane << setw(12) << m.latence99 << "  ";
+                auto itr = base.find(mesure.first);
+                if (itr == base.end())
+                {
+                    cout << "(absente)" << endl;
+                    continue;
+                }
+                double rapport = m.debit / itr->second.debit;
+                bool lent = rapport < 1.0 - options.seuil || m.latence99 > itr->second.latence99 * (1.0 + options.seuil);
+                cout << setprecision(2) << rapport << "x" << (lent ? "  REGRESSION" : "") << endl;
+                regression = regression || lent;
+            }
+            if (options.enregistrer)
+            {
+                ecrireBase(options.base, mesures);
+                cout << "Base enregistrée dans " << options.base << endl;
+            }
+        }
+
+        if (nbDivergences > 0)
+            return 1;
+        return regression ? 2 : 0;
+    }
+    catch (exception& e)
+    {
+        cerr << e.what() << endl;
+        return 1;
+    }
+}
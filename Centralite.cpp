@@ -0,0 +1,206 @@
+/**
+ * \file Centralite.cpp
+ * \brief Implémentation de la centralité d'intermédiarité (Brandes).
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <limits>
+#include <random>
+#include <stdexcept>
+
+#include "Centralite.h"
+
+namespace TP2
+{
+
+    namespace
+    {
+        const float INFINI = std::numeric_limits<float>::infinity();
+        const unsigned int AUCUN = UINT_MAX;
+        const size_t TAILLE_PAQUET_ORIGINES = 4;	// Origines par paquet de travail
+        const size_t TAILLE_PAQUET_SOMME = 4096;	// Entrées par paquet lors de la somme des accumulateurs
+    }
+
+    struct Centralite::Espace
+    {
+        std::vector<float> distances;
+        std::vector<double> sigma;			// Nombre de plus courts chemins depuis l'origine
+        std::vector<double> delta;			// Dépendance de l'origine envers le sommet
+        std::vector<unsigned int> position;	// Rang de solution du sommet, AUCUN s'il n'est pas encore solutionné
+        std::vector<unsigned int> ordre;	// Sommets par ordre de solution
+        std::vector<std::pair<float, unsigned int> > tas;
+        std::vector<double> scoresSommets;	// Accumulateurs du thread
+        std::vector<double> scoresArcs;
+    };
+
+    Centralite::Centralite(unsigned int nbThreads) : pool(nbThreads)
+    {
+    }
+
+    /**
+     * @brief Calcule la centralité d'intermédiarité des sommets et des arcs.
+     * @param vue La vue d'adjacence du graphe.
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @param scores Reçoit les scores.
+     * @param nbEchantillons Le nombre d'origines tirées au hasard (0 : toutes).
+     * @param graine La graine du tirage.
+     * @throws std::logic_error Si un arc est négatif.
+     */
+    void Centralite::calculer(const VueAdjacence& vue, bool dureeCout, ScoresCentralite& scores,
+                              size_t nbEchantillons, uint32_t graine)
+    {
+        const size_t n = vue.nbSommets();
+        const std::vector<float>& poids = vue.ponderations(dureeCout);
+        for (auto p : poids)
+        {
+            if (p < 0)
+                throw std::logic_error("Centralite::calculer : les arcs ne sont pas tous non négatifs");
+        }
+
+        std::vector<unsigned int> sources(n);
+        for (size_t v = 0; v < n; ++v)
+            sources[v] = static_cast<unsigned int>(v);
+        if (nbEchantillons > 0 && nbEchantillons < n)
+        {
+            // Tirage sans remise (Fisher-Yates partiel), puis tri pour parcourir les origines dans l'ordre
+            std::mt19937 generateur(graine);
+            for (size_t i = 0; i < nbEchantillons; ++i)
+            {
+                std::uniform_int_distribution<size_t> tirage(i, n - 1);
+                std::swap(sources[i], sources[tirage(generateur)]);
+            }
+            sources.resize(nbEchantillons);
+            std::sort(sources.begin(), sources.end());
+        }
+
+        const unsigned int nbThreads = pool.getNombreThreads();
+        std::vector<Espace> espaces(nbThreads);
+        for (auto& espace : espaces)
+        {
+            espace.distances.assign(n, INFINI);
+            espace.sigma.assign(n, 0.0);
+            espace.delta.assign(n, 0.0);
+            espace.position.assign(n, AUCUN);
+            espace.scoresSommets.assign(n, 0.0);
+            espace.scoresArcs.assign(vue.destinations.size(), 0.0);
+        }
+
+        pool.executer(sources.size(), TAILLE_PAQUET_ORIGINES, [&](size_t debut, size_t fin, unsigned int numero)
+        {
+            for (size_t i = debut; i < fin; ++i)
+                accumuler(vue, poids, sources[i], espaces[numero]);
+        });
+
+        // Somme des accumulateurs, mise à l'échelle de l'échantillon
+        const double facteur = sources.empty() ? 0.0 : static_cast<double>(n) / sources.size();
+        scores.sommets.assign(n, 0.0);
+        scores.arcs.assign(vue.destinations.size(), 0.0);
+        scores.nbSources = sources.size();
+        for (auto cible : {std::make_pair(&scores.sommets, &Espace::scoresSommets),
+                           std::make_pair(&scores.arcs, &Espace::scoresArcs)})
+        {
+            std::vector<double>& total = *cible.first;
+            pool.executer(total.size(), TAILLE_PAQUET_SOMME, [&](size_t debut, size_t fin, unsigned int)
+            {
+                for (const auto& espace : espaces)
+                {
+                    const std::vector<double>& partiel = espace.*cible.second;
+                    for (size_t i = debut; i < fin; ++i)
+                        total[i] += partiel[i];
+                }
+                for (size_t i = debut; i < fin; ++i)
+                    total[i] *= facteur;
+            });
+        }
+    }
+
+    /**
+     * @brief Dijkstra avec comptage des plus courts chemins depuis une origine, puis accumulation des dépendances.
+     * Un arc v -> w appartient au DAG des plus courts chemins si w est solutionné après v et que
+     * distances[v] + poids == distances[w]; la même condition sert au comptage et à l'accumulation, ce qui
+     * garde les deux cohérents en présence d'arcs de poids nul.
+     * @param vue La vue d'adjacence du graphe.
+     * @param poids Les pondérations du critère.
+     * @param source L'origine.
+     * @param espace Les tableaux de travail et les accumulateurs du thread.
+     */
+    void Centralite::accumuler(const VueAdjacence& vue, const std::vector<float>& poids, unsigned int source,
+                               Espace& espace)
+    {
+        typedef std::pair<float, unsigned int> Entree;
+        std::vector<float>& distances = espace.distances;
+        std::vector<double>& sigma = espace.sigma;
+        std::vector<double>& delta = espace.delta;
+        std::vector<unsigned int>& position = espace.position;
+        std::vector<unsigned int>& ordre = espace.ordre;
+        std::vector<Entree>& tas = espace.tas;
+
+        distances[source] = 0.0;
+        sigma[source] = 1.0;
+        tas.push_back(Entree(0.0f, source));
+        while (!tas.empty())
+        {
+            std::pop_heap(tas.begin(), tas.end(), std::greater<Entree>());
+            unsigned int v = tas.back().second;
+            tas.pop_back();
+            if (position[v] != AUCUN)
+                continue;
+            position[v] = static_cast<unsigned int>(ordre.size());
+            ordre.push_back(v);
+
+            for (size_t a = vue.debut[v]; a < vue.debut[v + 1]; ++a)
+            {
+                unsigned int w = vue.destinations[a];
+                if (position[w] != AUCUN)
+                    continue;
+                float tmp = distances[v] + poids[a];
+                if (tmp < distances[w])
+                {
+                    distances[w] = tmp;
+                    sigma[w] = sigma[v];
+                    tas.push_back(Entree(tmp, w));
+                    std::push_heap(tas.begin(), tas.end(), std::greater<Entree>());
+                }
+                else if (tmp == distances[w])
+                {
+                    sigma[w] += sigma[v];
+                }
+            }
+        }
+
+        for (size_t i = ordre.size(); i-- > 0;)
+        {
+            unsigned int v = ordre[i];
+            for (size_t a = vue.debut[v]; a < vue.debut[v + 1]; ++a)
+            {
+                unsigned int w = vue.destinations[a];
+                if (position[w] != AUCUN && position[w] > position[v] && distances[v] + poids[a] == distances[w])
+                {
+                    double contribution = sigma[v] / sigma[w] * (1.0 + delta[w]);
+                    delta[v] += contribution;
+                    espace.scoresArcs[a] += contribution;
+                }
+            }
+            if (v != source)
+                espace.scoresSommets[v] += delta[v];
+        }
+
+        // Ne remettre à zéro que les sommets atteints
+        for (auto v : ordre)
+        {
+            distances[v] = INFINI;
+            sigma[v] = 0.0;
+            delta[v] = 0.0;
+            position[v] = AUCUN;
+        }
+        ordre.clear();
+    }
+
+}//Fin du namespace TP2
@@ -0,0 +1,69 @@
+/**
+ * \file Centralite.h
+ * \brief Centralité d'intermédiarité des sommets et des arcs, calculée en parallèle.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include "Graphe.h"
+#include "Parallelisme.h"
+#include <cstdint>
+#include <vector>
+
+#ifndef _CENTRALITE__H
+#define _CENTRALITE__H
+
+namespace TP2
+{
+
+    // Scores d'intermédiarité, dans la numérotation de la vue d'adjacence
+    struct ScoresCentralite
+    {
+        std::vector<double> sommets;	// Nombre (pondéré) de plus courts chemins passant par chaque sommet, extrémités exclues
+        std::vector<double> arcs;		// Même chose pour chaque arc, indexé comme vue.destinations
+        size_t nbSources;				// Nombre d'origines parcourues (toutes, ou l'échantillon)
+    };
+
+/**
+ * \class Centralite
+ * \brief Algorithme de Brandes sur une vue d'adjacence, parallélisé sur les origines
+ *
+ * Pour chaque origine s, un Dijkstra compte le nombre sigma de plus courts chemins vers chaque sommet, puis les
+ * sommets sont repris par distance décroissante pour accumuler la dépendance delta[v] = somme sur les arcs
+ * v -> w du DAG des plus courts chemins de sigma[v] / sigma[w] * (1 + delta[w]). Chaque thread accumule dans
+ * ses propres tableaux, additionnés à la fin. Sur un grand réseau, un échantillon d'origines tirées au hasard
+ * donne une estimation sans biais (scores multipliés par n / nombre d'origines).
+ */
+    class Centralite
+    {
+    public:
+
+        // nbThreads : taille du pool de travail (0 = tous les coeurs)
+        explicit Centralite(unsigned int nbThreads = 0);
+
+        // Calcule les scores pour le critère dureeCout. nbEchantillons = 0 (ou >= nombre de sommets) : calcul
+        // exact sur toutes les origines; sinon estimation à partir de nbEchantillons origines tirées avec graine.
+        // Les paires ne sont pas normalisées. Selon le découpage entre threads, les sommes peuvent différer
+        // à l'arrondi près d'une exécution à l'autre.
+        // Exception logic_error si un arc est négatif
+        void calculer(const VueAdjacence& vue, bool dureeCout, ScoresCentralite& scores,
+                      size_t nbEchantillons = 0, uint32_t graine = 0);
+
+    private:
+
+        // Tableaux de travail d'un thread (définis dans Centralite.cpp)
+        struct Espace;
+
+        PoolTravail pool;
+
+        // Ajoute aux accumulateurs de l'espace les dépendances de tous les sommets envers l'origine source
+        static void accumuler(const VueAdjacence& vue, const std::vector<float>& poids, unsigned int source,
+                              Espace& espace);
+    };
+
+}//Fin du namespace
+
+#endif
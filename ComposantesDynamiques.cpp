@@ -0,0 +1,261 @@
+/**
+ * \file ComposantesDynamiques.cpp
+ * \brief Implémentation des composantes fortement connexes incrémentales.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "ComposantesDynamiques.h"
+
+namespace TP2
+{
+
+    /**
+     * @brief Constructeur : construit le graphe des composantes à partir d'une numérotation initiale.
+     * @param vue La vue d'adjacence du graphe.
+     * @param composante La composante de chaque sommet (puits d'abord).
+     * @param nbComposantes Le nombre de composantes.
+     */
+    ComposantesDynamiques::ComposantesDynamiques(const VueAdjacence& vue, const std::vector<unsigned int>& composante,
+                                                 size_t nbComposantes) :
+            composanteInitiale(composante), parent(nbComposantes), taille(nbComposantes, 1), rang(nbComposantes),
+            successeurs(nbComposantes), predecesseurs(nbComposantes), nbComposantes(nbComposantes),
+            visiteAvant(nbComposantes, 0), visiteArriere(nbComposantes, 0), estampille(0)
+    {
+        for (size_t c = 0; c < nbComposantes; ++c)
+        {
+            parent[c] = static_cast<unsigned int>(c);
+            rang[c] = static_cast<unsigned int>(nbComposantes - 1 - c);
+        }
+
+        for (size_t u = 0; u < vue.nbSommets(); ++u)
+        {
+            unsigned int cu = composante[u];
+            for (size_t a = vue.debut[u]; a < vue.debut[u + 1]; ++a)
+            {
+                unsigned int cv = composante[vue.destinations[a]];
+                if (cv != cu)
+                {
+                    successeurs[cu].push_back(cv);
+                    predecesseurs[cv].push_back(cu);
+                }
+            }
+        }
+        for (size_t c = 0; c < nbComposantes; ++c)
+        {
+            std::sort(successeurs[c].begin(), successeurs[c].end());
+            successeurs[c].erase(std::unique(successeurs[c].begin(), successeurs[c].end()), successeurs[c].end());
+            std::sort(predecesseurs[c].begin(), predecesseurs[c].end());
+            predecesseurs[c].erase(std::unique(predecesseurs[c].begin(), predecesseurs[c].end()), predecesseurs[c].end());
+        }
+    }
+
+    /**
+     * @brief Prend en compte un nouvel arc (Pearce et Kelly, avec fusion des circuits).
+     * Si l'arc x -> y contredit l'ordre (rang[y] < rang[x]), les descendants F de y et les ascendants B de x de
+     * rang compris entre rang[y] et rang[x] sont explorés. Si x est dans F, les classes de F et B à la fois
+     * forment un circuit et fusionnent. Les rangs de F et B sont ensuite redistribués : B, puis la classe
+     * fusionnée, puis F, chacun dans son ordre relatif d'origine.
+     * @param source Le sommet source de l'arc.
+     * @param destination Le sommet destination de l'arc.
+     * @return true si des composantes ont fusionné.
+     * @throws std::logic_error Si un sommet est invalide.
+     */
+    bool ComposantesDynamiques::ajouterArc(size_t source, size_t destination)
+    {
+        if (source >= composanteInitiale.size() || destination >= composanteInitiale.size())
+        {
+            throw std::logic_error("ComposantesDynamiques::ajouterArc : sommet invalide");
+        }
+
+        unsigned int x = trouver(composanteInitiale[source]);
+        unsigned int y = trouver(composanteInitiale[destination]);
+        if (x == y)
+            return false;
+        successeurs[x].push_back(y);
+        predecesseurs[y].push_back(x);
+        if (rang[x] < rang[y])
+            return false;
+
+        if (++estampille == 0)
+        {
+            std::fill(visiteAvant.begin(), visiteAvant.end(), 0);
+            std::fill(visiteArriere.begin(), visiteArriere.end(), 0);
+            estampille = 1;
+        }
+        std::vector<unsigned int> avant, arriere;
+        explorer(y, true, rang[y], rang[x], avant);
+        explorer(x, false, rang[y], rang[x], arriere);
+        bool circuit = visiteAvant[x] == estampille;
+
+        // Rangs libérés par les classes déplacées
+        std::vector<unsigned int> rangs;
+        for (auto c : avant)
+            rangs.push_back(rang[c]);
+        for (auto c : arriere)
+        {
+            if (visiteAvant[c] != estampille)
+                rangs.push_back(rang[c]);
+        }
+        std::sort(rangs.begin(), rangs.end());
+
+        auto parRang = [this](unsigned int a, unsigned int b) { return rang[a] < rang[b]; };
+        std::sort(avant.begin(), avant.end(), parRang);
+        std::sort(arriere.begin(), arriere.end(), parRang);
+
+        // B prend les plus petits rangs et F les plus grands : aucun sommet de B ne recule, aucun de F n'avance,
+        // ce qui préserve l'ordre avec les classes non explorées
+        std::vector<unsigned int> circuitClasses;
+        size_t prochain = 0;
+        for (auto c : arriere)
+        {
+            if (visiteAvant[c] == estampille)
+                circuitClasses.push_back(c);
+            else
+                rang[c] = rangs[prochain++];
+        }
+        if (circuit)
+        {
+            rang[fusionner(circuitClasses)] = rangs[prochain];
+        }
+        size_t dernier = rangs.size();
+        for (auto itr = avant.rbegin(); itr != avant.rend(); ++itr)
+        {
+            if (visiteArriere[*itr] != estampille)
+                rang[*itr] = rangs[--dernier];
+        }
+        return circuit;
+    }
+
+    /**
+     * @brief Parcours en profondeur du graphe des composantes, limité à une plage de rangs.
+     * @param depart Le représentant de départ.
+     * @param avant true pour suivre les successeurs, false pour les prédécesseurs.
+     * @param borneInf Le plus petit rang exploré.
+     * @param borneSup Le plus grand rang exploré.
+     * @param visites Reçoit les représentants visités (depart compris).
+     */
+    void ComposantesDynamiques::explorer(unsigned int depart, bool avant, unsigned int borneInf, unsigned int borneSup,
+                                         std::vector<unsigned int>& visites)
+    {
+        std::vector<unsigned int>& visite = avant ? visiteAvant : visiteArriere;
+        std::vector<std::vector<unsigned int> >& voisins = avant ? successeurs : predecesseurs;
+
+        visite[depart] = estampille;
+        visites.push_back(depart);
+        std::vector<unsigned int> pile(1, depart);
+        while (!pile.empty())
+        {
+            unsigned int c = pile.back();
+            pile.pop_back();
+            for (auto classe : voisins[c])
+            {
+                unsigned int r = trouver(classe);
+                if (r != c && visite[r] != estampille && rang[r] >= borneInf && rang[r] <= borneSup)
+                {
+                    visite[r] = estampille;
+                    visites.push_back(r);
+                    pile.push_back(r);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Fusionne des classes (union par taille) et regroupe leurs arcs sans doublons.
+     * @param classes Les représentants à fusionner (au moins un).
+     * @return Le représentant de la classe fusionnée.
+     */
+    unsigned int ComposantesDynamiques::fusionner(const std::vector<unsigned int>& classes)
+    {
+        unsigned int r = classes[0];
+        for (auto c : classes)
+        {
+            if (taille[c] > taille[r])
+                r = c;
+        }
+
+        for (auto c : classes)
+        {
+            if (c == r)
+                continue;
+            parent[c] = r;
+            taille[r] += taille[c];
+            successeurs[r].insert(successeurs[r].end(), successeurs[c].begin(), successeurs[c].end());
+            predecesseurs[r].insert(predecesseurs[r].end(), predecesseurs[c].begin(), predecesseurs[c].end());
+            std::vector<unsigned int>().swap(successeurs[c]);
+            std::vector<unsigned int>().swap(predecesseurs[c]);
+        }
+        nbComposantes -= classes.size() - 1;
+
+        // Résoudre les classes, retirer les boucles et les doublons
+        for (auto liste : {&successeurs[r], &predecesseurs[r]})
+        {
+            for (auto& classe : *liste)
+                classe = trouver(classe);
+            std::sort(liste->begin(), liste->end());
+            liste->erase(std::unique(liste->begin(), liste->end()), liste->end());
+            liste->erase(std::remove(liste->begin(), liste->end(), r), liste->end());
+        }
+        return r;
+    }
+
+    unsigned int ComposantesDynamiques::trouver(unsigned int classe) const
+    {
+        while (parent[classe] != classe)
+            classe = parent[classe];
+        return classe;
+    }
+
+    /**
+     * @brief Vérifie si deux sommets sont dans la même composante.
+     * @throws std::logic_error Si un sommet est invalide.
+     */
+    bool ComposantesDynamiques::memeComposante(size_t u, size_t v) const
+    {
+        if (u >= composanteInitiale.size() || v >= composanteInitiale.size())
+        {
+            throw std::logic_error("ComposantesDynamiques::memeComposante : sommet invalide");
+        }
+        return trouver(composanteInitiale[u]) == trouver(composanteInitiale[v]);
+    }
+
+    size_t ComposantesDynamiques::getNombreComposantes() const
+    {
+        return nbComposantes;
+    }
+
+    /**
+     * @brief Numérote les composantes courantes par rang décroissant (puits d'abord).
+     * @param composante Reçoit le numéro de composante de chaque sommet.
+     * @return Le nombre de composantes.
+     */
+    size_t ComposantesDynamiques::numeroter(std::vector<unsigned int>& composante) const
+    {
+        std::vector<unsigned int> representants;
+        representants.reserve(nbComposantes);
+        for (size_t c = 0; c < parent.size(); ++c)
+        {
+            if (parent[c] == c)
+                representants.push_back(static_cast<unsigned int>(c));
+        }
+        std::sort(representants.begin(), representants.end(),
+                  [this](unsigned int a, unsigned int b) { return rang[a] > rang[b]; });
+
+        std::vector<unsigned int> numero(parent.size());
+        for (size_t i = 0; i < representants.size(); ++i)
+            numero[representants[i]] = static_cast<unsigned int>(i);
+
+        composante.resize(composanteInitiale.size());
+        for (size_t v = 0; v < composanteInitiale.size(); ++v)
+            composante[v] = numero[trouver(composanteInitiale[v])];
+        return representants.size();
+    }
+
+}//Fin du namespace TP2
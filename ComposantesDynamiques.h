@@ -0,0 +1,78 @@
+/**
+ * \file ComposantesDynamiques.h
+ * \brief Composantes fortement connexes maintenues pendant l'ajout d'arcs.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include "Graphe.h"
+#include <vector>
+
+#ifndef _COMPOSANTESDYNAMIQUES__H
+#define _COMPOSANTESDYNAMIQUES__H
+
+namespace TP2
+{
+
+/**
+ * \class ComposantesDynamiques
+ * \brief Composantes fortement connexes et ordre topologique du graphe des composantes, mis à jour arc par arc
+ *
+ * Les composantes sont les classes d'une union-find. Un ordre topologique du graphe des composantes est
+ * maintenu avec l'algorithme de Pearce et Kelly : un arc qui respecte l'ordre ne coûte rien; sinon, seules les
+ * composantes dont le rang est compris entre ceux des extrémités de l'arc sont explorées et réordonnées. Si
+ * l'arc ferme un circuit, les composantes du circuit sont fusionnées sans recalcul global.
+ * Le retrait d'un arc n'est pas pris en charge (une composante peut se scinder) : il faut reconstruire.
+ */
+    class ComposantesDynamiques
+    {
+    public:
+
+        // composante : numérotation initiale, puits du graphe des composantes d'abord (les arcs entre composantes
+        // vont vers un numéro inférieur), telle que calculée par Kosaraju ou ComposantesParalleles
+        ComposantesDynamiques(const VueAdjacence& vue, const std::vector<unsigned int>& composante,
+                              size_t nbComposantes);
+
+        // Prend en compte un nouvel arc source -> destination. Retourne true si des composantes ont fusionné.
+        // Exception logic_error si source et/ou destination supérieur au nombre de sommets
+        bool ajouterArc(size_t source, size_t destination);
+
+        // true si les deux sommets sont dans la même composante
+        bool memeComposante(size_t u, size_t v) const;
+
+        size_t getNombreComposantes() const;
+
+        // Numérotation contiguë courante, puits d'abord (même convention que le constructeur).
+        // Retourne le nombre de composantes.
+        size_t numeroter(std::vector<unsigned int>& composante) const;
+
+    private:
+
+        std::vector<unsigned int> composanteInitiale;	// Classe union-find de départ de chaque sommet
+        std::vector<unsigned int> parent;				// Union-find sur les classes (union par taille)
+        std::vector<unsigned int> taille;
+        std::vector<unsigned int> rang;					// Rang topologique de chaque représentant (sources d'abord)
+        std::vector<std::vector<unsigned int> > successeurs;	// Arcs du graphe des composantes (classes, à résoudre)
+        std::vector<std::vector<unsigned int> > predecesseurs;
+        size_t nbComposantes;
+
+        std::vector<unsigned int> visiteAvant;		// Estampille du dernier parcours ayant visité la classe
+        std::vector<unsigned int> visiteArriere;
+        unsigned int estampille;
+
+        unsigned int trouver(unsigned int classe) const;
+
+        // Parcours limité aux rangs dans [borneInf, borneSup]; visites reçoit les représentants atteints
+        void explorer(unsigned int depart, bool avant, unsigned int borneInf, unsigned int borneSup,
+                      std::vector<unsigned int>& visites);
+
+        // Fusionne les classes et retourne le représentant obtenu
+        unsigned int fusionner(const std::vector<unsigned int>& classes);
+    };
+
+}//Fin du namespace
+
+#endif
@@ -0,0 +1,368 @@
+/**
+ * \file ComposantesParalleles.cpp
+ * \brief Implémentation du calcul parallèle des composantes fortement connexes.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <memory>
+
+#include "ComposantesParalleles.h"
+
+namespace TP2
+{
+
+    namespace
+    {
+        const unsigned int AUCUN = UINT_MAX;		// Sommet encore vivant (sans composante)
+        const unsigned int EN_COURS = UINT_MAX - 1;	// Sommet réclamé par un thread pendant l'élagage
+        const size_t TAILLE_PAQUET = 256;			// Sommets par paquet de travail
+
+        typedef std::unique_ptr<std::atomic<unsigned int>[]> TableauAtomique;
+    }
+
+    struct ComposantesParalleles::Etat
+    {
+        const VueAdjacence* vue;
+        const VueAdjacence* inverse;
+        TableauAtomique composante;		// Numéro provisoire de composante, AUCUN si le sommet est vivant
+        TableauAtomique couleur;		// Sous-problème du sommet vivant
+        TableauAtomique marqueAvant;	// Couleur du dernier parcours avant ayant atteint le sommet
+        TableauAtomique marqueArriere;	// Couleur du dernier parcours arrière ayant atteint le sommet
+        std::atomic<unsigned int> nbComposantes;
+        std::atomic<unsigned int> nbCouleurs;
+        std::vector<std::vector<unsigned int> > locales;	// Une liste de sommets par thread
+
+        bool vivant(unsigned int sommet, unsigned int c) const
+        {
+            return composante[sommet].load(std::memory_order_relaxed) == AUCUN
+                   && couleur[sommet].load(std::memory_order_relaxed) == c;
+        }
+
+        // Concatène les listes des threads dans sortie et les vide
+        void rassembler(std::vector<unsigned int>& sortie)
+        {
+            sortie.clear();
+            for (auto& liste : locales)
+            {
+                sortie.insert(sortie.end(), liste.begin(), liste.end());
+                liste.clear();
+            }
+        }
+    };
+
+    /**
+     * @brief Constructeur : démarre le pool de travail.
+     * @param nbThreads Le nombre de threads (0 = tous les coeurs).
+     */
+    ComposantesParalleles::ComposantesParalleles(unsigned int nbThreads) : pool(nbThreads)
+    {
+    }
+
+    /**
+     * @brief Numérote les composantes fortement connexes d'un graphe.
+     * @param vue La vue d'adjacence du graphe.
+     * @param inverse La vue d'adjacence du graphe inverse.
+     * @param composante Reçoit le numéro de composante de chaque sommet (puits du graphe des composantes d'abord).
+     * @return Le nombre de composantes.
+     */
+    size_t ComposantesParalleles::calculer(const VueAdjacence& vue, const VueAdjacence& inverse,
+                                           std::vector<unsigned int>& composante)
+    {
+        const size_t n = vue.nbSommets();
+        Etat etat;
+        etat.vue = &vue;
+        etat.inverse = &inverse;
+        etat.composante.reset(new std::atomic<unsigned int>[n]);
+        etat.couleur.reset(new std::atomic<unsigned int>[n]);
+        etat.marqueAvant.reset(new std::atomic<unsigned int>[n]);
+        etat.marqueArriere.reset(new std::atomic<unsigned int>[n]);
+        etat.nbComposantes = 0;
+        etat.nbCouleurs = 1;
+        etat.locales.resize(pool.getNombreThreads());
+
+        // Élagage : degrés restreints aux sommets vivants, les sommets de degré nul sont retirés par vagues
+        TableauAtomique degreEntrant(new std::atomic<unsigned int>[n]);
+        TableauAtomique degreSortant(new std::atomic<unsigned int>[n]);
+        pool.executer(n, TAILLE_PAQUET, [&](size_t debut, size_t fin, unsigned int numero)
+        {
+            for (size_t v = debut; v < fin; ++v)
+            {
+                etat.composante[v].store(AUCUN, std::memory_order_relaxed);
+                etat.couleur[v].store(0, std::memory_order_relaxed);
+                etat.marqueAvant[v].store(AUCUN, std::memory_order_relaxed);
+                etat.marqueArriere[v].store(AUCUN, std::memory_order_relaxed);
+                degreSortant[v].store(static_cast<unsigned int>(vue.debut[v + 1] - vue.debut[v]), std::memory_order_relaxed);
+                degreEntrant[v].store(static_cast<unsigned int>(inverse.debut[v + 1] - inverse.debut[v]), std::memory_order_relaxed);
+                if (vue.debut[v + 1] == vue.debut[v] || inverse.debut[v + 1] == inverse.debut[v])
+                    etat.locales[numero].push_back(static_cast<unsigned int>(v));
+            }
+        });
+
+        std::vector<unsigned int> vague;
+        etat.rassembler(vague);
+        while (!vague.empty())
+        {
+            pool.executer(vague.size(), TAILLE_PAQUET, [&](size_t debut, size_t fin, unsigned int numero)
+            {
+                for (size_t i = debut; i < fin; ++i)
+                {
+                    unsigned int v = vague[i];
+                    // Un sommet peut être proposé deux fois (degrés entrant et sortant tombés à zéro)
+                    unsigned int attendu = AUCUN;
+                    if (!etat.composante[v].compare_exchange_strong(attendu, EN_COURS))
+                        continue;
+                    etat.composante[v].store(etat.nbComposantes++, std::memory_order_relaxed);
+
+                    for (size_t a = vue.debut[v]; a < vue.debut[v + 1]; ++a)
+                    {
+                        unsigned int w = vue.destinations[a];
+                        if (degreEntrant[w].fetch_sub(1) == 1 && etat.composante[w].load() == AUCUN)
+                            etat.locales[numero].push_back(w);
+                    }
+                    for (size_t a = inverse.debut[v]; a < inverse.debut[v + 1]; ++a)
+                    {
+                        unsigned int w = inverse.destinations[a];
+                        if (degreSortant[w].fetch_sub(1) == 1 && etat.composante[w].load() == AUCUN)
+                            etat.locales[numero].push_back(w);
+                    }
+                }
+            });
+            etat.rassembler(vague);
+        }
+        degreEntrant.reset();
+        degreSortant.reset();
+
+        // Parcours avant-arrière sur les sommets restants
+        std::vector<SousProbleme> problemes(1);
+        problemes[0].couleur = 0;
+        pool.executer(n, TAILLE_PAQUET, [&](size_t debut, size_t fin, unsigned int numero)
+        {
+            for (size_t v = debut; v < fin; ++v)
+            {
+                if (etat.composante[v].load(std::memory_order_relaxed) == AUCUN)
+                    etat.locales[numero].push_back(static_cast<unsigned int>(v));
+            }
+        });
+        etat.rassembler(problemes[0].sommets);
+        if (problemes[0].sommets.empty())
+            problemes.clear();
+
+        std::vector<std::vector<SousProbleme> > produits(pool.getNombreThreads());
+        while (!problemes.empty())
+        {
+            std::vector<SousProbleme> suivants;
+            std::vector<const SousProbleme*> petits;
+            for (const auto& probleme : problemes)
+            {
+                if (probleme.sommets.size() > SEUIL_PARCOURS_PARALLELE)
+                    diviser(etat, probleme, true, suivants);
+                else
+                    petits.push_back(&probleme);
+            }
+
+            pool.executer(petits.size(), 1, [&](size_t debut, size_t fin, unsigned int numero)
+            {
+                for (size_t i = debut; i < fin; ++i)
+                    diviser(etat, *petits[i], false, produits[numero]);
+            });
+            for (auto& liste : produits)
+            {
+                for (auto& probleme : liste)
+                    suivants.push_back(std::move(probleme));
+                liste.clear();
+            }
+            problemes.swap(suivants);
+        }
+
+        // Renumérotation topologique : une composante reçoit son numéro quand toutes celles qu'elle atteint
+        // en ont un. Les sommets et leurs arcs sont parcourus par numéro croissant, ce qui rend le résultat
+        // indépendant des numéros provisoires.
+        size_t nbComposantes = etat.nbComposantes;
+        composante.resize(n);
+        for (size_t v = 0; v < n; ++v)
+            composante[v] = etat.composante[v].load(std::memory_order_relaxed);
+
+        std::vector<size_t> debutMembres(nbComposantes + 1, 0);
+        std::vector<size_t> degre(nbComposantes, 0);
+        for (size_t u = 0; u < n; ++u)
+        {
+            debutMembres[composante[u] + 1]++;
+            for (size_t a = vue.debut[u]; a < vue.debut[u + 1]; ++a)
+            {
+                if (composante[vue.destinations[a]] != composante[u])
+                    degre[composante[u]]++;
+            }
+        }
+        for (size_t c = 0; c < nbComposantes; ++c)
+            debutMembres[c + 1] += debutMembres[c];
+        std::vector<unsigned int> membres(n);
+        std::vector<size_t> position(debutMembres.begin(), debutMembres.end() - 1);
+        for (size_t v = 0; v < n; ++v)
+            membres[position[composante[v]]++] = static_cast<unsigned int>(v);
+
+        std::vector<unsigned int> numero(nbComposantes, AUCUN);
+        std::vector<unsigned int> file;
+        file.reserve(nbComposantes);
+        for (size_t v = 0; v < n; ++v)
+        {
+            unsigned int c = composante[v];
+            if (degre[c] == 0 && numero[c] == AUCUN)
+            {
+                numero[c] = static_cast<unsigned int>(file.size());
+                file.push_back(c);
+            }
+        }
+        for (size_t i = 0; i < file.size(); ++i)
+        {
+            unsigned int c = file[i];
+            for (size_t m = debutMembres[c]; m < debutMembres[c + 1]; ++m)
+            {
+                unsigned int u = membres[m];
+                for (size_t a = inverse.debut[u]; a < inverse.debut[u + 1]; ++a)
+                {
+                    unsigned int cw = composante[inverse.destinations[a]];
+                    if (cw != c && --degre[cw] == 0)
+                    {
+                        numero[cw] = static_cast<unsigned int>(file.size());
+                        file.push_back(cw);
+                    }
+                }
+            }
+        }
+
+        for (auto& c : composante)
+            c = numero[c];
+        return nbComposantes;
+    }
+
+    /**
+     * @brief Sépare un sous-problème en la composante du pivot et trois sous-problèmes.
+     * @param etat Les tableaux partagés du calcul.
+     * @param probleme Le sous-problème (ses sommets sont vivants et portent sa couleur).
+     * @param parallele true pour paralléliser les parcours (appel hors d'une tâche du pool).
+     * @param sortie Reçoit les sous-problèmes non vides produits.
+     */
+    void ComposantesParalleles::diviser(Etat& etat, const SousProbleme& probleme, bool parallele,
+                                        std::vector<SousProbleme>& sortie)
+    {
+        const VueAdjacence& vue = *etat.vue;
+        const VueAdjacence& inverse = *etat.inverse;
+        if (probleme.sommets.size() == 1)
+        {
+            etat.composante[probleme.sommets[0]].store(etat.nbComposantes++, std::memory_order_relaxed);
+            return;
+        }
+
+        // Pivot : le plus grand produit des degrés, qui a le plus de chances d'être dans une grande composante
+        unsigned int pivot = probleme.sommets[0];
+        size_t meilleur = 0;
+        for (auto v : probleme.sommets)
+        {
+            size_t produit = (vue.debut[v + 1] - vue.debut[v]) * (inverse.debut[v + 1] - inverse.debut[v]);
+            if (produit > meilleur)
+            {
+                meilleur = produit;
+                pivot = v;
+            }
+        }
+
+        unsigned int c = probleme.couleur;
+        parcourir(etat, vue, pivot, c, true, parallele);
+        parcourir(etat, inverse, pivot, c, false, parallele);
+
+        unsigned int numero = etat.nbComposantes++;
+        unsigned int premiereCouleur = etat.nbCouleurs.fetch_add(3);
+        SousProbleme parts[3];	// Descendants seuls, ascendants seuls, ni l'un ni l'autre
+        for (int k = 0; k < 3; ++k)
+            parts[k].couleur = premiereCouleur + k;
+
+        for (auto v : probleme.sommets)
+        {
+            bool descendant = etat.marqueAvant[v].load(std::memory_order_relaxed) == c;
+            bool ascendant = etat.marqueArriere[v].load(std::memory_order_relaxed) == c;
+            int k = descendant ? (ascendant ? -1 : 0) : (ascendant ? 1 : 2);
+            if (k < 0)
+            {
+                etat.composante[v].store(numero, std::memory_order_relaxed);
+            }
+            else
+            {
+                etat.couleur[v].store(parts[k].couleur, std::memory_order_relaxed);
+                parts[k].sommets.push_back(v);
+            }
+        }
+
+        for (int k = 0; k < 3; ++k)
+        {
+            if (!parts[k].sommets.empty())
+                sortie.push_back(std::move(parts[k]));
+        }
+    }
+
+    /**
+     * @brief Parcours (en profondeur, ou en largeur par niveaux parallèles) restreint à un sous-problème.
+     * @param etat Les tableaux partagés du calcul.
+     * @param vue La vue parcourue (graphe pour les descendants, graphe inverse pour les ascendants).
+     * @param pivot Le sommet de départ.
+     * @param couleur La couleur du sous-problème.
+     * @param avant true pour écrire dans marqueAvant, false pour marqueArriere.
+     * @param parallele true pour traiter chaque niveau du parcours en parallèle.
+     */
+    void ComposantesParalleles::parcourir(Etat& etat, const VueAdjacence& vue, unsigned int pivot,
+                                          unsigned int couleur, bool avant, bool parallele)
+    {
+        std::atomic<unsigned int>* marque = avant ? etat.marqueAvant.get() : etat.marqueArriere.get();
+        marque[pivot].store(couleur, std::memory_order_relaxed);
+
+        if (!parallele)
+        {
+            std::vector<unsigned int> pile(1, pivot);
+            while (!pile.empty())
+            {
+                unsigned int u = pile.back();
+                pile.pop_back();
+                for (size_t a = vue.debut[u]; a < vue.debut[u + 1]; ++a)
+                {
+                    unsigned int w = vue.destinations[a];
+                    if (marque[w].load(std::memory_order_relaxed) != couleur && etat.vivant(w, couleur))
+                    {
+                        marque[w].store(couleur, std::memory_order_relaxed);
+                        pile.push_back(w);
+                    }
+                }
+            }
+            return;
+        }
+
+        std::vector<unsigned int> niveau(1, pivot);
+        while (!niveau.empty())
+        {
+            pool.executer(niveau.size(), TAILLE_PAQUET, [&](size_t debut, size_t fin, unsigned int numero)
+            {
+                for (size_t i = debut; i < fin; ++i)
+                {
+                    unsigned int u = niveau[i];
+                    for (size_t a = vue.debut[u]; a < vue.debut[u + 1]; ++a)
+                    {
+                        unsigned int w = vue.destinations[a];
+                        unsigned int ancienne = marque[w].load(std::memory_order_relaxed);
+                        if (ancienne != couleur && etat.vivant(w, couleur)
+                            && marque[w].compare_exchange_strong(ancienne, couleur))
+                        {
+                            etat.locales[numero].push_back(w);
+                        }
+                    }
+                }
+            });
+            etat.rassembler(niveau);
+        }
+    }
+
+}//Fin du namespace TP2
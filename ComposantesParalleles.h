@@ -0,0 +1,70 @@
+/**
+ * \file ComposantesParalleles.h
+ * \brief Composantes fortement connexes calculées en parallèle.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include "Graphe.h"
+#include "Parallelisme.h"
+#include <vector>
+
+#ifndef _COMPOSANTESPARALLELES__H
+#define _COMPOSANTESPARALLELES__H
+
+namespace TP2
+{
+
+/**
+ * \class ComposantesParalleles
+ * \brief Composantes fortement connexes par élagage et parcours avant-arrière (forward-backward)
+ *
+ * L'élagage retire d'abord, par vagues parallèles, les sommets sans arc entrant ou sans arc sortant vivant :
+ * chacun forme une composante à lui seul. Les sommets restants forment un sous-problème; pour chaque
+ * sous-problème, un pivot est choisi et ses descendants et ascendants (dans le sous-problème) sont marqués.
+ * Leur intersection est la composante du pivot; les trois autres parts (descendants seuls, ascendants seuls,
+ * ni l'un ni l'autre) sont des sous-problèmes indépendants. Les petits sous-problèmes sont traités en
+ * parallèle les uns des autres, les grands un par un avec des parcours en largeur parallèles.
+ */
+    class ComposantesParalleles
+    {
+    public:
+
+        // nbThreads : taille du pool de travail (0 = tous les coeurs)
+        explicit ComposantesParalleles(unsigned int nbThreads = 0);
+
+        // Numérote les composantes fortement connexes (vue et vue inverse), les puits du graphe des composantes
+        // en premier : les arcs entre composantes vont toujours vers un numéro inférieur. La numérotation ne
+        // dépend que de la partition, pas de l'ordre d'exécution des threads. Retourne le nombre de composantes.
+        size_t calculer(const VueAdjacence& vue, const VueAdjacence& inverse, std::vector<unsigned int>& composante);
+
+    private:
+
+        // Au-delà de cette taille, un sous-problème est parcouru en parallèle
+        static const size_t SEUIL_PARCOURS_PARALLELE = 4096;
+
+        struct SousProbleme
+        {
+            unsigned int couleur;
+            std::vector<unsigned int> sommets;
+        };
+
+        // Tableaux partagés par les threads pendant un calcul (définis dans ComposantesParalleles.cpp)
+        struct Etat;
+
+        PoolTravail pool;
+
+        // Sépare un sous-problème autour d'un pivot; les sous-problèmes non vides produits sont ajoutés à sortie
+        void diviser(Etat& etat, const SousProbleme& probleme, bool parallele, std::vector<SousProbleme>& sortie);
+
+        // Marque (marque[v] = couleur du sous-problème) les sommets du sous-problème atteints depuis pivot dans vue
+        void parcourir(Etat& etat, const VueAdjacence& vue, unsigned int pivot, unsigned int couleur,
+                       bool avant, bool parallele);
+    };
+
+}//Fin du namespace
+
+#endif
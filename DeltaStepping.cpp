@@ -0,0 +1,223 @@
+/**
+ * \file DeltaStepping.cpp
+ * \brief Implémentation du moteur delta-stepping.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory>
+
+#include "DeltaStepping.h"
+
+namespace TP2
+{
+
+    namespace
+    {
+        const float INFINI = std::numeric_limits<float>::infinity();
+        const size_t TAILLE_PAQUET = 256;	// Sommets par paquet de travail
+
+        // Les flottants positifs ou nuls (et +infini) sont ordonnés comme leurs représentations binaires
+        uint32_t versBits(float valeur)
+        {
+            uint32_t bits;
+            std::memcpy(&bits, &valeur, sizeof(bits));
+            return bits;
+        }
+
+        float versFlottant(uint32_t bits)
+        {
+            float valeur;
+            std::memcpy(&valeur, &bits, sizeof(valeur));
+            return valeur;
+        }
+
+        // Minimum atomique : retourne true si la distance a diminué
+        bool diminuer(std::atomic<uint32_t>& distance, float candidat)
+        {
+            uint32_t nouvelle = versBits(candidat);
+            uint32_t actuelle = distance.load(std::memory_order_relaxed);
+            while (nouvelle < actuelle)
+            {
+                if (distance.compare_exchange_weak(actuelle, nouvelle, std::memory_order_relaxed))
+                    return true;
+            }
+            return false;
+        }
+    }
+
+    /**
+     * @brief Constructeur : démarre le pool de travail.
+     * @param nbThreads Le nombre de threads (0 = tous les coeurs).
+     */
+    DeltaStepping::DeltaStepping(unsigned int nbThreads) : pool(nbThreads)
+    {
+    }
+
+    /**
+     * @brief Choisit la largeur des seaux à partir d'un échantillon des pondérations.
+     * @param vue La vue d'adjacence.
+     * @param dureeCout Le critère.
+     * @return La largeur des seaux (strictement positive).
+     */
+    float DeltaStepping::choisirDelta(const VueAdjacence& vue, bool dureeCout)
+    {
+        const std::vector<float>& poids = vue.ponderations(dureeCout);
+        if (poids.empty())
+            return 1.0;
+
+        // Échantillon régulier d'au plus 4096 arcs
+        size_t pasEchantillon = std::max<size_t>(1, poids.size() / 4096);
+        std::vector<float> echantillon;
+        for (size_t a = 0; a < poids.size(); a += pasEchantillon)
+            echantillon.push_back(poids[a]);
+        std::sort(echantillon.begin(), echantillon.end());
+
+        float maximum = echantillon.back();
+        float decile = echantillon[echantillon.size() / 10];
+        double degreMoyen = static_cast<double>(poids.size()) / std::max<size_t>(1, vue.nbSommets());
+
+        float delta = static_cast<float>(maximum / std::max(1.0, degreMoyen));
+        delta = std::max(delta, decile);
+        delta = std::min(delta, maximum);
+        return delta > 0 ? delta : 1.0f;
+    }
+
+    /**
+     * @brief Calcule les distances depuis une origine par delta-stepping parallèle.
+     * @param vue La vue d'adjacence.
+     * @param source Le sommet de départ.
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @param distances Reçoit les distances (+infini si non atteint).
+     * @param delta La largeur des seaux (<= 0 : choisie automatiquement).
+     * @throws std::logic_error Si la source est hors de la vue ou si un arc est négatif.
+     */
+    void DeltaStepping::calculer(const VueAdjacence& vue, size_t source, bool dureeCout,
+                                 std::vector<float>& distances, float delta)
+    {
+        const size_t n = vue.nbSommets();
+        const std::vector<float>& poids = vue.ponderations(dureeCout);
+        if (source >= n)
+        {
+            throw std::logic_error("DeltaStepping::calculer : source hors du graphe");
+        }
+        for (auto p : poids)
+        {
+            if (p < 0)
+                throw std::logic_error("DeltaStepping::calculer : les arcs ne sont pas tous non négatifs");
+        }
+        if (delta <= 0)
+        {
+            delta = choisirDelta(vue, dureeCout);
+        }
+
+        std::unique_ptr<std::atomic<uint32_t>[]> dist(new std::atomic<uint32_t>[n]);
+        for (size_t v = 0; v < n; ++v)
+            dist[v].store(versBits(INFINI), std::memory_order_relaxed);
+        dist[source].store(versBits(0.0f), std::memory_order_relaxed);
+
+        auto seauDe = [&](float d) { return static_cast<size_t>(static_cast<double>(d) / delta); };
+
+        std::map<size_t, std::vector<unsigned int> > seaux;
+        seaux[0].push_back(static_cast<unsigned int>(source));
+
+        std::vector<std::vector<unsigned int> > misesAJour(pool.getNombreThreads());
+        std::vector<unsigned int> frontiere;	// Sommets du seau courant à traiter dans cette phase
+        std::vector<unsigned int> regles;		// Sommets passés par le seau courant (pour les arcs lourds)
+        std::vector<size_t> phaseDe(n, SIZE_MAX);	// Dernière phase où le sommet était dans la frontière
+        std::vector<size_t> seauRegle(n, SIZE_MAX);	// Dernier seau où le sommet a été réglé
+        size_t phase = 0;
+
+        // Relâche en parallèle les arcs (légers ou lourds) des sommets de la liste
+        auto relacher = [&](const std::vector<unsigned int>& sommets, bool legers)
+        {
+            pool.executer(sommets.size(), TAILLE_PAQUET, [&](size_t debut, size_t fin, unsigned int numero)
+            {
+                std::vector<unsigned int>& locales = misesAJour[numero];
+                for (size_t i = debut; i < fin; ++i)
+                {
+                    unsigned int u = sommets[i];
+                    float du = versFlottant(dist[u].load(std::memory_order_relaxed));
+                    for (size_t a = vue.debut[u]; a < vue.debut[u + 1]; ++a)
+                    {
+                        if ((poids[a] <= delta) != legers)
+                            continue;
+                        unsigned int v = vue.destinations[a];
+                        if (diminuer(dist[v], du + poids[a]))
+                            locales.push_back(v);
+                    }
+                }
+            });
+        };
+
+        while (!seaux.empty())
+        {
+            size_t courant = seaux.begin()->first;
+            std::vector<unsigned int> candidats;
+            candidats.swap(seaux.begin()->second);
+            seaux.erase(seaux.begin());
+            regles.clear();
+
+            // Phases légères jusqu'à stabilisation du seau courant
+            while (!candidats.empty())
+            {
+                phase++;
+                frontiere.clear();
+                for (auto v : candidats)
+                {
+                    // Ignorer les entrées périmées (sommet amélioré vers un autre seau) et les doublons
+                    float dv = versFlottant(dist[v].load(std::memory_order_relaxed));
+                    if (seauDe(dv) == courant && phaseDe[v] != phase)
+                    {
+                        phaseDe[v] = phase;
+                        frontiere.push_back(v);
+                        if (seauRegle[v] != courant)
+                        {
+                            seauRegle[v] = courant;
+                            regles.push_back(v);
+                        }
+                    }
+                }
+                candidats.clear();
+
+                relacher(frontiere, true);
+
+                for (auto& locales : misesAJour)
+                {
+                    for (auto v : locales)
+                    {
+                        size_t seau = seauDe(versFlottant(dist[v].load(std::memory_order_relaxed)));
+                        if (seau == courant)
+                            candidats.push_back(v);
+                        else
+                            seaux[seau].push_back(v);
+                    }
+                    locales.clear();
+                }
+            }
+
+            // Arcs lourds : leurs destinations tombent toujours dans un seau ultérieur
+            relacher(regles, false);
+            for (auto& locales : misesAJour)
+            {
+                for (auto v : locales)
+                    seaux[seauDe(versFlottant(dist[v].load(std::memory_order_relaxed)))].push_back(v);
+                locales.clear();
+            }
+        }
+
+        distances.resize(n);
+        for (size_t v = 0; v < n; ++v)
+            distances[v] = versFlottant(dist[v].load(std::memory_order_relaxed));
+    }
+
+}//Fin du namespace TP2
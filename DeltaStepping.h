@@ -0,0 +1,55 @@
+/**
+ * \file DeltaStepping.h
+ * \brief Plus courts chemins depuis une origine par delta-stepping parallèle.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include "Graphe.h"
+#include "Parallelisme.h"
+#include <vector>
+
+#ifndef _DELTASTEPPING__H
+#define _DELTASTEPPING__H
+
+namespace TP2
+{
+
+/**
+ * \class DeltaStepping
+ * \brief Moteur delta-stepping (Meyer et Sanders) sur une vue d'adjacence
+ *
+ * Les sommets sont rangés dans des seaux de largeur delta selon leur distance provisoire. Le seau non vide
+ * de plus petit indice est vidé par phases : les arcs légers (pondération <= delta) de tous ses sommets sont
+ * relâchés en parallèle, ce qui peut remettre des sommets dans le même seau; une fois le seau stable, les arcs
+ * lourds des sommets qui y sont passés sont relâchés à leur tour. Les relâchements concurrents utilisent un
+ * minimum atomique sur la représentation binaire des distances (ordonnée comme les flottants positifs).
+ */
+    class DeltaStepping
+    {
+    public:
+
+        // nbThreads : taille du pool de travail (0 = tous les coeurs)
+        explicit DeltaStepping(unsigned int nbThreads = 0);
+
+        // Calcule les distances depuis source (+infini si non atteint).
+        // delta <= 0 : largeur des seaux choisie par choisirDelta.
+        // Exception logic_error si source est hors de la vue ou si un arc est négatif
+        void calculer(const VueAdjacence& vue, size_t source, bool dureeCout, std::vector<float>& distances,
+                      float delta = 0);
+
+        // Largeur de seau adaptée à la distribution des pondérations : pondération maximale divisée par le
+        // degré moyen (Meyer et Sanders), bornée entre le premier décile et le maximum d'un échantillon des arcs
+        static float choisirDelta(const VueAdjacence& vue, bool dureeCout);
+
+    private:
+
+        PoolTravail pool;
+    };
+
+}//Fin du namespace
+
+#endif
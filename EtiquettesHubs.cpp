@@ -0,0 +1,257 @@
+/**
+ * \file EtiquettesHubs.cpp
+ * \brief Implémentation de l'index d'étiquettes de hubs.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+#include "EtiquettesHubs.h"
+
+namespace TP2
+{
+
+    namespace
+    {
+        const float INFINI = std::numeric_limits<float>::infinity();
+
+        // Entrée d'une étiquette pendant la construction
+        struct Entree
+        {
+            uint32_t hub;
+            float distance;
+            uint32_t voisin;
+        };
+    }
+
+    /**
+     * @brief Constructeur : pruned landmark labeling, hubs par degré décroissant.
+     * Pour le hub h de rang k, le Dijkstra avant (distances d(h, u)) ajoute (k, d) à l'étiquette entrante de
+     * chaque sommet u solutionné, sauf si les étiquettes déjà construites donnent d(h, u) <= d : u n'est alors
+     * ni étiqueté ni développé. Le Dijkstra arrière fait de même pour les étiquettes sortantes. Un tableau
+     * indexé par rang contient l'étiquette de h, ce qui rend le test d'élagage linéaire en la taille de
+     * l'étiquette de u.
+     * @param vue La vue d'adjacence du graphe.
+     * @param inverse La vue d'adjacence du graphe inverse.
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @throws std::logic_error Si un arc est négatif.
+     */
+    EtiquettesHubs::EtiquettesHubs(const VueAdjacence& vue, const VueAdjacence& inverse, bool dureeCout)
+    {
+        typedef std::pair<float, uint32_t> Element;
+        const size_t n = vue.nbSommets();
+        for (auto p : vue.ponderations(dureeCout))
+        {
+            if (p < 0)
+                throw std::logic_error("EtiquettesHubs : les arcs ne sont pas tous non négatifs");
+        }
+
+        ordre.resize(n);
+        for (size_t v = 0; v < n; ++v)
+            ordre[v] = static_cast<uint32_t>(v);
+        auto degre = [&](uint32_t v) { return vue.debut[v + 1] - vue.debut[v] + inverse.debut[v + 1] - inverse.debut[v]; };
+        std::stable_sort(ordre.begin(), ordre.end(), [&](uint32_t a, uint32_t b) { return degre(a) > degre(b); });
+
+        std::vector<std::vector<Entree> > etiquettesSortantes(n), etiquettesEntrantes(n);
+        std::vector<float> etiquetteHub(n, INFINI);	// Étiquette du hub courant, indexée par rang
+        std::vector<float> distances(n, INFINI);
+        std::vector<uint32_t> voisins(n);
+        std::vector<uint32_t> touches;
+        std::vector<Element> tas;
+
+        for (uint32_t rang = 0; rang < n; ++rang)
+        {
+            const uint32_t hub = ordre[rang];
+            for (int passe = 0; passe < 2; ++passe)
+            {
+                const bool avant = passe == 0;
+                const VueAdjacence& graphe = avant ? vue : inverse;
+                const std::vector<float>& poids = graphe.ponderations(dureeCout);
+                std::vector<Entree>& etiquette = avant ? etiquettesSortantes[hub] : etiquettesEntrantes[hub];
+                std::vector<std::vector<Entree> >& cibles = avant ? etiquettesEntrantes : etiquettesSortantes;
+
+                for (const auto& entree : etiquette)
+                    etiquetteHub[entree.hub] = entree.distance;
+
+                distances[hub] = 0.0;
+                voisins[hub] = hub;
+                touches.push_back(hub);
+                tas.push_back(Element(0.0f, hub));
+                while (!tas.empty())
+                {
+                    std::pop_heap(tas.begin(), tas.end(), std::greater<Element>());
+                    Element courant = tas.back();
+                    tas.pop_back();
+                    uint32_t u = courant.second;
+                    if (courant.first > distances[u])
+                        continue;
+                    distances[u] = -1.0;	// Solutionné : ignoré s'il ressort du tas à égalité
+
+                    // Élagage : la paire (hub, u) est-elle déjà couverte?
+                    float connue = INFINI;
+                    for (const auto& entree : cibles[u])
+                    {
+                        float tmp = etiquetteHub[entree.hub] + entree.distance;
+                        if (tmp < connue)
+                            connue = tmp;
+                    }
+                    if (connue <= courant.first)
+                        continue;
+
+                    Entree entree = {rang, courant.first, voisins[u]};
+                    cibles[u].push_back(entree);
+                    for (size_t a = graphe.debut[u]; a < graphe.debut[u + 1]; ++a)
+                    {
+                        uint32_t v = graphe.destinations[a];
+                        float tmp = courant.first + poids[a];
+                        if (tmp < distances[v])
+                        {
+                            if (distances[v] == INFINI)
+                                touches.push_back(v);
+                            distances[v] = tmp;
+                            voisins[v] = u;
+                            tas.push_back(Element(tmp, v));
+                            std::push_heap(tas.begin(), tas.end(), std::greater<Element>());
+                        }
+                    }
+                }
+
+                for (auto v : touches)
+                    distances[v] = INFINI;
+                touches.clear();
+                for (const auto& e : etiquette)
+                    etiquetteHub[e.hub] = INFINI;
+            }
+        }
+
+        // Tableaux contigus
+        for (auto cible : {std::make_pair(&sortantes, &etiquettesSortantes),
+                           std::make_pair(&entrantes, &etiquettesEntrantes)})
+        {
+            Etiquettes& etiquettes = *cible.first;
+            std::vector<std::vector<Entree> >& listes = *cible.second;
+            etiquettes.debut.assign(n + 1, 0);
+            for (size_t v = 0; v < n; ++v)
+                etiquettes.debut[v + 1] = etiquettes.debut[v] + listes[v].size();
+            size_t total = etiquettes.debut[n];
+            etiquettes.hubs.reserve(total);
+            etiquettes.distances.reserve(total);
+            etiquettes.voisins.reserve(total);
+            for (size_t v = 0; v < n; ++v)
+            {
+                for (const auto& entree : listes[v])
+                {
+                    etiquettes.hubs.push_back(entree.hub);
+                    etiquettes.distances.push_back(entree.distance);
+                    etiquettes.voisins.push_back(entree.voisin);
+                }
+                std::vector<Entree>().swap(listes[v]);
+            }
+        }
+    }
+
+    /**
+     * @brief Distance entre deux sommets par fusion de leurs étiquettes.
+     * @return La distance, +infini si destination n'est pas atteignable.
+     */
+    float EtiquettesHubs::distance(unsigned int source, unsigned int destination) const
+    {
+        if (source == destination)
+            return 0.0;
+        size_t i, j;
+        if (!meilleurHub(source, destination, i, j))
+            return INFINI;
+        return sortantes.distances[i] + entrantes.distances[j];
+    }
+
+    /**
+     * @brief Déplie le plus court chemin en suivant les voisins vers le meilleur hub commun.
+     * Les ancêtres d'un sommet étiqueté dans l'arbre élagué d'un hub ont tous été développés, donc étiquetés
+     * par ce hub : la remontée trouve toujours l'entrée suivante.
+     * @param source Le sommet de départ.
+     * @param destination Le sommet d'arrivée.
+     * @param sommets Reçoit les sommets du chemin.
+     * @return false si destination n'est pas atteignable.
+     */
+    bool EtiquettesHubs::chemin(unsigned int source, unsigned int destination, std::vector<unsigned int>& sommets) const
+    {
+        sommets.clear();
+        sommets.push_back(source);
+        if (source == destination)
+            return true;
+        size_t i, j;
+        if (!meilleurHub(source, destination, i, j))
+        {
+            sommets.clear();
+            return false;
+        }
+        const uint32_t rang = sortantes.hubs[i];
+        const uint32_t hub = ordre[rang];
+
+        // De la source jusqu'au hub
+        for (unsigned int v = source; v != hub;)
+        {
+            v = sortantes.voisins[trouver(sortantes, v, rang)];
+            sommets.push_back(v);
+        }
+
+        // Du hub jusqu'à la destination, remonté à partir de la destination
+        size_t milieu = sommets.size();
+        for (unsigned int v = destination; v != hub;)
+        {
+            sommets.push_back(v);
+            v = entrantes.voisins[trouver(entrantes, v, rang)];
+        }
+        std::reverse(sommets.begin() + milieu, sommets.end());
+        return true;
+    }
+
+    size_t EtiquettesHubs::getNombreEntrees() const
+    {
+        return sortantes.hubs.size() + entrantes.hubs.size();
+    }
+
+    bool EtiquettesHubs::meilleurHub(unsigned int source, unsigned int destination, size_t& entreeSortante,
+                                     size_t& entreeEntrante) const
+    {
+        size_t i = sortantes.debut[source], finI = sortantes.debut[source + 1];
+        size_t j = entrantes.debut[destination], finJ = entrantes.debut[destination + 1];
+        float meilleure = INFINI;
+        while (i < finI && j < finJ)
+        {
+            uint32_t a = sortantes.hubs[i], b = entrantes.hubs[j];
+            if (a == b)
+            {
+                float tmp = sortantes.distances[i] + entrantes.distances[j];
+                if (tmp < meilleure)
+                {
+                    meilleure = tmp;
+                    entreeSortante = i;
+                    entreeEntrante = j;
+                }
+                ++i;
+                ++j;
+            }
+            else if (a < b)
+                ++i;
+            else
+                ++j;
+        }
+        return meilleure != INFINI;
+    }
+
+    size_t EtiquettesHubs::trouver(const Etiquettes& etiquettes, unsigned int sommet, uint32_t rang)
+    {
+        auto debut = etiquettes.hubs.begin() + etiquettes.debut[sommet];
+        auto fin = etiquettes.hubs.begin() + etiquettes.debut[sommet + 1];
+        return static_cast<size_t>(std::lower_bound(debut, fin, rang) - etiquettes.hubs.begin());
+    }
+
+}//Fin du namespace TP2
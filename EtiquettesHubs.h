@@ -0,0 +1,76 @@
+/**
+ * \file EtiquettesHubs.h
+ * \brief Index d'étiquettes de hubs (pruned landmark labeling) pour les requêtes de distance.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include "Graphe.h"
+#include <cstdint>
+#include <vector>
+
+#ifndef _ETIQUETTESHUBS__H
+#define _ETIQUETTESHUBS__H
+
+namespace TP2
+{
+
+/**
+ * \class EtiquettesHubs
+ * \brief Étiquettes de hubs d'un graphe orienté pour un critère
+ *
+ * Chaque sommet u reçoit une étiquette sortante (hubs h et d(u, h)) et une étiquette entrante (hubs h et
+ * d(h, u)), telles que pour toute paire atteignable, un hub commun se trouve sur un plus court chemin : la
+ * distance est le minimum de d(s, h) + d(h, t) sur les hubs communs, calculé par une fusion des deux
+ * étiquettes triées. Construction par pruned landmark labeling (Akiba et al.) : les sommets sont pris comme
+ * hubs par degré décroissant, et le Dijkstra de chaque hub (avant, puis arrière) est élagué dès qu'une paire
+ * est déjà couverte par les hubs précédents. Les étiquettes sont rangées dans des tableaux contigus (CSR),
+ * triées par rang de hub. Chaque entrée garde le sommet voisin sur le chemin vers son hub, ce qui permet de
+ * déplier le chemin sans recherche.
+ */
+    class EtiquettesHubs
+    {
+    public:
+
+        // Construit les étiquettes du critère dureeCout (vue et vue inverse)
+        // Exception logic_error si un arc est négatif
+        EtiquettesHubs(const VueAdjacence& vue, const VueAdjacence& inverse, bool dureeCout);
+
+        // Distance de source à destination, +infini si destination n'est pas atteignable
+        float distance(unsigned int source, unsigned int destination) const;
+
+        // Écrit dans sommets le plus court chemin de source à destination. Retourne false s'il n'existe pas.
+        bool chemin(unsigned int source, unsigned int destination, std::vector<unsigned int>& sommets) const;
+
+        // Nombre total d'entrées des étiquettes (sortantes et entrantes)
+        size_t getNombreEntrees() const;
+
+    private:
+
+        // Étiquettes de tous les sommets : entrées de u dans [debut[u], debut[u + 1])
+        struct Etiquettes
+        {
+            std::vector<size_t> debut;
+            std::vector<uint32_t> hubs;			// Rang du hub, croissant dans chaque étiquette
+            std::vector<float> distances;
+            std::vector<uint32_t> voisins;		// Sommet suivant (sortantes) ou précédent (entrantes) vers le hub
+        };
+
+        std::vector<uint32_t> ordre;	// Sommet de chaque rang
+        Etiquettes sortantes;
+        Etiquettes entrantes;
+
+        // Meilleur hub commun de source et destination; retourne false s'il n'y en a pas
+        bool meilleurHub(unsigned int source, unsigned int destination, size_t& entreeSortante,
+                         size_t& entreeEntrante) const;
+
+        // Position du hub de rang rang dans l'étiquette de sommet (recherche dichotomique)
+        static size_t trouver(const Etiquettes& etiquettes, unsigned int sommet, uint32_t rang);
+    };
+
+}//Fin du namespace
+
+#endif
@@ -19,7 +19,7 @@ namespace TP2
      * @brief Constructeur de la classe Graphe.
      * @param[in] nbSommets : le nombre de sommets du graphe.
      */
-    Graphe::Graphe(size_t nbSommets) : noms(std::vector<std::string>(nbSommets)), listesAdj(std::vector<std::list<Arc>>(nbSommets)), nbSommets(nbSommets), nbArcs(0)
+    Graphe::Graphe(size_t nbSommets) : noms(std::vector<std::string>(nbSommets)), listesAdj(std::vector<std::list<Arc>>(nbSommets)), nbSommets(nbSommets), nbArcs(0), version(0), versionTopologie(0)
     {
         // Le corps du constructeur est vide car aucune initialisation supplémentaire n'est nécessaire.
     }
@@ -40,6 +40,19 @@ namespace TP2
      */
     void Graphe::resize(size_t nouvelleTaille)
     {
+        // En réduisant, retirer les arcs qui partent des sommets supprimés ou qui y arrivent
+        if (nouvelleTaille < nbSommets)
+        {
+            for (size_t s = nouvelleTaille; s < nbSommets; ++s)
+                nbArcs -= listesAdj[s].size();
+            for (size_t s = 0; s < nouvelleTaille; ++s)
+            {
+                size_t avant = listesAdj[s].size();
+                listesAdj[s].remove_if([nouvelleTaille](const Arc& arc) { return arc.destination >= nouvelleTaille; });
+                nbArcs -= avant - listesAdj[s].size();
+            }
+        }
+
         // Redimensionner le vecteur des noms des sommets
         noms.resize(nouvelleTaille);
 
@@ -48,6 +61,8 @@ namespace TP2
 
         // Mettre à jour le nombre de sommets avec la nouvelle taille
         nbSommets = nouvelleTaille;
+        version++;
+        versionTopologie++;
     }
 
 
@@ -67,6 +82,7 @@ namespace TP2
             // Assigner le nom au sommet s'il est valide
         else {
             noms[sommet].assign(nom);
+            version++;
         }
     }
 
@@ -100,13 +116,13 @@ namespace TP2
         }
 
         // Créer un nouvel arc avec la destination et les pondérations spécifiées
-        auto tmp = new Graphe::Arc(destination, Ponderations(duree, cout));
-
-        // Ajouter l'arc à la liste d'adjacence du sommet source
-        listesAdj[source].push_back(*tmp);
+        // et l'ajouter à la liste d'adjacence du sommet source
+        listesAdj[source].push_back(Graphe::Arc(destination, Ponderations(duree, cout)));
 
         // Augmenter le nombre d'arcs du graphe
         nbArcs++;
+        version++;
+        versionTopologie++;
     }
 
 
@@ -144,11 +160,51 @@ namespace TP2
             {
                 listesAdj[source].erase(itr);
                 nbArcs--;
+                version++;
+                versionTopologie++;
+                break;
             }
         }
     }
 
 
+    /**
+     * @brief Cette méthode modifie les pondérations d'un arc existant.
+     * @param source Le numéro du sommet source de l'arc.
+     * @param destination Le numéro du sommet destination de l'arc.
+     * @param duree La nouvelle durée de l'arc.
+     * @param cout Le nouveau coût de l'arc.
+     * @throws std::logic_error Si le numéro de sommet source ou de sommet destination est invalide ou si l'arc n'existe pas.
+     */
+    void Graphe::modifierPonderations(size_t source, size_t destination, float duree, float cout){
+
+        // Vérifier si le numéro de sommet source est valide
+        if (source >= static_cast<size_t>(getNombreSommets()))
+        {
+            throw std::logic_error("modifierPonderations: numéro de sommet source invalide");
+        }
+
+        // Vérifier si le numéro de sommet destination est valide
+        if (destination >= static_cast<size_t>(getNombreSommets()))
+        {
+            throw std::logic_error("modifierPonderations: numéro de sommet destination invalide");
+        }
+
+        // Parcourir la liste d'adjacence du sommet source pour trouver l'arc à modifier
+        for (auto& arc : listesAdj[source])
+        {
+            if (arc.destination == destination)
+            {
+                arc.poids = Ponderations(duree, cout);
+                version++;
+                return;
+            }
+        }
+
+        throw std::logic_error("modifierPonderations: l'arc n'existe pas");
+    }
+
+
     /**
      * @brief Cettte méthode vérifie si un arc existe entre deux sommets du graphe.
      * @param source Le numéro du sommet source.
@@ -210,10 +266,10 @@ namespace TP2
     /**
      * @brief Cette méthode obtient le nom d'un sommet donné.
      * @param sommet Le numéro du sommet pour lequel on souhaite obtenir le nom.
-     * @return Le nom du sommet.
+     * @return Une référence vers le nom du sommet dans la table des noms (aucune copie).
      * @throws std::logic_error Si le numéro de sommet est invalide.
      */
-    std::string Graphe::getNomSommet(size_t sommet) const
+    const std::string& Graphe::getNomSommet(size_t sommet) const
     {
         // Vérifier si le numéro de sommet est valide
         if (sommet > getNombreSommets())
@@ -312,6 +368,110 @@ namespace TP2
     }
 
 
+    /**
+     * @brief Cette méthode construit une copie contiguë (CSR) des listes d'adjacence.
+     * @param inverse Si true, la vue décrit le graphe inverse (arcs destination -> source).
+     * @return La vue d'adjacence; les arcs d'un même sommet gardent l'ordre des listes d'adjacence.
+     */
+    VueAdjacence Graphe::construireVueAdjacence(bool inverse) const
+    {
+        VueAdjacence vue;
+        vue.debut.assign(nbSommets + 1, 0);
+        vue.destinations.resize(nbArcs);
+        vue.durees.resize(nbArcs);
+        vue.couts.resize(nbArcs);
+
+        // Compter les arcs sortants de chaque sommet (entrants pour l'inverse)
+        for (size_t s = 0; s < nbSommets; ++s)
+        {
+            for (const auto& arc : listesAdj[s])
+            {
+                vue.debut[(inverse ? arc.destination : s) + 1]++;
+            }
+        }
+        for (size_t s = 0; s < nbSommets; ++s)
+        {
+            vue.debut[s + 1] += vue.debut[s];
+        }
+
+        // Placer chaque arc à la prochaine position libre de son sommet
+        std::vector<size_t> position(vue.debut.begin(), vue.debut.end() - 1);
+        for (size_t s = 0; s < nbSommets; ++s)
+        {
+            for (const auto& arc : listesAdj[s])
+            {
+                size_t origine = inverse ? arc.destination : s;
+                size_t p = position[origine]++;
+                vue.destinations[p] = static_cast<unsigned int>(inverse ? s : arc.destination);
+                vue.durees[p] = arc.poids.duree;
+                vue.couts[p] = arc.poids.cout;
+            }
+        }
+
+        return vue;
+    }
+
+
+    /**
+     * @brief Cette méthode renumérote les sommets du graphe.
+     * @param nouveauNumero nouveauNumero[s] est le nouveau numéro de l'ancien sommet s.
+     * @throws std::logic_error Si nouveauNumero n'est pas une permutation de [0, nbSommets).
+     */
+    void Graphe::permuterSommets(const std::vector<size_t>& nouveauNumero)
+    {
+        // Vérifier que chaque numéro est utilisé une et une seule fois
+        if (nouveauNumero.size() != nbSommets)
+        {
+            throw std::logic_error("permuterSommets: taille de la permutation invalide");
+        }
+        std::vector<bool> utilises(nbSommets, false);
+        for (auto numero : nouveauNumero)
+        {
+            if (numero >= nbSommets || utilises[numero])
+            {
+                throw std::logic_error("permuterSommets: la renumérotation n'est pas une permutation");
+            }
+            utilises[numero] = true;
+        }
+
+        std::vector<std::string> nouveauxNoms(nbSommets);
+        std::vector<std::list<Arc> > nouvellesListes(nbSommets);
+        for (size_t s = 0; s < nbSommets; ++s)
+        {
+            nouveauxNoms[nouveauNumero[s]].swap(noms[s]);
+            std::list<Arc>& liste = nouvellesListes[nouveauNumero[s]];
+            liste.swap(listesAdj[s]);
+            for (auto& arc : liste)
+            {
+                arc.destination = nouveauNumero[arc.destination];
+            }
+        }
+        noms.swap(nouveauxNoms);
+        listesAdj.swap(nouvellesListes);
+        version++;
+        versionTopologie++;
+    }
+
+
+    /**
+    * @brief Cette méthode retourne la version courante du graphe.
+    * @return Un compteur incrémenté à chaque modification (noms, arcs, taille).
+    */
+    unsigned long Graphe::getVersion() const
+    {
+        return version;
+    }
+
+    /**
+    * @brief Cette méthode retourne la version de la structure du graphe.
+    * @return Un compteur incrémenté quand la taille, les arcs ou la numérotation changent.
+    */
+    unsigned long Graphe::getVersionTopologie() const
+    {
+        return versionTopologie;
+    }
+
+
     /**
      * @brief Vérifie si les pondérations de tous les arcs du graphe sont non négatives.
      * @return true si les pondérations de tous les arcs sont non négatives, false sinon.
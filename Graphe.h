@@ -36,6 +36,24 @@ namespace TP2
         Ponderations(float d, float c) : duree(d), cout(c) {}
     };
 
+/**
+* \struct VueAdjacence
+* \brief Copie contiguë (format CSR) des listes d'adjacence, utilisée par les moteurs de recherche
+*/
+    struct VueAdjacence
+    {
+        std::vector<size_t> debut;	// Les arcs sortants du sommet s occupent les indices [debut[s], debut[s+1])
+        std::vector<unsigned int> destinations;	// La destination de chaque arc
+        std::vector<float> durees;	// La durée de chaque arc
+        std::vector<float> couts;	// Le coût de chaque arc
+
+        // Retourne le nombre de sommets de la vue
+        size_t nbSommets() const { return debut.empty() ? 0 : debut.size() - 1; }
+
+        // Retourne les pondérations selon le critère (durée si dureeCout = true, coût sinon)
+        const std::vector<float>& ponderations(bool dureeCout) const { return dureeCout ? durees : couts; }
+    };
+
 /**
  * \class Graphe
  * \brief Classe représentant un graphe
@@ -60,7 +78,7 @@ namespace TP2
         bool arcsSontNonNegatifs() const;
 
         // Change la taille du graphe en utilisant un nombre de sommet = nouvelleTaille
-        // Vous pouvez supposer que cette méthode va être appliquée uniquement sur un graphe vide.
+        // En réduisant, les arcs qui touchent les sommets supprimés sont retirés.
         void resize(size_t nouvelleTaille);
 
         // Donne un nom à un sommet en utlisant son numéro (indice dans le vector).
@@ -77,6 +95,11 @@ namespace TP2
         // Exception logic_error si l'arc n'existe pas dans le graphe
         void enleverArc(size_t source, size_t destination);
 
+        // Modifie les pondérations d'un arc existant
+        // Exception logic_error si source ou destination supérieur à nbSommets
+        // Exception logic_error si l'arc n'existe pas dans le graphe
+        void modifierPonderations(size_t source, size_t destination, float duree, float cout);
+
         // Vérifie si un arc existe
         // Exception logic_error si source ou destination supérieur à nbSommets
         bool arcExiste(size_t source, size_t destination) const;
@@ -85,9 +108,9 @@ namespace TP2
         // Exception logic_error si sommet supérieur à nbSommets
         std::vector<size_t> listerSommetsAdjacents(size_t sommet) const;
 
-        // Retourne le nom d'un sommet
+        // Retourne le nom d'un sommet (référence dans la table des noms, valide jusqu'à la prochaine modification)
         // Exception logic_error si sommet supérieur à nbSommets
-        std::string getNomSommet(size_t sommet) const;
+        const std::string& getNomSommet(size_t sommet) const;
 
         // Retourne le numéro d'un sommet
         // Exception logic_error si nom n'existe pas dans le graphe
@@ -104,6 +127,21 @@ namespace TP2
         // Exception logic_error si l'arc n'existe pas dans le graphe
         Ponderations getPonderationsArc(size_t source, size_t destination) const;
 
+        // Renumérote les sommets : le sommet s devient nouveauNumero[s] (noms et arcs suivent)
+        // Exception logic_error si nouveauNumero n'est pas une permutation des sommets
+        void permuterSommets(const std::vector<size_t>& nouveauNumero);
+
+        // Retourne une copie contiguë des listes d'adjacence (ou de celles du graphe inverse si inverse = true)
+        VueAdjacence construireVueAdjacence(bool inverse = false) const;
+
+        // Retourne un compteur incrémenté à chaque modification du graphe.
+        // Permet aux structures dérivées (vues, index) de savoir si elles sont périmées.
+        unsigned long getVersion() const;
+
+        // Retourne un compteur incrémenté seulement quand la structure du graphe change (taille, arcs, numérotation),
+        // et non quand les noms ou les pondérations changent
+        unsigned long getVersionTopologie() const;
+
         //Ne touchez pas à cette fonction !
         friend std::ostream& operator<<(std::ostream& out, const Graphe& g)
         {
@@ -144,6 +182,8 @@ namespace TP2
 
         size_t nbSommets;	// Le nombre de sommets dans le graphe
         size_t nbArcs;		// Le nombre des arcs dans le graphe
+        unsigned long version;	// Incrémenté à chaque modification du graphe
+        unsigned long versionTopologie;	// Incrémenté à chaque modification de la structure du graphe
 
 
         //Vous pouvez ajoutez des méthodes privées si vous sentez leur nécessité
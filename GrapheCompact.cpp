@@ -0,0 +1,338 @@
+/**
+ * \file GrapheCompact.cpp
+ * \brief Implémentation du graphe compact.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <sstream>
+
+#include "GrapheCompact.h"
+
+namespace TP2
+{
+
+    const uint32_t GrapheCompact::AUCUN;
+
+    // À partir de 2^17, deux floats consécutifs sont à plus d'un cent d'écart : deux montants à deux décimales
+    // peuvent donner le même float, qui ne se reconvertit plus sans ambiguïté
+    const uint64_t MAXIMUM_CENTIEMES_FLOAT = (UINT64_C(1) << 17) * 100 - 1;
+
+    /**
+     * @brief Constructeur d'un graphe compact vide.
+     */
+    GrapheCompact::GrapheCompact() : debut(1, 0)
+    {
+    }
+
+    /**
+     * @brief Construit la représentation compacte d'un graphe.
+     * @param graphe Le graphe à convertir.
+     * @throws std::logic_error Si une pondération n'est pas représentable exactement ou si le graphe est trop grand.
+     */
+    GrapheCompact::GrapheCompact(const Graphe& graphe)
+    {
+        VueAdjacence vue = graphe.construireVueAdjacence();
+        if (vue.nbSommets() >= AUCUN || vue.destinations.size() >= AUCUN)
+        {
+            throw std::logic_error("GrapheCompact : graphe trop grand pour des numéros sur 32 bits");
+        }
+
+        std::vector<ArcQuantifie> arcs;
+        arcs.reserve(vue.destinations.size());
+        for (size_t s = 0; s < vue.nbSommets(); ++s)
+        {
+            for (size_t a = vue.debut[s]; a < vue.debut[s + 1]; ++a)
+            {
+                ArcQuantifie arc;
+                arc.source = static_cast<uint32_t>(s);
+                arc.destination = vue.destinations[a];
+                arc.duree = static_cast<uint16_t>(quantifierFloat(vue.durees[a], UINT16_MAX));
+                arc.cout = static_cast<uint32_t>(quantifierFloat(vue.couts[a], MAXIMUM_CENTIEMES_FLOAT));
+                arcs.push_back(arc);
+            }
+        }
+
+        noms.resize(vue.nbSommets());
+        for (size_t s = 0; s < vue.nbSommets(); ++s)
+        {
+            noms[s] = graphe.getNomSommet(s);
+            numeros[noms[s]] = static_cast<uint32_t>(s);
+        }
+        construire(vue.nbSommets(), arcs);
+    }
+
+    /**
+     * @brief Charge un réseau directement depuis un fichier texte.
+     * @param fichierEntree Le fichier d'entrée contenant les données du réseau.
+     * @throws std::logic_error Si le fichier n'est pas ouvert, si une ville est inconnue ou si une pondération
+     * n'est pas représentable exactement.
+     */
+    void GrapheCompact::chargerReseau(std::ifstream& fichierEntree)
+    {
+        if (!fichierEntree.is_open())
+            throw std::logic_error("GrapheCompact::chargerReseau: Le fichier n'est pas ouvert !");
+
+        std::string buff;
+        getline(fichierEntree, buff); //Reseau Interurbain: nom
+
+        size_t nbVilles;
+        fichierEntree >> nbVilles;
+        getline(fichierEntree, buff); //villes
+        getline(fichierEntree, buff); //Liste des villes
+
+        noms.clear();
+        numeros.clear();
+        getline(fichierEntree, buff); //Premiere ville
+        while (buff != "Liste des trajets:" && fichierEntree)
+        {
+            numeros[buff] = static_cast<uint32_t>(noms.size());
+            noms.push_back(buff);
+            getline(fichierEntree, buff);
+        }
+        if (noms.size() != nbVilles)
+            throw std::logic_error("GrapheCompact::chargerReseau: nombre de villes incohérent");
+
+        std::vector<ArcQuantifie> arcs;
+        std::string source, destination;
+        while (getline(fichierEntree, source) && getline(fichierEntree, destination) && getline(fichierEntree, buff))
+        {
+            std::istringstream iss(buff);
+            double duree, cout;
+            iss >> duree >> cout;
+
+            ArcQuantifie arc;
+            arc.source = static_cast<uint32_t>(getNumeroSommet(source));
+            arc.destination = static_cast<uint32_t>(getNumeroSommet(destination));
+            arc.duree = static_cast<uint16_t>(quantifier(duree, UINT16_MAX));
+            arc.cout = static_cast<uint32_t>(quantifier(cout, UINT32_MAX));
+            arcs.push_back(arc);
+        }
+        construire(noms.size(), arcs);
+    }
+
+    /**
+     * @brief Construit le CSR par tri comptage des arcs selon leur source (ordre du fichier conservé).
+     * @param nbSommets Le nombre de sommets.
+     * @param arcs Les arcs quantifiés.
+     */
+    void GrapheCompact::construire(size_t nbSommets, const std::vector<ArcQuantifie>& arcs)
+    {
+        debut.assign(nbSommets + 1, 0);
+        for (const auto& arc : arcs)
+            debut[arc.source + 1]++;
+        for (size_t s = 0; s < nbSommets; ++s)
+            debut[s + 1] += debut[s];
+
+        destinations.resize(arcs.size());
+        durees.resize(arcs.size());
+        couts.resize(arcs.size());
+        std::vector<uint32_t> position(debut.begin(), debut.end() - 1);
+        for (const auto& arc : arcs)
+        {
+            uint32_t p = position[arc.source]++;
+            destinations[p] = arc.destination;
+            durees[p] = arc.duree;
+            couts[p] = arc.cout;
+        }
+    }
+
+    /**
+     * @brief Arrondit une pondération au centième le plus proche, en vérifiant qu'il est représentable.
+     * @param valeur La pondération (heures ou dollars).
+     * @param maximum La plus grande valeur représentable, en centièmes.
+     * @return Le nombre de centièmes arrondi.
+     * @throws std::logic_error Si la valeur est négative ou trop grande.
+     */
+    double GrapheCompact::arrondirCentiemes(double valeur, uint64_t maximum)
+    {
+        double arrondi = std::floor(valeur * 100.0 + 0.5);
+        if (!(arrondi >= 0.0) || arrondi > static_cast<double>(maximum))
+        {
+            throw std::logic_error("GrapheCompact : pondération hors de l'intervalle représentable");
+        }
+        return arrondi;
+    }
+
+    /**
+     * @brief Convertit une pondération lue en double depuis un fichier en centièmes, en vérifiant qu'aucune
+     * information n'est perdue.
+     * @param valeur La pondération (heures ou dollars).
+     * @param maximum La plus grande valeur représentable, en centièmes.
+     * @return La pondération en centièmes.
+     * @throws std::logic_error Si la valeur est négative, trop grande, ou a plus de deux décimales.
+     */
+    uint64_t GrapheCompact::quantifier(double valeur, uint64_t maximum)
+    {
+        double arrondi = arrondirCentiemes(valeur, maximum);
+        // Tolérance fixe : l'erreur d'un double lu depuis un nombre à deux décimales reste sous 1e-6 centième
+        // jusqu'à UINT32_MAX centièmes
+        if (std::fabs(valeur * 100.0 - arrondi) > 1e-6)
+        {
+            throw std::logic_error("GrapheCompact : pondération avec plus de deux décimales");
+        }
+        return static_cast<uint64_t>(arrondi);
+    }
+
+    /**
+     * @brief Convertit une pondération float d'un Graphe en centièmes : elle doit être exactement le float
+     * le plus proche d'un nombre à deux décimales.
+     * @param valeur La pondération (heures ou dollars).
+     * @param maximum La plus grande valeur représentable, en centièmes.
+     * @return La pondération en centièmes.
+     * @throws std::logic_error Si la valeur est négative, trop grande, ou n'est pas un nombre à deux décimales.
+     */
+    uint64_t GrapheCompact::quantifierFloat(float valeur, uint64_t maximum)
+    {
+        double arrondi = arrondirCentiemes(valeur, maximum);
+        if (static_cast<float>(arrondi / 100.0) != valeur)
+        {
+            throw std::logic_error("GrapheCompact : pondération avec plus de deux décimales");
+        }
+        return static_cast<uint64_t>(arrondi);
+    }
+
+    /**
+     * @brief Dijkstra en arithmétique entière sur le CSR compact.
+     */
+    void GrapheCompact::dijkstra(size_t origine, size_t destination, bool dureeCout,
+                                 std::vector<uint64_t>& distances, std::vector<uint32_t>& predecesseurs) const
+    {
+        typedef std::pair<uint64_t, uint32_t> Entree;
+        size_t n = getNombreSommets();
+        if (origine >= n || destination >= n)
+        {
+            throw std::logic_error("GrapheCompact::rechercheChemin : sommet hors du graphe");
+        }
+
+        distances.assign(n, UINT64_MAX);
+        predecesseurs.assign(n, AUCUN);
+        std::vector<bool> solutionnes(n, false);
+        std::priority_queue<Entree, std::vector<Entree>, std::greater<Entree> > tas;
+
+        distances[origine] = 0;
+        tas.push(Entree(0, static_cast<uint32_t>(origine)));
+        while (!tas.empty())
+        {
+            uint32_t u = tas.top().second;
+            tas.pop();
+            if (solutionnes[u])
+                continue;
+            solutionnes[u] = true;
+            if (u == destination)
+                break;
+
+            for (uint32_t a = debut[u]; a < debut[u + 1]; ++a)
+            {
+                uint32_t v = destinations[a];
+                uint64_t tmp = distances[u] + (dureeCout ? durees[a] : couts[a]);
+                if (tmp < distances[v])
+                {
+                    distances[v] = tmp;
+                    predecesseurs[v] = u;
+                    tas.push(Entree(tmp, v));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Plus court chemin entre deux sommets.
+     * @param origine Le sommet de départ.
+     * @param destination Le sommet d'arrivée.
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @return Le chemin trouvé; le total est la distance exacte convertie en heures ou en dollars.
+     * @throws std::logic_error Si un sommet est hors du graphe.
+     */
+    Chemin GrapheCompact::rechercheChemin(size_t origine, size_t destination, bool dureeCout) const
+    {
+        std::vector<uint64_t> distances;
+        std::vector<uint32_t> predecesseurs;
+        dijkstra(origine, destination, dureeCout, distances, predecesseurs);
+
+        Chemin cheminTrouve;
+        cheminTrouve.dureeTotale = 0.0;
+        cheminTrouve.coutTotal = 0.0;
+        cheminTrouve.reussi = distances[destination] != UINT64_MAX;
+        if (!cheminTrouve.reussi)
+        {
+            return cheminTrouve;
+        }
+
+        float total = static_cast<float>(distances[destination] / 100.0);
+        if (dureeCout)
+            cheminTrouve.dureeTotale = total;
+        else
+            cheminTrouve.coutTotal = total;
+
+        std::vector<uint32_t> sommets;
+        for (size_t sentinelle = destination; sentinelle != origine; sentinelle = predecesseurs[sentinelle])
+            sommets.push_back(static_cast<uint32_t>(sentinelle));
+        sommets.push_back(static_cast<uint32_t>(origine));
+        for (auto itr = sommets.rbegin(); itr != sommets.rend(); ++itr)
+            cheminTrouve.listeVilles.push_back(noms[*itr]);
+
+        return cheminTrouve;
+    }
+
+    /**
+     * @brief Distance exacte entre deux sommets, en centièmes.
+     * @throws std::logic_error Si un sommet est hors du graphe.
+     */
+    uint64_t GrapheCompact::distanceExacte(size_t origine, size_t destination, bool dureeCout) const
+    {
+        std::vector<uint64_t> distances;
+        std::vector<uint32_t> predecesseurs;
+        dijkstra(origine, destination, dureeCout, distances, predecesseurs);
+        return distances[destination];
+    }
+
+    size_t GrapheCompact::getNombreSommets() const
+    {
+        return debut.size() - 1;
+    }
+
+    size_t GrapheCompact::getNombreArcs() const
+    {
+        return destinations.size();
+    }
+
+    /**
+     * @throws std::logic_error Si le sommet est hors du graphe.
+     */
+    const std::string& GrapheCompact::getNomSommet(size_t sommet) const
+    {
+        if (sommet >= noms.size())
+        {
+            throw std::logic_error("GrapheCompact::getNomSommet : sommet invalide");
+        }
+        return noms[sommet];
+    }
+
+    /**
+     * @throws std::logic_error Si le nom n'existe pas dans le graphe.
+     */
+    size_t GrapheCompact::getNumeroSommet(const std::string& nom) const
+    {
+        auto itr = numeros.find(nom);
+        if (itr == numeros.end())
+        {
+            throw std::logic_error("GrapheCompact::getNumeroSommet : le nom n'existe pas dans le graphe");
+        }
+        return itr->second;
+    }
+
+    size_t GrapheCompact::memoireArcs() const
+    {
+        return debut.size() * sizeof(uint32_t) + destinations.size() * sizeof(uint32_t)
+               + durees.size() * sizeof(uint16_t) + couts.size() * sizeof(uint32_t);
+    }
+
+}//Fin du namespace TP2
@@ -0,0 +1,106 @@
+/**
+ * \file GrapheCompact.h
+ * \brief Représentation compacte d'un réseau pour les très grands graphes.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include "Graphe.h"
+#include "ReseauInterurbain.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifndef _GRAPHECOMPACT__H
+#define _GRAPHECOMPACT__H
+
+namespace TP2
+{
+
+/**
+ * \class GrapheCompact
+ * \brief Graphe en lecture seule stocké en CSR avec des numéros de sommets sur 32 bits et des pondérations
+ * en virgule fixe : la durée en centièmes d'heure sur 16 bits, le coût en cents sur 32 bits (10 octets par arc).
+ *
+ * Les pondérations du format de fichier ont deux décimales : la conversion est donc sans perte, et elle est
+ * vérifiée à la construction (logic_error sinon). Les distances sont des sommes entières exactes; le plus court
+ * chemin trouvé est le même que celui calculé sur les pondérations d'origine en arithmétique exacte.
+ */
+    class GrapheCompact
+    {
+    public:
+
+        static const uint32_t AUCUN = UINT32_MAX;	// Prédécesseur absent / sommet non atteint
+
+        GrapheCompact();
+
+        // Construit la représentation compacte d'un graphe
+        // Exception logic_error si une pondération n'est pas représentable exactement (négative, plus de deux
+        // décimales, durée > 655.35 heures, coût > 131071.99 $ : au-delà, un float ne distingue plus deux cents
+        // voisins) ou si le graphe a plus de 2^32 - 1 sommets ou arcs
+        explicit GrapheCompact(const Graphe& graphe);
+
+        // Charge un réseau directement depuis un fichier (même format que ReseauInterurbain::chargerReseau),
+        // sans construire les listes d'adjacence intermédiaires.
+        // Exception logic_error si le fichier n'est pas ouvert, si une ville est inconnue ou si une pondération
+        // n'est pas représentable exactement (coût jusqu'à 42949672.95 $, les valeurs étant lues en double)
+        void chargerReseau(std::ifstream& fichierEntree);
+
+        // Plus court chemin entre deux sommets (durée si dureeCout = true, coût sinon)
+        // Exception logic_error si origine et/ou destination supérieur au nombre de sommets
+        Chemin rechercheChemin(size_t origine, size_t destination, bool dureeCout) const;
+
+        // Distance exacte en centièmes (d'heure ou de dollar); UINT64_MAX si destination n'est pas atteignable
+        // Exception logic_error si origine et/ou destination supérieur au nombre de sommets
+        uint64_t distanceExacte(size_t origine, size_t destination, bool dureeCout) const;
+
+        size_t getNombreSommets() const;
+        size_t getNombreArcs() const;
+        const std::string& getNomSommet(size_t sommet) const;
+
+        // Exception logic_error si nom n'existe pas dans le graphe
+        size_t getNumeroSommet(const std::string& nom) const;
+
+        // Retourne la mémoire occupée par la structure des arcs (sans les noms), en octets
+        size_t memoireArcs() const;
+
+    private:
+
+        std::vector<std::string> noms;
+        std::unordered_map<std::string, uint32_t> numeros;
+
+        std::vector<uint32_t> debut;			// Arcs du sommet s : [debut[s], debut[s+1])
+        std::vector<uint32_t> destinations;
+        std::vector<uint16_t> durees;			// Centièmes d'heure
+        std::vector<uint32_t> couts;			// Cents
+
+        // Calcule distances et prédécesseurs depuis origine (s'arrête quand destination est solutionnée)
+        void dijkstra(size_t origine, size_t destination, bool dureeCout,
+                      std::vector<uint64_t>& distances, std::vector<uint32_t>& predecesseurs) const;
+
+        // Construit le CSR à partir d'une liste d'arcs (source, destination, durée, coût) déjà quantifiés
+        struct ArcQuantifie
+        {
+            uint32_t source;
+            uint32_t destination;
+            uint16_t duree;
+            uint32_t cout;
+        };
+        void construire(size_t nbSommets, const std::vector<ArcQuantifie>& arcs);
+
+        // Arrondit une pondération en centièmes. Exception logic_error si elle est négative ou dépasse maximum
+        static double arrondirCentiemes(double valeur, uint64_t maximum);
+
+        // Convertit une pondération lue dans un fichier (quantifier) ou stockée dans un Graphe (quantifierFloat)
+        // en centièmes. Exception logic_error si la conversion perd de l'information
+        static uint64_t quantifier(double valeur, uint64_t maximum);
+        static uint64_t quantifierFloat(float valeur, uint64_t maximum);
+    };
+
+}//Fin du namespace
+
+#endif
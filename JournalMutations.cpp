@@ -0,0 +1,392 @@
+/**
+ * \file JournalMutations.cpp
+ * \brief Implémentation du journal des modifications.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include <cstring>
+#include <stdexcept>
+
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "JournalMutations.h"
+
+namespace TP2
+{
+
+    namespace
+    {
+        const char SIGNATURE[4] = {'T', 'P', '2', 'J'};
+        const uint32_t FORMAT = 1;
+        const size_t TAILLE_ENTETE = sizeof(SIGNATURE) + sizeof(uint32_t) + sizeof(uint64_t);
+
+        template <typename T>
+        void ecrire(std::string& tampon, T valeur)
+        {
+            tampon.append(reinterpret_cast<const char*>(&valeur), sizeof(T));
+        }
+
+        template <typename T>
+        bool lire(const std::string& tampon, size_t& position, T& valeur)
+        {
+            if (tampon.size() - position < sizeof(T))
+                return false;
+            std::memcpy(&valeur, tampon.data() + position, sizeof(T));
+            position += sizeof(T);
+            return true;
+        }
+
+        // Force l'écriture sur le disque des données d'un fichier
+        bool synchroniserDisque(std::FILE* fichier)
+        {
+            if (std::fflush(fichier) != 0)
+                return false;
+#if defined(_WIN32)
+            return _commit(_fileno(fichier)) == 0;
+#else
+            return fsync(fileno(fichier)) == 0;
+#endif
+        }
+
+        // Ramène un fichier ouvert à une taille donnée
+        bool tronquerFichier(std::FILE* fichier, size_t taille)
+        {
+#if defined(_WIN32)
+            return _chsize_s(_fileno(fichier), static_cast<__int64>(taille)) == 0;
+#else
+            return ftruncate(fileno(fichier), static_cast<off_t>(taille)) == 0;
+#endif
+        }
+
+        std::string entete(uint64_t generation)
+        {
+            std::string contenu(SIGNATURE, sizeof(SIGNATURE));
+            ecrire(contenu, FORMAT);
+            ecrire(contenu, generation);
+            return contenu;
+        }
+
+        // Décode les données d'un enregistrement. Retourne false si elles sont incohérentes.
+        bool decoder(const std::string& donnees, Mutation& mutation)
+        {
+            size_t position = 0;
+            uint8_t type;
+            if (!lire(donnees, position, type) || !lire(donnees, position, mutation.source))
+                return false;
+            mutation.type = static_cast<TypeMutation>(type);
+            mutation.destination = 0;
+            mutation.duree = mutation.cout = 0;
+            mutation.nom.clear();
+
+            switch (mutation.type)
+            {
+                case TypeMutation::AjoutArc:
+                case TypeMutation::ModificationPonderations:
+                    if (!lire(donnees, position, mutation.destination) || !lire(donnees, position, mutation.duree)
+                        || !lire(donnees, position, mutation.cout))
+                        return false;
+                    break;
+                case TypeMutation::RetraitArc:
+                    if (!lire(donnees, position, mutation.destination))
+                        return false;
+                    break;
+                case TypeMutation::Nommer:
+                {
+                    uint32_t longueur;
+                    if (!lire(donnees, position, longueur) || donnees.size() - position < longueur)
+                        return false;
+                    mutation.nom.assign(donnees, position, longueur);
+                    position += longueur;
+                    break;
+                }
+                default:
+                    return false;
+            }
+            return position == donnees.size();
+        }
+    }
+
+    /**
+     * @brief Ouvre le journal et relit les modifications valides qu'il contient.
+     * @param chemin Le fichier du journal.
+     * @param generation La génération de l'instantané que le journal complète.
+     * @param existantes Reçoit les modifications déjà journalisées.
+     * @param tailleGroupe Le nombre d'octets accumulés avant une écriture.
+     * @throws std::logic_error Si le fichier est illisible, n'est pas un journal ou est d'une génération postérieure.
+     */
+    JournalMutations::JournalMutations(const std::string& chemin, uint64_t generation,
+                                       std::vector<Mutation>& existantes, size_t tailleGroupe) :
+            chemin(chemin), fichier(nullptr), generation(generation), tailleGroupe(tailleGroupe), tailleEcrite(0)
+    {
+        existantes.clear();
+        std::string contenu;
+        if (!lireFichier(chemin, contenu))
+        {
+            creer();
+            return;
+        }
+
+        size_t position = sizeof(SIGNATURE);
+        uint32_t format;
+        uint64_t generationFichier;
+        if (contenu.compare(0, sizeof(SIGNATURE), SIGNATURE, sizeof(SIGNATURE)) != 0
+            || !lire(contenu, position, format) || format != FORMAT || !lire(contenu, position, generationFichier))
+        {
+            throw std::logic_error("JournalMutations : " + chemin + " n'est pas un journal valide");
+        }
+        if (generationFichier > generation)
+        {
+            throw std::logic_error("JournalMutations : le journal est plus récent que l'instantané");
+        }
+        if (generationFichier < generation)
+        {
+            creer();	// Déjà intégré à l'instantané par une compaction interrompue avant de vider le journal
+            return;
+        }
+
+        // Relire jusqu'au premier enregistrement incomplet ou corrompu
+        size_t valide = position;
+        while (true)
+        {
+            uint32_t taille, somme;
+            if (!lire(contenu, position, taille) || contenu.size() - position < taille)
+                break;
+            std::string donnees(contenu, position, taille);
+            position += taille;
+            Mutation mutation;
+            if (!lire(contenu, position, somme) || somme != sommeControle(donnees.data(), donnees.size())
+                || !decoder(donnees, mutation))
+                break;
+            existantes.push_back(mutation);
+            valide = position;
+        }
+
+        if (valide < contenu.size())
+        {
+            contenu.resize(valide);
+            ecrireFichierAtomique(chemin, contenu);
+        }
+        fichier = std::fopen(chemin.c_str(), "ab");
+        if (!fichier)
+        {
+            throw std::logic_error("JournalMutations : impossible d'ouvrir " + chemin);
+        }
+        tailleEcrite = valide;
+    }
+
+    JournalMutations::~JournalMutations()
+    {
+        try
+        {
+            synchroniser();
+        }
+        catch (...)
+        {
+            // Un destructeur ne doit pas lancer d'exception; le groupe en attente est perdu
+        }
+        if (fichier)
+            std::fclose(fichier);
+    }
+
+    /**
+     * @brief Ajoute une modification au groupe courant.
+     * @param mutation La modification.
+     * @throws std::logic_error Si le groupe est plein et que son écriture échoue.
+     */
+    void JournalMutations::ajouter(const Mutation& mutation)
+    {
+        std::string donnees;
+        ecrire(donnees, static_cast<uint8_t>(mutation.type));
+        ecrire(donnees, mutation.source);
+        switch (mutation.type)
+        {
+            case TypeMutation::AjoutArc:
+            case TypeMutation::ModificationPonderations:
+                ecrire(donnees, mutation.destination);
+                ecrire(donnees, mutation.duree);
+                ecrire(donnees, mutation.cout);
+                break;
+            case TypeMutation::RetraitArc:
+                ecrire(donnees, mutation.destination);
+                break;
+            case TypeMutation::Nommer:
+                ecrire(donnees, static_cast<uint32_t>(mutation.nom.size()));
+                donnees += mutation.nom;
+                break;
+        }
+
+        ecrire(groupe, static_cast<uint32_t>(donnees.size()));
+        groupe += donnees;
+        ecrire(groupe, sommeControle(donnees.data(), donnees.size()));
+
+        if (groupe.size() >= tailleGroupe)
+        {
+            synchroniser();
+        }
+    }
+
+    /**
+     * @brief Écrit le groupe courant puis force l'écriture sur le disque.
+     * @throws std::logic_error Si le fichier n'est pas ouvert (réinitialisation échouée) ou si l'écriture échoue.
+     */
+    void JournalMutations::synchroniser()
+    {
+        if (!fichier)
+        {
+            throw std::logic_error("JournalMutations : " + chemin + " n'est pas ouvert");
+        }
+        ecrireGroupe();
+        if (!synchroniserDisque(fichier))
+        {
+            throw std::logic_error("JournalMutations : échec de la synchronisation de " + chemin);
+        }
+    }
+
+    /**
+     * @brief Vide le journal pour une nouvelle génération d'instantané.
+     * @param generation La génération de l'instantané qui intègre les modifications journalisées.
+     * @throws std::logic_error Si le nouveau journal ne peut pas être créé; le journal reste alors fermé et
+     * toute écriture ultérieure lance aussi une exception.
+     */
+    void JournalMutations::reinitialiser(uint64_t generation)
+    {
+        groupe.clear();
+        if (fichier)
+            std::fclose(fichier);
+        fichier = nullptr;
+        this->generation = generation;
+        creer();
+    }
+
+    uint64_t JournalMutations::getGeneration() const
+    {
+        return generation;
+    }
+
+    size_t JournalMutations::getTaille() const
+    {
+        return tailleEcrite + groupe.size();
+    }
+
+    void JournalMutations::creer()
+    {
+        std::string contenu = entete(generation);
+        ecrireFichierAtomique(chemin, contenu);
+        fichier = std::fopen(chemin.c_str(), "ab");
+        if (!fichier)
+        {
+            throw std::logic_error("JournalMutations : impossible d'ouvrir " + chemin);
+        }
+        tailleEcrite = contenu.size();
+    }
+
+    void JournalMutations::ecrireGroupe()
+    {
+        if (groupe.empty())
+            return;
+        if (!fichier)
+        {
+            throw std::logic_error("JournalMutations : " + chemin + " n'est pas ouvert");
+        }
+        if (std::fwrite(groupe.data(), 1, groupe.size(), fichier) != groupe.size() || std::fflush(fichier) != 0)
+        {
+            // Retirer le groupe écrit en partie (le tampon de stdio compris, en rouvrant le fichier) pour qu'une
+            // nouvelle tentative suive le dernier enregistrement complet; sinon le journal reste fermé
+            std::fclose(fichier);
+            fichier = std::fopen(chemin.c_str(), "ab");
+            if (fichier && !tronquerFichier(fichier, tailleEcrite))
+            {
+                std::fclose(fichier);
+                fichier = nullptr;
+            }
+            throw std::logic_error("JournalMutations : échec de l'écriture dans " + chemin);
+        }
+        tailleEcrite += groupe.size();
+        groupe.clear();
+    }
+
+    /**
+     * @brief Remplace un fichier de façon atomique (un arrêt brutal laisse l'ancien ou le nouveau contenu).
+     * @param chemin Le fichier à écrire.
+     * @param contenu Le nouveau contenu.
+     * @throws std::logic_error Si l'écriture ou le renommage échoue.
+     */
+    void JournalMutations::ecrireFichierAtomique(const std::string& chemin, const std::string& contenu)
+    {
+        std::string temporaire = chemin + ".tmp";
+        std::FILE* fichier = std::fopen(temporaire.c_str(), "wb");
+        if (!fichier)
+        {
+            throw std::logic_error("ecrireFichierAtomique : impossible de créer " + temporaire);
+        }
+        bool ecrit = std::fwrite(contenu.data(), 1, contenu.size(), fichier) == contenu.size()
+                     && synchroniserDisque(fichier);
+        std::fclose(fichier);
+        if (!ecrit)
+        {
+            std::remove(temporaire.c_str());
+            throw std::logic_error("ecrireFichierAtomique : échec de l'écriture de " + temporaire);
+        }
+
+#if defined(_WIN32)
+        std::remove(chemin.c_str());	// rename n'écrase pas un fichier existant sous Windows
+#endif
+        if (std::rename(temporaire.c_str(), chemin.c_str()) != 0)
+        {
+            throw std::logic_error("ecrireFichierAtomique : impossible de renommer " + temporaire);
+        }
+
+#if !defined(_WIN32)
+        // Rendre le renommage lui-même durable
+        size_t separateur = chemin.find_last_of('/');
+        std::string dossier = separateur == std::string::npos ? "." : chemin.substr(0, separateur + 1);
+        int descripteur = open(dossier.c_str(), O_RDONLY);
+        if (descripteur >= 0)
+        {
+            fsync(descripteur);
+            close(descripteur);
+        }
+#endif
+    }
+
+    /**
+     * @brief Lit un fichier binaire en entier.
+     * @param chemin Le fichier.
+     * @param contenu Reçoit le contenu.
+     * @return false si le fichier ne peut pas être ouvert.
+     */
+    bool JournalMutations::lireFichier(const std::string& chemin, std::string& contenu)
+    {
+        std::FILE* fichier = std::fopen(chemin.c_str(), "rb");
+        if (!fichier)
+            return false;
+        contenu.clear();
+        char tampon[65536];
+        size_t lus;
+        while ((lus = std::fread(tampon, 1, sizeof(tampon), fichier)) > 0)
+            contenu.append(tampon, lus);
+        std::fclose(fichier);
+        return true;
+    }
+
+    uint32_t JournalMutations::sommeControle(const char* donnees, size_t taille)
+    {
+        uint32_t somme = 2166136261u;
+        for (size_t i = 0; i < taille; ++i)
+        {
+            somme ^= static_cast<unsigned char>(donnees[i]);
+            somme *= 16777619u;
+        }
+        return somme;
+    }
+
+}//Fin du namespace TP2
@@ -0,0 +1,122 @@
+/**
+ * \file JournalMutations.h
+ * \brief Journal binaire des modifications d'un réseau, en ajout seul.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#ifndef _JOURNALMUTATIONS__H
+#define _JOURNALMUTATIONS__H
+
+namespace TP2
+{
+
+    // Type d'une modification enregistrée dans le journal
+    enum class TypeMutation : uint8_t
+    {
+        AjoutArc = 1,
+        RetraitArc = 2,
+        Nommer = 3,
+        ModificationPonderations = 4
+    };
+
+    // Une modification du réseau. Les villes sont désignées par leur numéro (ordre du fichier), qui ne dépend
+    // ni des noms ni de la renumérotation interne.
+    struct Mutation
+    {
+        TypeMutation type;
+        uint32_t source;		// Ville nommée pour TypeMutation::Nommer
+        uint32_t destination;
+        float duree;
+        float cout;
+        std::string nom;		// TypeMutation::Nommer seulement
+    };
+
+/**
+ * \class JournalMutations
+ * \brief Fichier en ajout seul des modifications appliquées à un réseau depuis son dernier instantané
+ *
+ * Le fichier commence par un en-tête (signature, génération) suivi d'enregistrements
+ * [taille][type][données][somme de contrôle FNV-1a]. Les enregistrements sont accumulés en mémoire et écrits
+ * par groupes (group commit) : une seule écriture et une seule synchronisation disque pour tout un groupe.
+ * À l'ouverture, les enregistrements valides sont relus; une fin tronquée ou corrompue (arrêt brutal pendant
+ * une écriture) est retirée du fichier.
+ *
+ * La génération relie le journal à l'instantané qu'il complète : après une compaction, l'instantané passe à la
+ * génération g + 1 avant que le journal ne soit vidé, si bien qu'un journal de génération g déjà intégré est
+ * reconnu et ignoré au redémarrage.
+ */
+    class JournalMutations
+    {
+    public:
+
+        // Ouvre le journal chemin (créé s'il n'existe pas) qui complète l'instantané de la génération donnée.
+        // existantes reçoit les modifications valides déjà présentes. Un journal d'une génération antérieure est
+        // vidé. tailleGroupe : nombre d'octets accumulés avant une écriture automatique.
+        // Exception logic_error si le fichier ne peut pas être ouvert, n'est pas un journal, ou appartient à une
+        // génération postérieure à celle de l'instantané
+        JournalMutations(const std::string& chemin, uint64_t generation, std::vector<Mutation>& existantes,
+                         size_t tailleGroupe = 65536);
+
+        // Écrit et synchronise les modifications en attente
+        ~JournalMutations();
+
+        JournalMutations(const JournalMutations&) = delete;
+        JournalMutations& operator=(const JournalMutations&) = delete;
+
+        // Ajoute une modification au groupe courant; le groupe est écrit quand il atteint tailleGroupe octets
+        void ajouter(const Mutation& mutation);
+
+        // Écrit le groupe courant et force son écriture sur le disque
+        // Exception logic_error si l'écriture échoue ou si le fichier n'est pas ouvert (reinitialiser a échoué).
+        // Après un échec d'écriture, le fichier est ramené au dernier enregistrement complet et le groupe est
+        // conservé pour une nouvelle tentative; si le fichier ne peut pas être ramené, le journal reste fermé
+        void synchroniser();
+
+        // Vide le journal et le rattache à une nouvelle génération d'instantané (après une compaction)
+        // Exception logic_error si le fichier ne peut pas être réécrit (le journal reste alors fermé)
+        void reinitialiser(uint64_t generation);
+
+        uint64_t getGeneration() const;
+
+        // Taille du journal en octets, groupe en attente compris
+        size_t getTaille() const;
+
+        // Écrit contenu dans chemin de façon atomique : fichier temporaire synchronisé, puis renommage
+        // Exception logic_error si l'écriture ou le renommage échoue
+        static void ecrireFichierAtomique(const std::string& chemin, const std::string& contenu);
+
+        // Lit tout le fichier chemin dans contenu. Retourne false si le fichier n'existe pas.
+        static bool lireFichier(const std::string& chemin, std::string& contenu);
+
+        // Somme de contrôle FNV-1a sur 32 bits
+        static uint32_t sommeControle(const char* donnees, size_t taille);
+
+    private:
+
+        std::string chemin;
+        std::FILE* fichier;
+        uint64_t generation;
+        size_t tailleGroupe;
+        std::string groupe;			// Enregistrements pas encore écrits
+        size_t tailleEcrite;		// Octets déjà dans le fichier
+
+        // Crée (ou écrase) le fichier avec un en-tête et aucun enregistrement, puis l'ouvre en ajout
+        void creer();
+
+        // Écrit le groupe courant (sans synchronisation disque). En cas d'échec, le fichier est tronqué à
+        // tailleEcrite ou fermé
+        void ecrireGroupe();
+    };
+
+}//Fin du namespace
+
+#endif
@@ -0,0 +1,245 @@
+/**
+ * \file Parallelisme.h
+ * \brief Outils pour répartir un calcul sur plusieurs threads.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifndef _PARALLELISME__H
+#define _PARALLELISME__H
+
+namespace TP2
+{
+
+    // Retourne le nombre de threads à utiliser quand l'appelant n'en précise pas (0)
+    inline unsigned int nombreThreads(unsigned int demande = 0)
+    {
+        if (demande != 0)
+            return demande;
+        unsigned int materiel = std::thread::hardware_concurrency();
+        return materiel == 0 ? 1 : materiel;
+    }
+
+    // Exécute tache(indice, numeroThread) pour chaque indice de [0, nbTaches) sur nbThreads threads.
+    // Les indices sont distribués dynamiquement; numeroThread (dans [0, nbThreads)) permet à la tâche
+    // d'utiliser un espace de travail propre à son thread.
+    // La première exception lancée par une tâche est relancée dans le thread appelant.
+    template <typename Tache>
+    void executerEnParallele(size_t nbTaches, Tache tache, unsigned int nbThreads = 0)
+    {
+        nbThreads = nombreThreads(nbThreads);
+        if (nbThreads > nbTaches)
+            nbThreads = static_cast<unsigned int>(nbTaches);
+
+        if (nbThreads <= 1)
+        {
+            for (size_t i = 0; i < nbTaches; ++i)
+                tache(i, 0u);
+            return;
+        }
+
+        std::atomic<size_t> prochain(0);
+        std::exception_ptr erreur;
+        std::mutex verrouErreur;
+
+        auto travailleur = [&](unsigned int numero)
+        {
+            try
+            {
+                for (size_t i = prochain++; i < nbTaches; i = prochain++)
+                    tache(i, numero);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> verrou(verrouErreur);
+                if (!erreur)
+                    erreur = std::current_exception();
+                prochain = nbTaches;
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (unsigned int t = 1; t < nbThreads; ++t)
+            threads.emplace_back(travailleur, t);
+        travailleur(0);
+        for (auto& thread : threads)
+            thread.join();
+
+        if (erreur)
+            std::rethrow_exception(erreur);
+    }
+
+/**
+ * \class PoolTravail
+ * \brief Threads permanents avec vol de travail, pour les calculs découpés en nombreuses phases parallèles
+ *
+ * Chaque appel à executer découpe [0, nbTaches) en paquets répartis entre les files des threads. Un thread
+ * traite d'abord sa propre file (par la fin), puis vole des paquets au début des files des autres threads.
+ * Le thread appelant participe au travail comme thread 0.
+ */
+    class PoolTravail
+    {
+    public:
+
+        // Crée nbThreads - 1 threads permanents (0 = tous les coeurs)
+        explicit PoolTravail(unsigned int nbThreads = 0) : generation(0), restants(0), arret(false)
+        {
+            unsigned int total = nombreThreads(nbThreads);
+            for (unsigned int t = 0; t < total; ++t)
+                files.push_back(std::unique_ptr<File>(new File()));
+            for (unsigned int t = 1; t < total; ++t)
+                threads.emplace_back(&PoolTravail::boucle, this, t);
+        }
+
+        ~PoolTravail()
+        {
+            {
+                std::lock_guard<std::mutex> verrouPool(verrou);
+                arret = true;
+            }
+            reveil.notify_all();
+            for (auto& thread : threads)
+                thread.join();
+        }
+
+        PoolTravail(const PoolTravail&) = delete;
+        PoolTravail& operator=(const PoolTravail&) = delete;
+
+        unsigned int getNombreThreads() const { return static_cast<unsigned int>(files.size()); }
+
+        // Exécute tache(debut, fin, numeroThread) sur chaque paquet [debut, fin) de [0, nbTaches) et attend la fin.
+        // La première exception lancée par une tâche est relancée dans le thread appelant.
+        void executer(size_t nbTaches, size_t taillePaquet,
+                      const std::function<void(size_t, size_t, unsigned int)>& tache)
+        {
+            if (nbTaches == 0)
+                return;
+            if (taillePaquet == 0)
+                taillePaquet = 1;
+
+            size_t nbPaquets = (nbTaches + taillePaquet - 1) / taillePaquet;
+            {
+                std::lock_guard<std::mutex> verrouPool(verrou);
+                travail = tache;
+                erreur = nullptr;
+                restants = nbPaquets;
+                for (size_t p = 0; p < nbPaquets; ++p)
+                {
+                    File& file = *files[p % files.size()];
+                    std::lock_guard<std::mutex> verrouFile(file.verrou);
+                    file.paquets.push_back(std::make_pair(p * taillePaquet, std::min(nbTaches, (p + 1) * taillePaquet)));
+                }
+                generation++;
+            }
+            reveil.notify_all();
+
+            travailler(0);
+
+            std::unique_lock<std::mutex> verrouPool(verrou);
+            fini.wait(verrouPool, [this] { return restants == 0; });
+            if (erreur)
+                std::rethrow_exception(erreur);
+        }
+
+    private:
+
+        struct File
+        {
+            std::mutex verrou;
+            std::deque<std::pair<size_t, size_t> > paquets;
+        };
+
+        std::vector<std::unique_ptr<File> > files;	// Une file de paquets par thread
+        std::vector<std::thread> threads;
+
+        std::mutex verrou;					// Protège les champs ci-dessous
+        std::condition_variable reveil;		// Signale une nouvelle génération de travail (ou l'arrêt)
+        std::condition_variable fini;		// Signale que tous les paquets sont traités
+        std::function<void(size_t, size_t, unsigned int)> travail;
+        std::exception_ptr erreur;
+        unsigned long generation;
+        size_t restants;					// Paquets pas encore terminés
+        bool arret;
+
+        void boucle(unsigned int numero)
+        {
+            unsigned long vue = 0;
+            std::unique_lock<std::mutex> verrouPool(verrou);
+            while (true)
+            {
+                reveil.wait(verrouPool, [&] { return arret || generation != vue; });
+                if (arret)
+                    return;
+                vue = generation;
+                verrouPool.unlock();
+                travailler(numero);
+                verrouPool.lock();
+            }
+        }
+
+        // Traite des paquets (les siens, puis ceux des autres) jusqu'à ce qu'il n'en reste plus
+        void travailler(unsigned int numero)
+        {
+            std::pair<size_t, size_t> paquet;
+            while (prendre(numero, paquet))
+            {
+                try
+                {
+                    travail(paquet.first, paquet.second, numero);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> verrouPool(verrou);
+                    if (!erreur)
+                        erreur = std::current_exception();
+                }
+
+                std::lock_guard<std::mutex> verrouPool(verrou);
+                if (--restants == 0)
+                    fini.notify_all();
+            }
+        }
+
+        bool prendre(unsigned int numero, std::pair<size_t, size_t>& paquet)
+        {
+            for (size_t k = 0; k < files.size(); ++k)
+            {
+                File& file = *files[(numero + k) % files.size()];
+                std::lock_guard<std::mutex> verrouFile(file.verrou);
+                if (file.paquets.empty())
+                    continue;
+                if (k == 0)
+                {
+                    paquet = file.paquets.back();	// Sa propre file : le plus récent
+                    file.paquets.pop_back();
+                }
+                else
+                {
+                    paquet = file.paquets.front();	// Vol : le plus ancien
+                    file.paquets.pop_front();
+                }
+                return true;
+            }
+            return false;
+        }
+    };
+
+}//Fin du namespace
+
+#endif
@@ -0,0 +1,669 @@
+/**
+ * \file PlanificateurCellules.cpp
+ * \brief Implémentation de la planification personnalisable (CRP).
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+#include "PlanificateurCellules.h"
+
+namespace TP2
+{
+
+    namespace
+    {
+        const float INFINI = std::numeric_limits<float>::infinity();
+        const uint32_t AUCUNE = UINT32_MAX;
+
+        // Tailles de cellules par défaut des niveaux successifs
+        const size_t TAILLES_DEFAUT[] = {128, 2048, 32768};
+    }
+
+    struct PlanificateurCellules::Espace
+    {
+        std::vector<float> distances;
+        std::vector<uint32_t> parents;
+        std::vector<uint8_t> niveauxParents;	// Niveau de l'arc par lequel le sommet a été atteint
+        std::vector<uint8_t> solutionne;
+        std::vector<uint8_t> cible;
+        std::vector<uint32_t> touches;
+        std::vector<std::pair<float, uint32_t> > tas;
+
+        void preparer(size_t n)
+        {
+            if (distances.size() != n)
+            {
+                distances.assign(n, INFINI);
+                parents.assign(n, AUCUNE);
+                niveauxParents.assign(n, 0);
+                solutionne.assign(n, 0);
+                cible.assign(n, 0);
+                touches.clear();
+                tas.clear();
+            }
+        }
+
+        void toucher(uint32_t v)
+        {
+            if (distances[v] == INFINI && !cible[v])
+                touches.push_back(v);
+        }
+
+        void pousser(float distance, uint32_t v)
+        {
+            tas.push_back(std::make_pair(distance, v));
+            std::push_heap(tas.begin(), tas.end(), std::greater<std::pair<float, uint32_t> >());
+        }
+
+        std::pair<float, uint32_t> extraire()
+        {
+            std::pop_heap(tas.begin(), tas.end(), std::greater<std::pair<float, uint32_t> >());
+            std::pair<float, uint32_t> element = tas.back();
+            tas.pop_back();
+            return element;
+        }
+
+        void effacer()
+        {
+            for (auto v : touches)
+            {
+                distances[v] = INFINI;
+                parents[v] = AUCUNE;
+                niveauxParents[v] = 0;
+                solutionne[v] = 0;
+                cible[v] = 0;
+            }
+            touches.clear();
+            tas.clear();
+        }
+    };
+
+    /**
+     * @brief Constructeur : partition multiniveau de la topologie, puis entrées et sorties des cellules.
+     * @param vue La vue d'adjacence du graphe.
+     * @param inverse La vue d'adjacence du graphe inverse.
+     * @param taillesCellules La taille maximale des cellules de chaque niveau (vide : valeurs par défaut).
+     * @param nbThreads Le nombre de threads de la personnalisation (0 = tous les coeurs).
+     */
+    PlanificateurCellules::PlanificateurCellules(std::shared_ptr<const VueAdjacence> vue,
+                                                 std::shared_ptr<const VueAdjacence> inverse,
+                                                 const std::vector<size_t>& taillesCellules, unsigned int nbThreads) :
+            vue(vue), inverse(inverse), pool(nbThreads)
+    {
+        const size_t n = vue->nbSommets();
+        std::vector<size_t> tailles = taillesCellules;
+        if (tailles.empty())
+            tailles.assign(std::begin(TAILLES_DEFAUT), std::end(TAILLES_DEFAUT));
+
+        // Graphe non orienté sous-jacent, dont les éléments sont d'abord les sommets
+        std::vector<size_t> debut(n + 1, 0);
+        std::vector<uint32_t> voisins;
+        voisins.reserve(vue->destinations.size() + inverse->destinations.size());
+        for (size_t v = 0; v < n; ++v)
+        {
+            voisins.insert(voisins.end(), vue->destinations.begin() + vue->debut[v],
+                           vue->destinations.begin() + vue->debut[v + 1]);
+            voisins.insert(voisins.end(), inverse->destinations.begin() + inverse->debut[v],
+                           inverse->destinations.begin() + inverse->debut[v + 1]);
+            debut[v + 1] = voisins.size();
+        }
+        std::vector<size_t> taille(n, 1);
+        std::vector<uint32_t> element(n);	// Élément du graphe courant qui contient chaque sommet
+        for (size_t v = 0; v < n; ++v)
+            element[v] = static_cast<uint32_t>(v);
+
+        for (auto limite : tailles)
+        {
+            std::vector<uint32_t> region;
+            size_t nbRegions = regrouper(debut, voisins, taille, limite, region);
+            if (nbRegions <= 1)
+                break;
+            if (nbRegions == taille.size() && !niveaux.empty())
+                continue;	// Aucun regroupement : le niveau serait identique au précédent
+
+            Niveau niveau;
+            niveau.nbCellules = nbRegions;
+            niveau.cellule.resize(n);
+            for (size_t v = 0; v < n; ++v)
+            {
+                element[v] = region[element[v]];
+                niveau.cellule[v] = element[v];
+            }
+            niveaux.push_back(std::move(niveau));
+
+            // Graphe des régions pour le niveau suivant
+            std::vector<std::vector<uint32_t> > adjacence(nbRegions);
+            std::vector<size_t> tailleRegions(nbRegions, 0);
+            for (size_t e = 0; e < taille.size(); ++e)
+            {
+                tailleRegions[region[e]] += taille[e];
+                for (size_t i = debut[e]; i < debut[e + 1]; ++i)
+                {
+                    if (region[voisins[i]] != region[e])
+                        adjacence[region[e]].push_back(region[voisins[i]]);
+                }
+            }
+            debut.assign(nbRegions + 1, 0);
+            voisins.clear();
+            for (size_t r = 0; r < nbRegions; ++r)
+            {
+                std::sort(adjacence[r].begin(), adjacence[r].end());
+                adjacence[r].erase(std::unique(adjacence[r].begin(), adjacence[r].end()), adjacence[r].end());
+                voisins.insert(voisins.end(), adjacence[r].begin(), adjacence[r].end());
+                debut[r + 1] = voisins.size();
+            }
+            taille.swap(tailleRegions);
+        }
+
+        // Entrées et sorties des cellules de chaque niveau
+        for (auto& niveau : niveaux)
+        {
+            std::vector<uint8_t> estEntree(n, 0), estSortie(n, 0);
+            for (size_t u = 0; u < n; ++u)
+            {
+                for (size_t a = vue->debut[u]; a < vue->debut[u + 1]; ++a)
+                {
+                    unsigned int v = vue->destinations[a];
+                    if (niveau.cellule[u] != niveau.cellule[v])
+                    {
+                        estSortie[u] = 1;
+                        estEntree[v] = 1;
+                    }
+                }
+            }
+
+            for (auto liste : {std::make_pair(&estEntree, std::make_pair(&niveau.debutEntrees, &niveau.entrees)),
+                               std::make_pair(&estSortie, std::make_pair(&niveau.debutSorties, &niveau.sorties))})
+            {
+                const std::vector<uint8_t>& marque = *liste.first;
+                std::vector<size_t>& debutListe = *liste.second.first;
+                std::vector<uint32_t>& sommets = *liste.second.second;
+                debutListe.assign(niveau.nbCellules + 1, 0);
+                for (size_t v = 0; v < n; ++v)
+                {
+                    if (marque[v])
+                        debutListe[niveau.cellule[v] + 1]++;
+                }
+                for (size_t c = 0; c < niveau.nbCellules; ++c)
+                    debutListe[c + 1] += debutListe[c];
+                sommets.resize(debutListe.back());
+                std::vector<size_t> position(debutListe.begin(), debutListe.end() - 1);
+                for (size_t v = 0; v < n; ++v)
+                {
+                    if (marque[v])
+                        sommets[position[niveau.cellule[v]]++] = static_cast<uint32_t>(v);
+                }
+            }
+
+            niveau.positionEntree.assign(n, AUCUNE);
+            niveau.positionSortie.assign(n, AUCUNE);
+            niveau.debutClique.assign(niveau.nbCellules + 1, 0);
+            for (size_t c = 0; c < niveau.nbCellules; ++c)
+            {
+                for (size_t i = niveau.debutEntrees[c]; i < niveau.debutEntrees[c + 1]; ++i)
+                    niveau.positionEntree[niveau.entrees[i]] = static_cast<uint32_t>(i - niveau.debutEntrees[c]);
+                for (size_t j = niveau.debutSorties[c]; j < niveau.debutSorties[c + 1]; ++j)
+                    niveau.positionSortie[niveau.sorties[j]] = static_cast<uint32_t>(j - niveau.debutSorties[c]);
+                niveau.debutClique[c + 1] = niveau.debutClique[c]
+                                            + (niveau.debutEntrees[c + 1] - niveau.debutEntrees[c])
+                                              * (niveau.debutSorties[c + 1] - niveau.debutSorties[c]);
+            }
+        }
+
+        for (unsigned int t = 0; t < pool.getNombreThreads(); ++t)
+            espaces.push_back(std::unique_ptr<Espace>(new Espace()));
+    }
+
+    PlanificateurCellules::~PlanificateurCellules()
+    {
+    }
+
+    /**
+     * @brief Personnalisation : calcule les cliques de toutes les cellules pour une métrique.
+     * Les niveaux sont traités du plus fin au plus grossier (chaque niveau se sert des cliques du précédent);
+     * les cellules d'un même niveau sont indépendantes et réparties entre les threads.
+     * @param ponderations La vue dont les pondérations sont utilisées.
+     * @param ponderationsInverse La vue inverse correspondante.
+     * @param coefDuree Le coefficient de la durée.
+     * @param coefCout Le coefficient du coût.
+     * @return La métrique personnalisée.
+     * @throws std::logic_error Si la topologie diffère de celle de la partition ou si une pondération est négative.
+     */
+    std::shared_ptr<const MetriqueCellules> PlanificateurCellules::personnaliser(const VueAdjacence& ponderations,
+                                                                                 const VueAdjacence& ponderationsInverse,
+                                                                                 float coefDuree, float coefCout)
+    {
+        if (ponderations.debut != vue->debut || ponderations.destinations != vue->destinations
+            || ponderationsInverse.debut != inverse->debut || ponderationsInverse.destinations != inverse->destinations)
+        {
+            throw std::logic_error("PlanificateurCellules::personnaliser : la topologie a changé");
+        }
+
+        auto metrique = std::make_shared<MetriqueCellules>();
+        metrique->coefDuree = coefDuree;
+        metrique->coefCout = coefCout;
+        for (auto cible : {std::make_pair(&ponderations, &metrique->poids),
+                           std::make_pair(&ponderationsInverse, &metrique->poidsInverse)})
+        {
+            const VueAdjacence& source = *cible.first;
+            std::vector<float>& poids = *cible.second;
+            poids.resize(source.destinations.size());
+            for (size_t a = 0; a < poids.size(); ++a)
+            {
+                poids[a] = coefDuree * source.durees[a] + coefCout * source.couts[a];
+                if (!(poids[a] >= 0))
+                    throw std::logic_error("PlanificateurCellules::personnaliser : pondération négative");
+            }
+        }
+
+        const size_t n = vue->nbSommets();
+        metrique->cliques.resize(niveaux.size());
+        for (size_t k = 1; k <= niveaux.size(); ++k)
+        {
+            const Niveau& niveau = niveaux[k - 1];
+            std::vector<float>& cliques = metrique->cliques[k - 1];
+            cliques.assign(niveau.debutClique.back(), INFINI);
+            pool.executer(niveau.nbCellules, 1, [&](size_t debut, size_t fin, unsigned int numero)
+            {
+                Espace& espace = *espaces[numero];
+                espace.preparer(n);
+                for (size_t c = debut; c < fin; ++c)
+                {
+                    std::vector<uint32_t> cibles(niveau.sorties.begin() + niveau.debutSorties[c],
+                                                 niveau.sorties.begin() + niveau.debutSorties[c + 1]);
+                    float* ligne = cliques.data() + niveau.debutClique[c];
+                    for (size_t i = niveau.debutEntrees[c]; i < niveau.debutEntrees[c + 1]; ++i)
+                    {
+                        rechercherDansCellule(*metrique, k, static_cast<uint32_t>(c), niveau.entrees[i], cibles,
+                                              espace);
+                        for (auto sortie : cibles)
+                            *ligne++ = espace.distances[sortie];
+                        espace.effacer();
+                    }
+                }
+            });
+        }
+        return metrique;
+    }
+
+    /**
+     * @brief Distance entre deux sommets par recherche bidirectionnelle sur la surcouche.
+     * @return La distance, +infini si aucun chemin n'existe.
+     */
+    float PlanificateurCellules::distance(const MetriqueCellules& metrique, unsigned int source,
+                                          unsigned int destination) const
+    {
+        static thread_local Espace avant, arriere;
+        float total;
+        rechercher(metrique, source, destination, avant, arriere, total);
+        avant.effacer();
+        arriere.effacer();
+        return total;
+    }
+
+    /**
+     * @brief Plus court chemin entre deux sommets : recherche sur la surcouche, puis dépliage des cliques.
+     * @param metrique La métrique personnalisée.
+     * @param source Le sommet de départ.
+     * @param destination Le sommet d'arrivée.
+     * @param sommets Reçoit les sommets du chemin.
+     * @param total Reçoit la longueur du chemin.
+     * @return false si aucun chemin n'existe.
+     */
+    bool PlanificateurCellules::chemin(const MetriqueCellules& metrique, unsigned int source, unsigned int destination,
+                                       std::vector<unsigned int>& sommets, float& total) const
+    {
+        static thread_local Espace avant, arriere;
+        sommets.clear();
+        uint32_t milieu = rechercher(metrique, source, destination, avant, arriere, total);
+        if (milieu == AUCUNE)
+        {
+            avant.effacer();
+            arriere.effacer();
+            return false;
+        }
+
+        // Arcs de la surcouche (sommet atteint, niveau de l'arc), de la source au milieu puis du milieu à la destination
+        std::vector<std::pair<uint32_t, uint8_t> > debutChemin, finChemin;
+        for (uint32_t v = milieu; v != source; v = avant.parents[v])
+            debutChemin.push_back(std::make_pair(v, avant.niveauxParents[v]));
+        std::reverse(debutChemin.begin(), debutChemin.end());
+        for (uint32_t v = milieu; v != destination; v = arriere.parents[v])
+            finChemin.push_back(std::make_pair(arriere.parents[v], arriere.niveauxParents[v]));
+        avant.effacer();
+        arriere.effacer();
+
+        sommets.push_back(source);
+        for (auto liste : {&debutChemin, &finChemin})
+        {
+            for (const auto& arc : *liste)
+            {
+                if (arc.second == 0)
+                    sommets.push_back(arc.first);
+                else
+                    deplier(metrique, arc.second, sommets.back(), arc.first, sommets);
+            }
+        }
+        return true;
+    }
+
+    size_t PlanificateurCellules::getNombreNiveaux() const
+    {
+        return niveaux.size();
+    }
+
+    /**
+     * @brief Retourne le nombre de cellules d'un niveau.
+     * @throws std::logic_error Si le niveau est invalide.
+     */
+    size_t PlanificateurCellules::getNombreCellules(size_t niveau) const
+    {
+        if (niveau == 0 || niveau > niveaux.size())
+        {
+            throw std::logic_error("PlanificateurCellules::getNombreCellules : niveau invalide");
+        }
+        return niveaux[niveau - 1].nbCellules;
+    }
+
+    /**
+     * @brief Croissance de régions : chaque élément non attribué lance un parcours en largeur qui ajoute ses voisins
+     * tant que la région ne dépasse pas la limite. Les petites régions (moins du quart de la limite) sont ensuite
+     * fusionnées avec la région voisine la plus liée qui peut les accueillir.
+     * @param debut Le début des voisins de chaque élément.
+     * @param voisins Les voisins.
+     * @param taille La taille de chaque élément.
+     * @param limite La taille maximale d'une région.
+     * @param region Reçoit la région de chaque élément, numérotée à partir de 0.
+     * @return Le nombre de régions.
+     */
+    size_t PlanificateurCellules::regrouper(const std::vector<size_t>& debut, const std::vector<uint32_t>& voisins,
+                                            const std::vector<size_t>& taille, size_t limite,
+                                            std::vector<uint32_t>& region)
+    {
+        const size_t nbElements = taille.size();
+        region.assign(nbElements, AUCUNE);
+        std::vector<size_t> tailleRegion;
+        std::vector<std::vector<uint32_t> > membres;
+        for (size_t graine = 0; graine < nbElements; ++graine)
+        {
+            if (region[graine] != AUCUNE)
+                continue;
+            uint32_t r = static_cast<uint32_t>(tailleRegion.size());
+            tailleRegion.push_back(taille[graine]);
+            membres.push_back(std::vector<uint32_t>(1, static_cast<uint32_t>(graine)));
+            region[graine] = r;
+            std::vector<uint32_t>& file = membres.back();
+            for (size_t i = 0; i < file.size(); ++i)
+            {
+                uint32_t e = file[i];
+                for (size_t j = debut[e]; j < debut[e + 1]; ++j)
+                {
+                    uint32_t f = voisins[j];
+                    if (region[f] == AUCUNE && tailleRegion[r] + taille[f] <= limite)
+                    {
+                        region[f] = r;
+                        tailleRegion[r] += taille[f];
+                        file.push_back(f);
+                    }
+                }
+            }
+        }
+
+        // Fusion des petites régions
+        std::vector<size_t> liens(tailleRegion.size(), 0);
+        std::vector<uint32_t> voisines;
+        for (uint32_t r = 0; r < tailleRegion.size(); ++r)
+        {
+            if (membres[r].empty() || tailleRegion[r] * 4 >= limite)
+                continue;
+            for (auto e : membres[r])
+            {
+                for (size_t j = debut[e]; j < debut[e + 1]; ++j)
+                {
+                    uint32_t autre = region[voisins[j]];
+                    if (autre != r && liens[autre]++ == 0)
+                        voisines.push_back(autre);
+                }
+            }
+            uint32_t choix = AUCUNE;
+            for (auto autre : voisines)
+            {
+                if (tailleRegion[r] + tailleRegion[autre] <= limite && (choix == AUCUNE || liens[autre] > liens[choix]))
+                    choix = autre;
+                liens[autre] = 0;
+            }
+            voisines.clear();
+            if (choix == AUCUNE)
+                continue;
+            for (auto e : membres[r])
+                region[e] = choix;
+            tailleRegion[choix] += tailleRegion[r];
+            membres[choix].insert(membres[choix].end(), membres[r].begin(), membres[r].end());
+            std::vector<uint32_t>().swap(membres[r]);
+        }
+
+        // Numérotation compacte
+        std::vector<uint32_t> numero(tailleRegion.size(), AUCUNE);
+        uint32_t nbRegions = 0;
+        for (auto& r : region)
+        {
+            if (numero[r] == AUCUNE)
+                numero[r] = nbRegions++;
+            r = numero[r];
+        }
+        return nbRegions;
+    }
+
+    size_t PlanificateurCellules::niveauRequete(unsigned int v, unsigned int source, unsigned int destination) const
+    {
+        for (size_t k = niveaux.size(); k > 0; --k)
+        {
+            const std::vector<uint32_t>& cellule = niveaux[k - 1].cellule;
+            if (cellule[v] != cellule[source] && cellule[v] != cellule[destination])
+                return k;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Énumère les arcs d'un sommet dans le graphe d'un niveau.
+     * Au niveau 0, ce sont les arcs d'origine. Au niveau k, ce sont les arcs de la clique de la cellule du sommet
+     * (s'il en est une entrée, ou une sortie dans le graphe inverse) et les arcs d'origine qui quittent cette cellule.
+     */
+    template <typename Relacher>
+    void PlanificateurCellules::parcourirArcs(const MetriqueCellules& metrique, size_t k, unsigned int v, bool avant,
+                                              Relacher relacher) const
+    {
+        const VueAdjacence& graphe = avant ? *vue : *inverse;
+        const std::vector<float>& poids = avant ? metrique.poids : metrique.poidsInverse;
+        if (k == 0)
+        {
+            for (size_t a = graphe.debut[v]; a < graphe.debut[v + 1]; ++a)
+                relacher(graphe.destinations[a], poids[a], 0);
+            return;
+        }
+
+        const Niveau& niveau = niveaux[k - 1];
+        const uint32_t c = niveau.cellule[v];
+        const std::vector<float>& cliques = metrique.cliques[k - 1];
+        const size_t nbSorties = niveau.debutSorties[c + 1] - niveau.debutSorties[c];
+        if (avant && niveau.positionEntree[v] != AUCUNE)
+        {
+            const float* ligne = cliques.data() + niveau.debutClique[c] + niveau.positionEntree[v] * nbSorties;
+            for (size_t j = 0; j < nbSorties; ++j)
+                relacher(niveau.sorties[niveau.debutSorties[c] + j], ligne[j], k);
+        }
+        else if (!avant && niveau.positionSortie[v] != AUCUNE)
+        {
+            const float* colonne = cliques.data() + niveau.debutClique[c] + niveau.positionSortie[v];
+            for (size_t i = niveau.debutEntrees[c]; i < niveau.debutEntrees[c + 1]; ++i, colonne += nbSorties)
+                relacher(niveau.entrees[i], *colonne, k);
+        }
+        for (size_t a = graphe.debut[v]; a < graphe.debut[v + 1]; ++a)
+        {
+            unsigned int w = graphe.destinations[a];
+            if (niveau.cellule[w] != c)
+                relacher(w, poids[a], 0);
+        }
+    }
+
+    /**
+     * @brief Dijkstra limité à une cellule, dans le graphe du niveau inférieur.
+     * @param metrique La métrique (cliques des niveaux inférieurs à k déjà calculées).
+     * @param k Le niveau de la cellule.
+     * @param c La cellule.
+     * @param source Le sommet de départ (dans la cellule).
+     * @param cibles Les sommets dont la distance est demandée.
+     * @param espace Les tableaux de travail.
+     */
+    void PlanificateurCellules::rechercherDansCellule(const MetriqueCellules& metrique, size_t k, uint32_t c,
+                                                      unsigned int source, const std::vector<uint32_t>& cibles,
+                                                      Espace& espace) const
+    {
+        const std::vector<uint32_t>& cellule = niveaux[k - 1].cellule;
+        size_t restantes = 0;
+        for (auto v : cibles)
+        {
+            if (!espace.cible[v])
+            {
+                espace.toucher(v);
+                espace.cible[v] = 1;
+                restantes++;
+            }
+        }
+
+        espace.toucher(source);
+        espace.distances[source] = 0.0;
+        espace.pousser(0.0f, source);
+        while (!espace.tas.empty() && restantes > 0)
+        {
+            uint32_t u = espace.extraire().second;
+            if (espace.solutionne[u])
+                continue;
+            espace.solutionne[u] = 1;
+            if (espace.cible[u])
+                restantes--;
+
+            const float du = espace.distances[u];
+            parcourirArcs(metrique, k - 1, u, true, [&](unsigned int w, float poids, size_t niveauArc)
+            {
+                if (cellule[w] != c)
+                    return;
+                float tmp = du + poids;
+                if (tmp < espace.distances[w])
+                {
+                    espace.toucher(w);
+                    espace.distances[w] = tmp;
+                    espace.parents[w] = u;
+                    espace.niveauxParents[w] = static_cast<uint8_t>(niveauArc);
+                    espace.pousser(tmp, w);
+                }
+            });
+        }
+    }
+
+    /**
+     * @brief Déplie un arc de clique : plus court chemin de u à w dans leur cellule du niveau k, dont les arcs de
+     * clique du niveau k - 1 sont dépliés à leur tour.
+     */
+    void PlanificateurCellules::deplier(const MetriqueCellules& metrique, size_t k, unsigned int u, unsigned int w,
+                                        std::vector<unsigned int>& sommets) const
+    {
+        static thread_local Espace espace;
+        espace.preparer(vue->nbSommets());
+        rechercherDansCellule(metrique, k, niveaux[k - 1].cellule[u], u, std::vector<uint32_t>(1, w), espace);
+
+        std::vector<std::pair<uint32_t, uint8_t> > arcs;
+        for (uint32_t v = w; v != u; v = espace.parents[v])
+            arcs.push_back(std::make_pair(v, espace.niveauxParents[v]));
+        espace.effacer();
+
+        for (auto itr = arcs.rbegin(); itr != arcs.rend(); ++itr)
+        {
+            if (itr->second == 0)
+                sommets.push_back(itr->first);
+            else
+                deplier(metrique, itr->second, sommets.back(), itr->first, sommets);
+        }
+    }
+
+    /**
+     * @brief Dijkstra bidirectionnel sur la surcouche : le côté dont le tas a la plus petite clé avance; la
+     * recherche s'arrête quand la somme des deux clés atteint la meilleure distance connue.
+     * @param metrique La métrique personnalisée.
+     * @param source Le sommet de départ.
+     * @param destination Le sommet d'arrivée.
+     * @param avant Les tableaux de la recherche avant (parents vers la source).
+     * @param arriere Les tableaux de la recherche arrière (parents vers la destination).
+     * @param total Reçoit la distance (+infini si aucun chemin).
+     * @return Le sommet de rencontre, AUCUNE si aucun chemin.
+     */
+    uint32_t PlanificateurCellules::rechercher(const MetriqueCellules& metrique, unsigned int source,
+                                               unsigned int destination, Espace& avant, Espace& arriere,
+                                               float& total) const
+    {
+        const size_t n = vue->nbSommets();
+        avant.preparer(n);
+        arriere.preparer(n);
+        total = INFINI;
+        uint32_t milieu = AUCUNE;
+
+        avant.toucher(source);
+        avant.distances[source] = 0.0;
+        avant.pousser(0.0f, source);
+        arriere.toucher(destination);
+        arriere.distances[destination] = 0.0;
+        arriere.pousser(0.0f, destination);
+        if (source == destination)
+        {
+            total = 0.0;
+            return source;
+        }
+
+        while (true)
+        {
+            float cleAvant = avant.tas.empty() ? INFINI : avant.tas.front().first;
+            float cleArriere = arriere.tas.empty() ? INFINI : arriere.tas.front().first;
+            if (cleAvant + cleArriere >= total)
+                break;
+
+            const bool sensAvant = cleAvant <= cleArriere;
+            Espace& courant = sensAvant ? avant : arriere;
+            Espace& oppose = sensAvant ? arriere : avant;
+            uint32_t u = courant.extraire().second;
+            if (courant.solutionne[u])
+                continue;
+            courant.solutionne[u] = 1;
+
+            const float du = courant.distances[u];
+            parcourirArcs(metrique, niveauRequete(u, source, destination), u, sensAvant,
+                          [&](unsigned int w, float poids, size_t niveauArc)
+            {
+                float tmp = du + poids;
+                if (tmp < courant.distances[w])
+                {
+                    courant.toucher(w);
+                    courant.distances[w] = tmp;
+                    courant.parents[w] = u;
+                    courant.niveauxParents[w] = static_cast<uint8_t>(niveauArc);
+                    courant.pousser(tmp, w);
+                    if (tmp + oppose.distances[w] < total)
+                    {
+                        total = tmp + oppose.distances[w];
+                        milieu = w;
+                    }
+                }
+            });
+        }
+        return milieu;
+    }
+
+}//Fin du namespace TP2
@@ -0,0 +1,138 @@
+/**
+ * \file PlanificateurCellules.h
+ * \brief Planification personnalisable (CRP) : partition multiniveau, personnalisation par métrique, requêtes.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include "Graphe.h"
+#include "Parallelisme.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#ifndef _PLANIFICATEURCELLULES__H
+#define _PLANIFICATEURCELLULES__H
+
+namespace TP2
+{
+
+    // Une métrique personnalisée : pondération coefDuree * duree + coefCout * cout, et les cliques de la
+    // surcouche calculées pour cette pondération (voir PlanificateurCellules::personnaliser)
+    struct MetriqueCellules
+    {
+        float coefDuree;
+        float coefCout;
+        std::vector<float> poids;			// Pondération de chaque arc de la vue
+        std::vector<float> poidsInverse;	// Pondération de chaque arc de la vue inverse
+        std::vector<std::vector<float> > cliques;	// cliques[k - 1] : matrices entrées x sorties des cellules du niveau k
+    };
+
+/**
+ * \class PlanificateurCellules
+ * \brief Customizable Route Planning (Delling et al.) sur une vue d'adjacence
+ *
+ * Prétraitement en trois temps :
+ * - partition (topologie seulement, une fois) : les sommets sont regroupés en cellules d'au plus
+ *   taillesCellules[0] sommets par croissance de régions sur le graphe non orienté sous-jacent, puis les cellules
+ *   d'un niveau en cellules du niveau suivant de la même façon : les niveaux sont emboîtés. Les sommets extrémités
+ *   d'un arc entre deux cellules d'un niveau sont les entrées et les sorties de ces cellules;
+ * - personnalisation (par métrique, en parallèle sur les cellules d'un niveau) : pour chaque cellule, la distance
+ *   de chaque entrée à chaque sortie sans quitter la cellule (la clique), calculée dans le graphe du niveau inférieur;
+ * - requête : Dijkstra bidirectionnel où chaque sommet est vu au plus haut niveau dont la cellule ne contient ni
+ *   l'origine ni la destination. Les arcs de clique du chemin trouvé sont dépliés niveau par niveau.
+ * Un changement de pondérations ne demande qu'une nouvelle personnalisation.
+ */
+    class PlanificateurCellules
+    {
+    public:
+
+        // Partitionne la topologie de vue (et de sa vue inverse). taillesCellules : taille maximale des cellules de
+        // chaque niveau, croissante (vide : valeurs par défaut). Les niveaux d'une seule cellule sont omis.
+        // nbThreads : taille du pool de travail de la personnalisation (0 = tous les coeurs)
+        PlanificateurCellules(std::shared_ptr<const VueAdjacence> vue, std::shared_ptr<const VueAdjacence> inverse,
+                              const std::vector<size_t>& taillesCellules = std::vector<size_t>(),
+                              unsigned int nbThreads = 0);
+
+        ~PlanificateurCellules();
+
+        // Calcule les cliques de la métrique coefDuree * duree + coefCout * cout. Les pondérations sont lues dans
+        // ponderations et ponderationsInverse, qui doivent avoir la topologie de la partition (seules les
+        // pondérations ont pu changer).
+        // Exception logic_error si la topologie diffère ou si une pondération de la métrique est négative
+        std::shared_ptr<const MetriqueCellules> personnaliser(const VueAdjacence& ponderations,
+                                                              const VueAdjacence& ponderationsInverse,
+                                                              float coefDuree, float coefCout);
+
+        // Distance de source à destination pour une métrique, +infini si aucun chemin
+        float distance(const MetriqueCellules& metrique, unsigned int source, unsigned int destination) const;
+
+        // Écrit dans sommets le plus court chemin (déplié) et dans total sa longueur. Retourne false s'il n'existe pas.
+        bool chemin(const MetriqueCellules& metrique, unsigned int source, unsigned int destination,
+                    std::vector<unsigned int>& sommets, float& total) const;
+
+        // Nombre de niveaux de la surcouche
+        size_t getNombreNiveaux() const;
+
+        // Nombre de cellules du niveau (1 à getNombreNiveaux())
+        size_t getNombreCellules(size_t niveau) const;
+
+    private:
+
+        // Un niveau de la partition et de sa surcouche
+        struct Niveau
+        {
+            std::vector<uint32_t> cellule;			// Cellule de chaque sommet
+            size_t nbCellules;
+            std::vector<size_t> debutEntrees;		// Entrées de la cellule c : entrees[debutEntrees[c]..debutEntrees[c+1])
+            std::vector<uint32_t> entrees;
+            std::vector<size_t> debutSorties;
+            std::vector<uint32_t> sorties;
+            std::vector<size_t> debutClique;		// Début de la matrice de la cellule c dans les cliques du niveau
+            std::vector<uint32_t> positionEntree;	// Rang du sommet parmi les entrées de sa cellule (AUCUNE sinon)
+            std::vector<uint32_t> positionSortie;
+        };
+
+        // Tableaux de travail d'une recherche (définis dans PlanificateurCellules.cpp)
+        struct Espace;
+
+        std::shared_ptr<const VueAdjacence> vue;
+        std::shared_ptr<const VueAdjacence> inverse;
+        std::vector<Niveau> niveaux;
+        std::vector<std::unique_ptr<Espace> > espaces;	// Un par thread du pool
+        PoolTravail pool;
+
+        // Regroupe les éléments d'un graphe non orienté (CSR, éléments pondérés par leur taille) en régions
+        // connexes d'au plus limite. Retourne le nombre de régions.
+        static size_t regrouper(const std::vector<size_t>& debut, const std::vector<uint32_t>& voisins,
+                                const std::vector<size_t>& taille, size_t limite, std::vector<uint32_t>& region);
+
+        // Plus haut niveau dont la cellule de v ne contient ni source ni destination (0 : graphe d'origine)
+        size_t niveauRequete(unsigned int v, unsigned int source, unsigned int destination) const;
+
+        // Appelle relacher(w, poids, niveauArc) pour chaque arc de v dans le graphe du niveau k (vers l'avant,
+        // ou dans le graphe inverse si avant = false). niveauArc vaut 0 pour un arc d'origine, k pour une clique.
+        template <typename Relacher>
+        void parcourirArcs(const MetriqueCellules& metrique, size_t k, unsigned int v, bool avant,
+                           Relacher relacher) const;
+
+        // Dijkstra dans la cellule c du niveau k (graphe du niveau k - 1) depuis source; s'arrête quand toutes les
+        // cibles sont solutionnées. Les distances et les parents restent dans l'espace jusqu'à effacer.
+        void rechercherDansCellule(const MetriqueCellules& metrique, size_t k, uint32_t c, unsigned int source,
+                                   const std::vector<uint32_t>& cibles, Espace& espace) const;
+
+        // Ajoute à sommets le chemin de u (exclu) à w (inclus) représenté par un arc de niveau k
+        void deplier(const MetriqueCellules& metrique, size_t k, unsigned int u, unsigned int w,
+                     std::vector<unsigned int>& sommets) const;
+
+        // Dijkstra bidirectionnel sur la surcouche; retourne le sommet de rencontre (AUCUNE si aucun chemin)
+        uint32_t rechercher(const MetriqueCellules& metrique, unsigned int source, unsigned int destination,
+                            Espace& avant, Espace& arriere, float& total) const;
+    };
+
+}//Fin du namespace
+
+#endif
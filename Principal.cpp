@@ -36,6 +36,7 @@ int main()
 	cout << "3 - Trouver les composantes fortement connexes avec Kosaraju." << endl;
 	cout << "4 - Mesurer le temps d'execution de Dijkstra." << endl;
 	cout << "5 - Mesurer le temps d'execution de Kosaraju." << endl;
+	cout << "6 - Mesurer l'effet de la renumerotation des villes." << endl;
 	cout << "0 - Quitter." << endl;
 	cout << "--------------------------------------------------------" << endl;
 
@@ -44,11 +45,11 @@ int main()
 		do
 		{
 			cout << endl;
-			cout << "Entrer s.v.p. votre choix (0 a 5):? ";
+			cout << "Entrer s.v.p. votre choix (0 a 6):? ";
 			cin >> nb;
-			if(nb <0 || nb>5)
+			if(nb <0 || nb>6)
 				cout << "***Option invalide!***\n";
-		}while(nb <0 || nb>5);
+		}while(nb <0 || nb>6);
 
 		try
 		{
@@ -124,11 +125,52 @@ int main()
 					cout << "Mesurer le temps d'execution de Kosaraju." << endl;
 					startTime = clock();
 					for(int i=0; i<100; i++)
+					{
+						reseau.viderCaches();
 						std::vector<std::vector<std::string> > bench_qt_Kosaraju = reseau.algorithmeKosaraju();
+					}
 					endTime = clock();
 					cout << "Temps d'execution: " << endTime - startTime << " microsecondes" << endl;
 					break;
 				}
+				case 6: //Mesurer l'effet de la renumérotation des villes.
+				{
+					cout << "Mesurer l'effet de la renumerotation des villes." << endl;
+					const char* nomsOrdres[] = {"ordre du fichier", "parcours en largeur", "Cuthill-McKee inverse"};
+					OrdreSommets ordres[] = {OrdreSommets::Fichier, OrdreSommets::ParcoursLargeur, OrdreSommets::CuthillMcKeeInverse};
+					for(int o=0; o<3; o++)
+					{
+						ReseauInterurbain reseauOrdonne("");
+						EntreeFichier.open("ReseauInterurbain.txt", ios::in);
+						if(EntreeFichier.is_open())
+						{
+							reseauOrdonne.chargerReseau(EntreeFichier, ordres[o]);
+						}
+						EntreeFichier.close();
+						size_t nbVilles = reseauOrdonne.getNombreVilles();
+						if(nbVilles == 0)
+							break;
+
+						//Dijkstra (tas) depuis chaque ville vers la ville "opposée"
+						TamponChemin tampon;
+						startTime = clock();
+						for(int i=0; i<100; i++)
+							for(size_t v=0; v<nbVilles; v++)
+								reseauOrdonne.rechercheCheminIds(v, (v + nbVilles / 2) % nbVilles, true, tampon, MoteurRecherche::Tas);
+						endTime = clock();
+						cout << nomsOrdres[o] << " - Dijkstra: " << endTime - startTime << " microsecondes";
+
+						startTime = clock();
+						for(int i=0; i<100; i++)
+						{
+							reseauOrdonne.viderCaches();
+							reseauOrdonne.algorithmeKosaraju();
+						}
+						endTime = clock();
+						cout << ", Kosaraju: " << endTime - startTime << " microsecondes" << endl;
+					}
+					break;
+				}
 			}
 		}
 		catch(exception & e)
@@ -0,0 +1,371 @@
+/**
+ * \file ReseauFedere.cpp
+ * \brief Implémentation du réseau fédéré.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+
+#include "ReseauFedere.h"
+
+namespace TP2
+{
+
+    namespace
+    {
+        const float INFINI = std::numeric_limits<float>::infinity();
+    }
+
+    const uint32_t DictionnaireVilles::AUCUNE;
+    const uint32_t ReseauFedere::AUCUN;
+
+    /**
+     * @brief Retourne le numéro d'un nom, en l'ajoutant s'il est nouveau.
+     * @param nom Le nom de la ville.
+     * @return Son numéro dans le dictionnaire.
+     */
+    uint32_t DictionnaireVilles::interner(const std::string& nom)
+    {
+        auto itr = numeros.find(&nom);
+        if (itr != numeros.end())
+            return itr->second;
+
+        noms.push_back(nom);
+        uint32_t numero = static_cast<uint32_t>(noms.size() - 1);
+        numeros.insert(std::make_pair(&noms.back(), numero));
+        return numero;
+    }
+
+    uint32_t DictionnaireVilles::trouver(const std::string& nom) const
+    {
+        auto itr = numeros.find(&nom);
+        return itr == numeros.end() ? AUCUNE : itr->second;
+    }
+
+    /**
+     * @brief Retourne le nom d'une ville du dictionnaire.
+     * @throws std::logic_error Si le numéro est invalide.
+     */
+    const std::string& DictionnaireVilles::getNom(uint32_t numero) const
+    {
+        if (numero >= noms.size())
+        {
+            throw std::logic_error("DictionnaireVilles::getNom : numéro invalide");
+        }
+        return noms[numero];
+    }
+
+    size_t DictionnaireVilles::getNombreVilles() const
+    {
+        return noms.size();
+    }
+
+    ReseauFedere::ReseauFedere() : nbSommets(0), aJour(false)
+    {
+    }
+
+    /**
+     * @brief Ajoute un opérateur (le réseau n'est pas copié).
+     * @param reseau Le réseau de l'opérateur.
+     * @return Le numéro de l'opérateur.
+     */
+    size_t ReseauFedere::ajouterOperateur(const ReseauInterurbain& reseau)
+    {
+        std::lock_guard<std::mutex> verrouFedere(verrou);
+        Operateur operateur;
+        operateur.reseau = &reseau;
+        operateur.version = 0;
+        operateur.nonNegatifs = true;
+        operateur.decalage = 0;
+        operateurs.push_back(operateur);
+        aJour = false;
+        return operateurs.size() - 1;
+    }
+
+    size_t ReseauFedere::getNombreOperateurs() const
+    {
+        std::lock_guard<std::mutex> verrouFedere(verrou);
+        return operateurs.size();
+    }
+
+    /**
+     * @brief Autorise la correspondance entre deux opérateurs dans toutes leurs villes communes.
+     * @param operateur1 Le premier opérateur.
+     * @param operateur2 Le second opérateur.
+     * @param duree La durée de la correspondance.
+     * @param cout Le coût de la correspondance.
+     * @throws std::logic_error Si un opérateur est invalide, s'ils sont identiques ou si une pondération est négative.
+     */
+    void ReseauFedere::definirCorrespondance(size_t operateur1, size_t operateur2, float duree, float cout)
+    {
+        std::lock_guard<std::mutex> verrouFedere(verrou);
+        verifierOperateur(operateur1);
+        verifierOperateur(operateur2);
+        if (operateur1 == operateur2 || duree < 0 || cout < 0)
+        {
+            throw std::logic_error("definirCorrespondance : opérateurs identiques ou pondération négative");
+        }
+        Correspondance correspondance = {duree, cout};
+        correspondances[std::make_pair(std::min(operateur1, operateur2), std::max(operateur1, operateur2))] = correspondance;
+    }
+
+    /**
+     * @brief Autorise la correspondance entre deux opérateurs dans une ville.
+     * @param ville La ville de la correspondance.
+     * @param operateur1 Le premier opérateur.
+     * @param operateur2 Le second opérateur.
+     * @param duree La durée de la correspondance.
+     * @param cout Le coût de la correspondance.
+     * @throws std::logic_error Si un opérateur est invalide, s'ils sont identiques ou si une pondération est négative.
+     */
+    void ReseauFedere::definirCorrespondance(const std::string& ville, size_t operateur1, size_t operateur2,
+                                             float duree, float cout)
+    {
+        std::lock_guard<std::mutex> verrouFedere(verrou);
+        verifierOperateur(operateur1);
+        verifierOperateur(operateur2);
+        if (operateur1 == operateur2 || duree < 0 || cout < 0)
+        {
+            throw std::logic_error("definirCorrespondance : opérateurs identiques ou pondération négative");
+        }
+
+        uint32_t numero = dictionnaire.interner(ville);
+        aJour = false;	// Le dictionnaire a pu grandir
+        Correspondance correspondance = {duree, cout};
+        correspondancesVilles[std::make_pair(numero, std::make_pair(std::min(operateur1, operateur2),
+                                                                    std::max(operateur1, operateur2)))] = correspondance;
+    }
+
+    const DictionnaireVilles& ReseauFedere::getDictionnaire() const
+    {
+        std::lock_guard<std::mutex> verrouFedere(verrou);
+        actualiser();
+        return dictionnaire;
+    }
+
+    /**
+     * @brief Plus court chemin entre deux villes sur l'ensemble des opérateurs.
+     * Dijkstra sur les sommets fédérés : toutes les dessertes de l'origine partent à distance 0, et la recherche
+     * s'arrête à la première desserte de la destination solutionnée. Les arcs d'un sommet sont ceux de la vue de
+     * son opérateur, plus les correspondances autorisées vers les autres opérateurs qui desservent la même ville.
+     * @param origine La ville de départ.
+     * @param destination La ville d'arrivée.
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @return Le chemin, avec l'opérateur de chaque trajet.
+     * @throws std::logic_error Si une ville n'est desservie par aucun opérateur ou si un arc est négatif.
+     */
+    CheminFedere ReseauFedere::rechercheChemin(const std::string& origine, const std::string& destination,
+                                               bool dureeCout) const
+    {
+        typedef std::pair<float, uint32_t> Entree;
+
+        std::lock_guard<std::mutex> verrouFedere(verrou);
+        actualiser();
+
+        uint32_t villeOrigine = dictionnaire.trouver(origine);
+        uint32_t villeDestination = dictionnaire.trouver(destination);
+        if (villeOrigine == DictionnaireVilles::AUCUNE || villeDestination == DictionnaireVilles::AUCUNE
+            || debutDessertes[villeOrigine] == debutDessertes[villeOrigine + 1]
+            || debutDessertes[villeDestination] == debutDessertes[villeDestination + 1])
+        {
+            throw std::logic_error("ReseauFedere::rechercheChemin : ville desservie par aucun opérateur");
+        }
+        for (const auto& operateur : operateurs)
+        {
+            if (!operateur.nonNegatifs)
+                throw std::logic_error("ReseauFedere::rechercheChemin : les arcs ne sont pas tous non négatifs");
+        }
+
+        // Opérateur et sommet interne d'un sommet fédéré
+        auto operateurDe = [this](uint32_t sommet)
+        {
+            size_t o = operateurs.size() - 1;
+            while (operateurs[o].decalage > sommet)
+                --o;
+            return o;
+        };
+
+        std::vector<float> distances(nbSommets, INFINI);
+        std::vector<uint32_t> predecesseurs(nbSommets, AUCUN);
+        std::vector<bool> solutionnes(nbSommets, false);
+        std::priority_queue<Entree, std::vector<Entree>, std::greater<Entree> > tas;
+        for (size_t d = debutDessertes[villeOrigine]; d < debutDessertes[villeOrigine + 1]; ++d)
+        {
+            uint32_t sommet = static_cast<uint32_t>(operateurs[dessertes[d].operateur].decalage + dessertes[d].sommet);
+            distances[sommet] = 0.0;
+            tas.push(Entree(0.0f, sommet));
+        }
+
+        uint32_t arrivee = AUCUN;
+        while (!tas.empty())
+        {
+            uint32_t u = tas.top().second;
+            tas.pop();
+            if (solutionnes[u])
+                continue;
+            solutionnes[u] = true;
+
+            size_t o = operateurDe(u);
+            const Operateur& operateur = operateurs[o];
+            uint32_t s = static_cast<uint32_t>(u - operateur.decalage);
+            uint32_t ville = operateur.villes[s];
+            if (ville == villeDestination)
+            {
+                arrivee = u;
+                break;
+            }
+
+            auto relacher = [&](uint32_t v, float poids)
+            {
+                float tmp = distances[u] + poids;
+                if (tmp < distances[v])
+                {
+                    distances[v] = tmp;
+                    predecesseurs[v] = u;
+                    tas.push(Entree(tmp, v));
+                }
+            };
+
+            const VueAdjacence& vue = *operateur.vue;
+            const std::vector<float>& poids = vue.ponderations(dureeCout);
+            for (size_t a = vue.debut[s]; a < vue.debut[s + 1]; ++a)
+                relacher(static_cast<uint32_t>(operateur.decalage + vue.destinations[a]), poids[a]);
+
+            for (size_t d = debutDessertes[ville]; d < debutDessertes[ville + 1]; ++d)
+            {
+                if (dessertes[d].operateur == o)
+                    continue;
+                const Correspondance* c = correspondance(ville, o, dessertes[d].operateur);
+                if (c)
+                {
+                    relacher(static_cast<uint32_t>(operateurs[dessertes[d].operateur].decalage + dessertes[d].sommet),
+                             dureeCout ? c->duree : c->cout);
+                }
+            }
+        }
+
+        CheminFedere chemin;
+        chemin.nbCorrespondances = 0;
+        chemin.dureeTotale = 0.0;
+        chemin.coutTotal = 0.0;
+        chemin.reussi = arrivee != AUCUN;
+        if (!chemin.reussi)
+            return chemin;
+
+        std::vector<uint32_t> sommets;
+        for (uint32_t sommet = arrivee; sommet != AUCUN; sommet = predecesseurs[sommet])
+            sommets.push_back(sommet);
+        std::reverse(sommets.begin(), sommets.end());
+
+        size_t o = operateurDe(sommets[0]);
+        chemin.listeVilles.push_back(dictionnaire.getNom(operateurs[o].villes[sommets[0] - operateurs[o].decalage]));
+        for (size_t i = 1; i < sommets.size(); ++i)
+        {
+            size_t oPrecedent = o;
+            o = operateurDe(sommets[i]);
+            uint32_t precedent = static_cast<uint32_t>(sommets[i - 1] - operateurs[oPrecedent].decalage);
+            uint32_t courant = static_cast<uint32_t>(sommets[i] - operateurs[o].decalage);
+            if (o != oPrecedent)
+            {
+                // Correspondance : même ville, autre opérateur
+                const Correspondance* c = correspondance(operateurs[o].villes[courant], oPrecedent, o);
+                chemin.dureeTotale += c->duree;
+                chemin.coutTotal += c->cout;
+                chemin.nbCorrespondances++;
+                continue;
+            }
+
+            const VueAdjacence& vue = *operateurs[o].vue;
+            for (size_t a = vue.debut[precedent]; a < vue.debut[precedent + 1]; ++a)
+            {
+                if (vue.destinations[a] == courant)
+                {
+                    chemin.dureeTotale += vue.durees[a];
+                    chemin.coutTotal += vue.couts[a];
+                    break;
+                }
+            }
+            chemin.listeVilles.push_back(dictionnaire.getNom(operateurs[o].villes[courant]));
+            chemin.operateurs.push_back(o);
+        }
+        return chemin;
+    }
+
+    /**
+     * @brief Met à jour les opérateurs dont le graphe a changé, puis la table des dessertes.
+     * Les noms des sommets sont internés dans le dictionnaire; la vue d'adjacence est celle de l'opérateur.
+     */
+    void ReseauFedere::actualiser() const
+    {
+        bool change = !aJour;
+        size_t decalage = 0;
+        for (auto& operateur : operateurs)
+        {
+            const Graphe& graphe = operateur.reseau->getGraphe();
+            if (!operateur.vue || operateur.version != graphe.getVersion())
+            {
+                operateur.vue = operateur.reseau->getVueAdjacence();
+                operateur.villes.resize(graphe.getNombreSommets());
+                for (size_t s = 0; s < operateur.villes.size(); ++s)
+                    operateur.villes[s] = dictionnaire.interner(graphe.getNomSommet(s));
+                operateur.nonNegatifs = graphe.arcsSontNonNegatifs();
+                operateur.version = graphe.getVersion();
+                change = true;
+            }
+            operateur.decalage = decalage;
+            decalage += operateur.villes.size();
+        }
+        if (!change)
+            return;
+        nbSommets = decalage;
+
+        // Dessertes regroupées par ville (tri par paquets)
+        size_t nbVilles = dictionnaire.getNombreVilles();
+        debutDessertes.assign(nbVilles + 1, 0);
+        for (const auto& operateur : operateurs)
+        {
+            for (auto ville : operateur.villes)
+                debutDessertes[ville + 1]++;
+        }
+        for (size_t c = 0; c < nbVilles; ++c)
+            debutDessertes[c + 1] += debutDessertes[c];
+        dessertes.resize(nbSommets);
+        std::vector<size_t> position(debutDessertes.begin(), debutDessertes.end() - 1);
+        for (size_t o = 0; o < operateurs.size(); ++o)
+        {
+            for (size_t s = 0; s < operateurs[o].villes.size(); ++s)
+            {
+                Desserte desserte = {static_cast<uint32_t>(o), static_cast<uint32_t>(s)};
+                dessertes[position[operateurs[o].villes[s]]++] = desserte;
+            }
+        }
+        aJour = true;
+    }
+
+    const ReseauFedere::Correspondance* ReseauFedere::correspondance(uint32_t ville, size_t operateur1,
+                                                                     size_t operateur2) const
+    {
+        std::pair<size_t, size_t> paire(std::min(operateur1, operateur2), std::max(operateur1, operateur2));
+        auto itrVille = correspondancesVilles.find(std::make_pair(ville, paire));
+        if (itrVille != correspondancesVilles.end())
+            return &itrVille->second;
+        auto itr = correspondances.find(paire);
+        return itr == correspondances.end() ? nullptr : &itr->second;
+    }
+
+    void ReseauFedere::verifierOperateur(size_t operateur) const
+    {
+        if (operateur >= operateurs.size())
+        {
+            throw std::logic_error("ReseauFedere : opérateur invalide");
+        }
+    }
+
+}//Fin du namespace TP2
@@ -0,0 +1,169 @@
+/**
+ * \file ReseauFedere.h
+ * \brief Vue fédérée de plusieurs réseaux d'opérateurs partageant un dictionnaire de villes.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include "Graphe.h"
+#include "ReseauInterurbain.h"
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifndef _RESEAUFEDERE__H
+#define _RESEAUFEDERE__H
+
+namespace TP2
+{
+
+/**
+ * \class DictionnaireVilles
+ * \brief Table des noms de villes où chaque nom n'est stocké qu'une fois
+ *
+ * Les noms sont rangés dans une deque (adresses stables) et l'index de recherche pointe vers eux : il ne
+ * contient aucune copie des chaînes. Le dictionnaire s'ajoute aux noms que le graphe de chaque opérateur
+ * conserve : c'est une copie de plus de chaque nom distinct, qui donne un numéro commun aux villes.
+ */
+    class DictionnaireVilles
+    {
+    public:
+
+        static const uint32_t AUCUNE = UINT32_MAX;	// Ville absente du dictionnaire
+
+        // Retourne le numéro du nom, ajouté au dictionnaire s'il n'y est pas
+        uint32_t interner(const std::string& nom);
+
+        // Retourne le numéro du nom, AUCUNE s'il n'est pas dans le dictionnaire
+        uint32_t trouver(const std::string& nom) const;
+
+        // Exception logic_error si numero supérieur au nombre de villes
+        const std::string& getNom(uint32_t numero) const;
+
+        size_t getNombreVilles() const;
+
+    private:
+
+        struct HacheNom
+        {
+            size_t operator()(const std::string* nom) const { return std::hash<std::string>()(*nom); }
+        };
+        struct EgaliteNom
+        {
+            bool operator()(const std::string* a, const std::string* b) const { return *a == *b; }
+        };
+
+        std::deque<std::string> noms;
+        std::unordered_map<const std::string*, uint32_t, HacheNom, EgaliteNom> numeros;
+    };
+
+    // Résultat d'une recherche dans un réseau fédéré
+    struct CheminFedere
+    {
+        std::vector<std::string> listeVilles;	// Villes traversées (une correspondance ne répète pas la ville)
+        std::vector<size_t> operateurs;			// operateurs[i] : opérateur du trajet listeVilles[i] -> listeVilles[i + 1]
+        size_t nbCorrespondances;				// Nombre de changements d'opérateur
+        float dureeTotale;						// Trajets et correspondances compris
+        float coutTotal;
+        bool reussi;
+    };
+
+/**
+ * \class ReseauFedere
+ * \brief Plusieurs réseaux d'opérateurs vus comme un seul, sans fusion de leurs listes d'adjacence
+ *
+ * Un sommet fédéré est un couple (opérateur, ville de cet opérateur). Les recherches parcourent les vues
+ * d'adjacence propres à chaque opérateur, et ajoutent à la volée des arcs de correspondance entre les
+ * opérateurs qui desservent une même ville, selon la configuration (definirCorrespondance).
+ * Les réseaux ne sont pas copiés : ils doivent survivre au réseau fédéré. Leurs modifications sont prises en
+ * compte à la recherche suivante.
+ */
+    class ReseauFedere
+    {
+    public:
+
+        ReseauFedere();
+
+        // Ajoute un opérateur et retourne son numéro
+        size_t ajouterOperateur(const ReseauInterurbain& reseau);
+
+        size_t getNombreOperateurs() const;
+
+        // Autorise la correspondance entre deux opérateurs (dans les deux sens) dans toutes les villes qu'ils
+        // desservent tous deux, avec la durée et le coût donnés
+        // Exception logic_error si un opérateur est invalide, si les opérateurs sont identiques ou si une
+        // pondération est négative
+        void definirCorrespondance(size_t operateur1, size_t operateur2, float duree, float cout);
+
+        // Même chose pour une seule ville; prioritaire sur la règle générale entre ces deux opérateurs
+        void definirCorrespondance(const std::string& ville, size_t operateur1, size_t operateur2,
+                                   float duree, float cout);
+
+        // Dictionnaire commun des villes de tous les opérateurs (une copie de chaque nom distinct, en plus des
+        // noms gardés par les graphes des opérateurs)
+        const DictionnaireVilles& getDictionnaire() const;
+
+        // Plus court chemin entre deux villes, tous opérateurs confondus (durée si dureeCout = true, coût sinon)
+        // Exception logic_error si une ville n'est desservie par aucun opérateur ou si un arc est négatif
+        CheminFedere rechercheChemin(const std::string& origine, const std::string& destination, bool dureeCout) const;
+
+    private:
+
+        static const uint32_t AUCUN = UINT32_MAX;
+
+        // État d'un opérateur pour une version de son graphe
+        struct Operateur
+        {
+            const ReseauInterurbain* reseau;
+            std::shared_ptr<const VueAdjacence> vue;
+            std::vector<uint32_t> villes;	// Numéro dans le dictionnaire de chaque sommet interne
+            unsigned long version;			// Version du graphe décrite (villes, vue)
+            bool nonNegatifs;
+            size_t decalage;				// Numéro fédéré du premier sommet de l'opérateur
+        };
+
+        struct Correspondance
+        {
+            float duree;
+            float cout;
+        };
+
+        // Présence d'une ville chez un opérateur
+        struct Desserte
+        {
+            uint32_t operateur;
+            uint32_t sommet;	// Numéro interne chez l'opérateur
+        };
+
+        mutable std::mutex verrou;	// Protège les opérateurs, le dictionnaire et les correspondances
+        mutable std::vector<Operateur> operateurs;
+        mutable DictionnaireVilles dictionnaire;
+        mutable std::vector<size_t> debutDessertes;	// Dessertes de la ville c : [debutDessertes[c], debutDessertes[c+1])
+        mutable std::vector<Desserte> dessertes;
+        mutable size_t nbSommets;					// Nombre total de sommets fédérés
+        mutable bool aJour;
+
+        std::map<std::pair<size_t, size_t>, Correspondance> correspondances;	// Clé : (plus petit, plus grand)
+        std::map<std::pair<uint32_t, std::pair<size_t, size_t> >, Correspondance> correspondancesVilles;
+
+        // Reconstruit l'état des opérateurs dont le graphe a changé, puis les dessertes
+        void actualiser() const;
+
+        // Retourne la correspondance entre deux opérateurs dans une ville, nullptr si elle n'est pas autorisée
+        const Correspondance* correspondance(uint32_t ville, size_t operateur1, size_t operateur2) const;
+
+        void verifierOperateur(size_t operateur) const;
+    };
+
+}//Fin du namespace
+
+#endif
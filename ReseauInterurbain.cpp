@@ -13,21 +13,316 @@
 #include <stack>
 #include <limits>
 #include <queue>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <cstring>
+#include <cstdlib>
+#include <unordered_map>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 #include "ReseauInterurbain.h"
+#include "Parallelisme.h"
+#include "DeltaStepping.h"
+#include "ComposantesParalleles.h"
+#include "Centralite.h"
 //vous pouvez inclure d'autres librairies si c'est nécessaire
 
 namespace TP2
 {
 
+    namespace
+    {
+        const float INFINI = std::numeric_limits<float>::infinity();	// Distance d'un sommet non atteint
+        const unsigned int AUCUN = UINT_MAX;	// Prédécesseur d'un sommet non atteint
+        const char SIGNATURE_INSTANTANE[4] = {'T', 'P', '2', 'B'};	// Début d'un instantané binaire
+
+        template <typename T>
+        void ecrireBinaire(std::string& tampon, T valeur)
+        {
+            tampon.append(reinterpret_cast<const char*>(&valeur), sizeof(T));
+        }
+
+        // Lit une valeur à position (avant fin) et avance. Exception logic_error si le tampon est trop court
+        template <typename T>
+        T lireBinaire(const std::string& tampon, size_t& position, size_t fin)
+        {
+            if (fin - position < sizeof(T))
+                throw std::logic_error("lireBinaire : données tronquées");
+            T valeur;
+            std::memcpy(&valeur, tampon.data() + position, sizeof(T));
+            position += sizeof(T);
+            return valeur;
+        }
+
+        /**
+         * @brief Retourne l'indice de la plus petite clé (la première en cas d'égalité).
+         * @param cles Tableau aligné sur 32 octets, de taille multiple de 8.
+         * @param taille Le nombre de clés.
+         */
+        size_t indiceMinimum(const float* cles, size_t taille)
+        {
+#if defined(__AVX2__)
+            __m256 minimums = _mm256_set1_ps(INFINI);
+            __m256i indices = _mm256_set1_epi32(0);
+            __m256i courants = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+            const __m256i huit = _mm256_set1_epi32(8);
+            for (size_t j = 0; j < taille; j += 8)
+            {
+                __m256 valeurs = _mm256_load_ps(cles + j);
+                __m256 plusPetits = _mm256_cmp_ps(valeurs, minimums, _CMP_LT_OQ);
+                minimums = _mm256_blendv_ps(minimums, valeurs, plusPetits);
+                indices = _mm256_blendv_epi8(indices, courants, _mm256_castps_si256(plusPetits));
+                courants = _mm256_add_epi32(courants, huit);
+            }
+
+            // Réduction des 8 voies : plus petite valeur, puis plus petit indice
+            alignas(32) float valeursVoies[8];
+            alignas(32) unsigned int indicesVoies[8];
+            _mm256_store_ps(valeursVoies, minimums);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(indicesVoies), indices);
+            size_t meilleur = indicesVoies[0];
+            float minimum = valeursVoies[0];
+            for (int voie = 1; voie < 8; ++voie)
+            {
+                if (valeursVoies[voie] < minimum || (valeursVoies[voie] == minimum && indicesVoies[voie] < meilleur))
+                {
+                    minimum = valeursVoies[voie];
+                    meilleur = indicesVoies[voie];
+                }
+            }
+            return meilleur;
+#else
+            size_t meilleur = 0;
+            float minimum = INFINI;
+            for (size_t j = 0; j < taille; ++j)
+            {
+                if (cles[j] < minimum)
+                {
+                    minimum = cles[j];
+                    meilleur = j;
+                }
+            }
+            return meilleur;
+#endif
+        }
+
+        /**
+         * @brief Relâche tous les arcs sortants du sommet u à partir de sa ligne de la matrice dense.
+         * Un sommet déjà solutionné a une distance <= distanceU et n'est donc jamais modifié.
+         */
+        void relacherLigne(const float* ligne, float distanceU, unsigned int u,
+                           float* distances, float* cles, unsigned int* predecesseurs, size_t taille)
+        {
+#if defined(__AVX2__)
+            const __m256 du = _mm256_set1_ps(distanceU);
+            const __m256i vu = _mm256_set1_epi32(static_cast<int>(u));
+            for (size_t j = 0; j < taille; j += 8)
+            {
+                __m256 candidats = _mm256_add_ps(du, _mm256_load_ps(ligne + j));
+                __m256 actuelles = _mm256_load_ps(distances + j);
+                __m256 meilleurs = _mm256_cmp_ps(candidats, actuelles, _CMP_LT_OQ);
+                _mm256_store_ps(distances + j, _mm256_blendv_ps(actuelles, candidats, meilleurs));
+                _mm256_store_ps(cles + j, _mm256_blendv_ps(_mm256_load_ps(cles + j), candidats, meilleurs));
+                __m256i* pred = reinterpret_cast<__m256i*>(predecesseurs + j);
+                _mm256_store_si256(pred, _mm256_blendv_epi8(_mm256_load_si256(pred), vu, _mm256_castps_si256(meilleurs)));
+            }
+#else
+            for (size_t j = 0; j < taille; ++j)
+            {
+                float candidat = distanceU + ligne[j];
+                if (candidat < distances[j])
+                {
+                    distances[j] = candidat;
+                    cles[j] = candidat;
+                    predecesseurs[j] = u;
+                }
+            }
+#endif
+        }
+
+        const size_t TAILLE_BLOC = 64;	// Côté d'un bloc de Floyd-Warshall (3 blocs de 16 Ko tiennent en L1/L2)
+
+        /**
+         * @brief Relâche le bloc (I, J) de Floyd-Warshall en passant par les sommets intermédiaires du bloc K.
+         * Les chemins sont comparés par (distance, nombre de trajets) : à distance égale, le chemin le plus court
+         * en trajets l'emporte. Sans ce départage, un circuit de pondération nulle peut boucler les prochains sommets.
+         * @param n Le nombre de sommets (côté des matrices).
+         * @param distances La matrice des distances, n x n.
+         * @param suivants La matrice des prochains sommets, n x n.
+         * @param sauts La matrice des nombres de trajets, n x n.
+         * @param bi, bj, bk Les indices des blocs ligne, colonne et intermédiaire.
+         */
+        void relacherBloc(size_t n, float* distances, unsigned int* suivants, uint16_t* sauts,
+                          size_t bi, size_t bj, size_t bk)
+        {
+            size_t finI = std::min(n, (bi + 1) * TAILLE_BLOC);
+            size_t finJ = std::min(n, (bj + 1) * TAILLE_BLOC);
+            size_t finK = std::min(n, (bk + 1) * TAILLE_BLOC);
+            for (size_t k = bk * TAILLE_BLOC; k < finK; ++k)
+            {
+                const float* ligneK = distances + k * n;
+                const uint16_t* sautsK = sauts + k * n;
+                for (size_t i = bi * TAILLE_BLOC; i < finI; ++i)
+                {
+                    float dik = distances[i * n + k];
+                    if (dik == INFINI)
+                    {
+                        continue;
+                    }
+                    float* ligneI = distances + i * n;
+                    unsigned int* suivantsI = suivants + i * n;
+                    uint16_t* sautsI = sauts + i * n;
+                    unsigned int suivantIK = suivantsI[k];
+                    unsigned int sautsIK = sautsI[k];
+                    for (size_t j = bj * TAILLE_BLOC; j < finJ; ++j)
+                    {
+                        float candidat = dik + ligneK[j];
+                        unsigned int sautsCandidat = sautsIK + sautsK[j];
+                        if (candidat < ligneI[j]
+                            || (candidat == ligneI[j] && sautsCandidat < sautsI[j] && candidat != INFINI))
+                        {
+                            ligneI[j] = candidat;
+                            suivantsI[j] = suivantIK;
+                            sautsI[j] = static_cast<uint16_t>(sautsCandidat);
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Floyd-Warshall par blocs, parallélisé sur les blocs indépendants de chaque étape.
+         * Pour chaque bloc diagonal K : (1) le bloc (K, K), (2) les blocs de la ligne et de la colonne K,
+         * (3) tous les autres blocs, qui ne dépendent plus que de la ligne et de la colonne K.
+         * @param n Le nombre de sommets (au plus 65535).
+         * @param distances En entrée les pondérations des arcs (0 sur la diagonale, +infini sans arc), en sortie les distances.
+         * @param suivants En entrée la destination de chaque arc, en sortie le prochain sommet de chaque plus court chemin.
+         * @param nbThreads Le nombre de threads (0 = tous les coeurs).
+         */
+        void floydWarshallParBlocs(size_t n, std::vector<float>& distances, std::vector<unsigned int>& suivants,
+                                   unsigned int nbThreads)
+        {
+            std::vector<uint16_t> nbSauts(n * n);
+            for (size_t i = 0; i < n * n; ++i)
+                nbSauts[i] = (i % (n + 1) == 0 || distances[i] == INFINI) ? 0 : 1;
+
+            size_t nbBlocs = (n + TAILLE_BLOC - 1) / TAILLE_BLOC;
+            float* d = distances.data();
+            unsigned int* s = suivants.data();
+            uint16_t* h = nbSauts.data();
+            for (size_t k = 0; k < nbBlocs; ++k)
+            {
+                relacherBloc(n, d, s, h, k, k, k);
+
+                executerEnParallele(2 * nbBlocs, [&](size_t t, unsigned int)
+                {
+                    size_t autre = t / 2;
+                    if (autre == k)
+                        return;
+                    if (t % 2 == 0)
+                        relacherBloc(n, d, s, h, k, autre, k);
+                    else
+                        relacherBloc(n, d, s, h, autre, k, k);
+                }, nbThreads);
+
+                executerEnParallele(nbBlocs * nbBlocs, [&](size_t t, unsigned int)
+                {
+                    size_t i = t / nbBlocs;
+                    size_t j = t % nbBlocs;
+                    if (i != k && j != k)
+                        relacherBloc(n, d, s, h, i, j, k);
+                }, nbThreads);
+            }
+        }
+
+        const size_t TAILLE_LECTURE = 1 << 22;	// Octets lus par morceau de trajets (mémoire bornée au chargement)
+
+        // Trajet lu dans un fichier de réseau, villes déjà résolues
+        struct TrajetLu
+        {
+            unsigned int source;
+            unsigned int destination;
+            float duree;
+            float cout;
+        };
+
+        /**
+         * @brief Retourne le numéro d'une ville à partir de l'index des noms.
+         * @param index L'index nom -> numéro.
+         * @param nom Le nom de la ville.
+         * @return Le numéro de la ville.
+         * @throws std::logic_error Si la ville n'est pas dans l'index.
+         */
+        unsigned int numeroVille(const std::unordered_map<std::string, unsigned int>& index, const std::string& nom)
+        {
+            auto it = index.find(nom);
+            if (it == index.end())
+                throw std::logic_error("chargerReseau : ville inconnue : " + nom);
+            return it->second;
+        }
+
+        /**
+         * @brief Analyse les trajets complets de [debut, fin) (trois lignes chacun : source, destination, "duree cout").
+         * La dernière ligne peut ne pas se terminer par un saut de ligne.
+         * @param debut Début du premier trajet.
+         * @param fin Fin du dernier trajet.
+         * @param index L'index nom -> numéro des villes.
+         * @param trajets Reçoit les trajets dans l'ordre du fichier.
+         * @throws std::logic_error Si une ville est inconnue ou si les pondérations sont illisibles.
+         */
+        void analyserTrajets(const char* debut, const char* fin,
+                             const std::unordered_map<std::string, unsigned int>& index, std::vector<TrajetLu>& trajets)
+        {
+            std::string lignes[3];
+            while (debut < fin)
+            {
+                for (std::string& ligne : lignes)
+                {
+                    const char* saut = static_cast<const char*>(std::memchr(debut, '\n', fin - debut));
+                    if (!saut)
+                        saut = fin;
+                    ligne.assign(debut, saut);
+                    debut = saut < fin ? saut + 1 : fin;
+                }
+
+                TrajetLu trajet;
+                trajet.source = numeroVille(index, lignes[0]);
+                trajet.destination = numeroVille(index, lignes[1]);
+
+                const char* texte = lignes[2].c_str();
+                char* suite;
+                trajet.duree = std::strtof(texte, &suite);
+                if (suite == texte)
+                    throw std::logic_error("chargerReseau : pondérations illisibles : " + lignes[2]);
+                texte = suite;
+                trajet.cout = std::strtof(texte, &suite);
+                if (suite == texte)
+                    throw std::logic_error("chargerReseau : pondérations illisibles : " + lignes[2]);
+
+                trajets.push_back(trajet);
+            }
+        }
+    }
+
     /**
      * @brief Constructeur de la classe ReseauInterurbain.
      * @param nomReseau Le nom du réseau interurbain.
      * @param nbVilles Le nombre de villes dans le réseau.
      */
     ReseauInterurbain::ReseauInterurbain(std::string nomReseau, size_t nbVilles) :
-            nomReseau(nomReseau)
+            nomReseau(nomReseau), versionDense(0), versionToutesPaires(0), versionEtiquettesDuree(0),
+            versionEtiquettesCout(0), versionBalayageDuree(0), versionBalayageCout(0), versionPlanificateur(0),
+            versionMetriques(0), versionAtteignabilite(0), versionVuesArbres(0), versionComposantes(0), composantesIncrementales(false),
+            generationBase(0), seuilCompaction(0), toutesPairesActive(false), threadsToutesPaires(0),
+            etiquettesActives(false)
     {
+        cacheVue.nonNegatifs = true;
+        cacheVue.version = 0;
+
         // Le corps du constructeur est vide car aucune initialisation supplémentaire n'est nécessaire.
     }
 
@@ -42,20 +337,139 @@ namespace TP2
 
     /**
      * @brief Redimensionne le réseau interurbain.
+     * Un réseau renuméroté est d'abord remis dans l'ordre du fichier, pour que les numéros externes désignent
+     * toujours les mêmes villes et qu'une réduction retire les dernières villes du fichier.
+     * Les origines suivies qui ne sont plus dans le réseau sont abandonnées.
      * @param nouvelleTaille La nouvelle taille du réseau interurbain.
      */
     void ReseauInterurbain::resize(size_t nouvelleTaille) {
+        if (!versExterne.empty())
+        {
+            unReseau.permuterSommets(std::vector<size_t>(versExterne.begin(), versExterne.end()));
+            versInterne.clear();
+            versExterne.clear();
+        }
         unReseau.resize(nouvelleTaille);
+
+        std::lock_guard<std::mutex> verrou(verrouCaches);
+        originesSuivies.erase(std::remove_if(originesSuivies.begin(), originesSuivies.end(),
+                                             [nouvelleTaille](const OrigineSuivie& suivie)
+                                             { return suivie.ville >= nouvelleTaille; }),
+                              originesSuivies.end());
+    }
+
+
+    /**
+     * @brief Vide les caches dérivés du graphe; ils seront reconstruits au prochain besoin.
+     */
+    void ReseauInterurbain::viderCaches()
+    {
+        std::lock_guard<std::mutex> verrou(verrouCaches);
+        cacheVue.vue.reset();
+        cacheDense.reset();
+        cacheToutesPaires.reset();
+        cacheEtiquettesDuree.reset();
+        cacheEtiquettesCout.reset();
+        cacheBalayageDuree.reset();
+        cacheBalayageCout.reset();
+        cachePlanificateur.reset();
+        cacheMetriques.clear();
+        cacheAtteignabilite.reset();
+        composantesSuivies.reset();
+    }
+
+
+    /**
+     * @brief Renumérote les villes en mémoire pour que les voisins d'une ville aient des numéros proches.
+     * Les deux ordres parcourent le graphe non orienté sous-jacent composante par composante; Cuthill-McKee
+     * part d'un sommet de degré minimal, visite les voisins par degrés croissants et renverse l'ordre obtenu.
+     * @param ordre L'ordre à appliquer.
+     */
+    void ReseauInterurbain::renumeroterVilles(OrdreSommets ordre)
+    {
+        if (ordre == OrdreSommets::Fichier)
+        {
+            return;
+        }
+
+        VueAdjacence vue = unReseau.construireVueAdjacence();
+        VueAdjacence inverse = unReseau.construireVueAdjacence(true);
+        size_t n = vue.nbSommets();
+        bool cuthillMcKee = (ordre == OrdreSommets::CuthillMcKeeInverse);
+
+        // Voisins non orientés et degré de chaque sommet
+        auto degre = [&](size_t s) { return vue.debut[s + 1] - vue.debut[s] + inverse.debut[s + 1] - inverse.debut[s]; };
+        auto parDegre = [&](unsigned int a, unsigned int b) { return degre(a) < degre(b) || (degre(a) == degre(b) && a < b); };
+
+        std::vector<unsigned int> departs(n);
+        for (size_t s = 0; s < n; ++s)
+            departs[s] = static_cast<unsigned int>(s);
+        if (cuthillMcKee)
+            std::stable_sort(departs.begin(), departs.end(), parDegre);
+
+        // Parcours en largeur; ordreVisite[k] est l'ancien numéro du k-ième sommet visité
+        std::vector<unsigned int> ordreVisite;
+        ordreVisite.reserve(n);
+        std::vector<bool> visites(n, false);
+        std::vector<unsigned int> voisins;
+        for (auto depart : departs)
+        {
+            if (visites[depart])
+                continue;
+            visites[depart] = true;
+            size_t tete = ordreVisite.size();
+            ordreVisite.push_back(depart);
+            while (tete < ordreVisite.size())
+            {
+                unsigned int sommet = ordreVisite[tete++];
+                voisins.clear();
+                for (size_t a = vue.debut[sommet]; a < vue.debut[sommet + 1]; ++a)
+                    voisins.push_back(vue.destinations[a]);
+                for (size_t a = inverse.debut[sommet]; a < inverse.debut[sommet + 1]; ++a)
+                    voisins.push_back(inverse.destinations[a]);
+                if (cuthillMcKee)
+                    std::sort(voisins.begin(), voisins.end(), parDegre);
+                for (auto voisin : voisins)
+                {
+                    if (!visites[voisin])
+                    {
+                        visites[voisin] = true;
+                        ordreVisite.push_back(voisin);
+                    }
+                }
+            }
+        }
+        if (cuthillMcKee)
+            std::reverse(ordreVisite.begin(), ordreVisite.end());
+
+        std::vector<size_t> nouveauNumero(n);
+        for (size_t k = 0; k < n; ++k)
+            nouveauNumero[ordreVisite[k]] = k;
+        unReseau.permuterSommets(nouveauNumero);
+
+        // Composer avec la renumérotation précédente pour garder les numéros externes
+        std::vector<unsigned int> externes(n);
+        for (size_t k = 0; k < n; ++k)
+            externes[k] = versExterne.empty() ? ordreVisite[k] : versExterne[ordreVisite[k]];
+        versExterne.swap(externes);
+        versInterne.assign(n, 0);
+        for (size_t k = 0; k < n; ++k)
+            versInterne[versExterne[k]] = static_cast<unsigned int>(k);
     }
 
 
-    // Méthode fournie
     /**
      * @brief Charge le réseau interurbain à partir d'un fichier.
+     * Les trajets sont lus par morceaux de TAILLE_LECTURE octets coupés entre deux trajets; chaque morceau est
+     * découpé en parts analysées en parallèle (noms résolus par un index construit avant), puis les parts sont
+     * ajoutées au graphe dans l'ordre du fichier.
      * @param fichierEntree Le fichier d'entrée contenant les données du réseau.
-     * @throws std::logic_error Si le fichier d'entrée n'est pas ouvert.
+     * @param ordre La renumérotation interne à appliquer une fois le réseau chargé.
+     * @param nbThreads Le nombre de threads d'analyse (0 = tous les coeurs).
+     * @throws std::logic_error Si le fichier d'entrée n'est pas ouvert, si un trajet est incomplet, nomme une ville
+     * inconnue ou existe déjà.
      */
-    void ReseauInterurbain::chargerReseau(std::ifstream & fichierEntree)
+    void ReseauInterurbain::chargerReseau(std::ifstream & fichierEntree, OrdreSommets ordre, unsigned int nbThreads)
     {
         if (!fichierEntree.is_open())
             throw std::logic_error("ReseauInterurbain::chargerReseau: Le fichier n'est pas ouvert !");
@@ -70,7 +484,7 @@ namespace TP2
         fichierEntree >> nbVilles;
         getline(fichierEntree, buff); //villes
 
-        unReseau.resize(nbVilles);
+        resize(nbVilles);
 
         getline(fichierEntree, buff); //Liste des villes
 
@@ -85,197 +499,2174 @@ namespace TP2
             i++;
         }
 
-        while(!fichierEntree.eof())
+        // Premier numéro de chaque nom, comme getNumeroSommet
+        std::unordered_map<std::string, unsigned int> index;
+        const size_t n = static_cast<size_t>(unReseau.getNombreSommets());
+        index.reserve(n);
+        for (size_t v = 0; v < n; ++v)
+            index.emplace(unReseau.getNomSommet(v), static_cast<unsigned int>(v));
+
+        const size_t nbParts = nombreThreads(nbThreads);
+        std::vector<std::vector<TrajetLu>> trajets(nbParts);
+        std::vector<size_t> coupures;
+        std::string tampon;	// Octets lus et pas encore analysés (au plus un trajet incomplet entre deux morceaux)
+        size_t nbLignes = 0;	// Sauts de ligne de tampon déjà parcourus
+        size_t parcouru = 0;
+
+        bool finFichier = false;
+        while (!finFichier)
         {
-            getline(fichierEntree, buff);
-            std::string source = buff;
-            getline(fichierEntree, buff);
-            std::string destination = buff;
+            size_t taille = tampon.size();
+            tampon.resize(taille + TAILLE_LECTURE);
+            fichierEntree.read(&tampon[taille], TAILLE_LECTURE);
+            tampon.resize(taille + static_cast<size_t>(fichierEntree.gcount()));
+            finFichier = !fichierEntree;
 
-            getline(fichierEntree, buff);
-            std::istringstream iss(buff);
+            // Coupures aux fins de trajets (tous les 3 sauts de ligne), une part par thread au plus
+            const size_t cible = tampon.size() / nbParts + 1;
+            coupures.assign(1, 0);
+            size_t finTrajets = 0;
+            while (parcouru < tampon.size())
+            {
+                const char* saut = static_cast<const char*>(std::memchr(tampon.data() + parcouru, '\n', tampon.size() - parcouru));
+                if (!saut)
+                {
+                    parcouru = tampon.size();
+                    break;
+                }
+                parcouru = static_cast<size_t>(saut - tampon.data()) + 1;
+                if (++nbLignes % 3 == 0)
+                {
+                    finTrajets = parcouru;
+                    if (finTrajets >= coupures.back() + cible && coupures.size() < nbParts)
+                        coupures.push_back(finTrajets);
+                }
+            }
 
-            float duree;
-            iss >> duree;
+            if (finFichier)
+            {
+                // Le dernier trajet n'a pas de saut de ligne final; au-delà, seuls des blancs sont tolérés
+                size_t reste = finTrajets;
+                if (nbLignes % 3 == 2 && tampon.size() > finTrajets && tampon.back() != '\n')
+                    reste = tampon.size();
+                if (tampon.find_first_not_of(" \t\r\n", reste) != std::string::npos)
+                    throw std::logic_error("ReseauInterurbain::chargerReseau: trajet incomplet en fin de fichier");
+                finTrajets = reste;
+            }
 
-            float cout;
-            iss >> cout;
+            if (coupures.back() < finTrajets)
+                coupures.push_back(finTrajets);
+            else
+                coupures.back() = finTrajets;
+
+            executerEnParallele(coupures.size() - 1, [&](size_t k, unsigned int)
+            {
+                trajets[k].clear();
+                analyserTrajets(tampon.data() + coupures[k], tampon.data() + coupures[k + 1], index, trajets[k]);
+            }, nbThreads);
 
-            unReseau.ajouterArc(unReseau.getNumeroSommet(source), unReseau.getNumeroSommet(destination), duree, cout);
+            for (size_t k = 0; k + 1 < coupures.size(); ++k)
+                for (const TrajetLu& trajet : trajets[k])
+                    unReseau.ajouterArc(trajet.source, trajet.destination, trajet.duree, trajet.cout);
+
+            tampon.erase(0, finTrajets);
+            parcouru -= finTrajets;
+            nbLignes %= 3;
         }
+
+        renumeroterVilles(ordre);
     }
 
     /**
-     * @brief Algorithme Djikstra pour la recherche du chemin le plus court ou le moins coûteux entre deux villes du réseau en utilisant l'algorithme de Dijkstra.
-     * @param source La ville de départ.
-     * @param destination La ville d'arrivée.
-     * @param dureeCout Indicateur spécifiant si le critère de recherche est la durée (true) ou le coût (false).
-     * @return Le chemin trouvé.
-     * @throws std::logic_error Si la ville source est hors du réseau, si la ville destination est hors du réseau, ou si tous les arcs ne sont pas non négatifs.
+     * @brief Écrit le réseau au format texte de chargerReseau.
+     * Chaque pondération est écrite avec le moins de chiffres qui la relisent exactement.
+     * @param fichierSortie Le fichier de sortie.
+     * @throws std::logic_error Si le fichier de sortie n'est pas ouvert.
      */
-    Chemin ReseauInterurbain::rechercheCheminDijkstra(const std::string& source, const std::string& destination, bool dureeCout) const
+    void ReseauInterurbain::sauvegarderReseau(std::ofstream & fichierSortie) const
     {
-        // Vérifier si la ville source est hors du réseau
-        if (static_cast<int>(unReseau.getNumeroSommet(source)) > unReseau.getNombreSommets())
-        {
-            throw std::logic_error("rechercheCheminDijkstra : source hors du réseau");
-        }
-        // Vérifier si la ville destination est hors du réseau
-        if (static_cast<int>(unReseau.getNumeroSommet(destination)) > unReseau.getNombreSommets())
-        {
-            throw std::logic_error("rechercheCheminDijkstra : destination hors réseau");
-        }
-        // Vérifier si tous les arcs sont non négatifs
-        if (!unReseau.arcsSontNonNegatifs())
-        {
-            throw std::logic_error("rechercheCheminDijkstra : les arcs ne sont pas tous non négatifs");
-        }
-        // Récupérer les numéros de sommet correspondant à la source et à la destination
-        auto numero_source = unReseau.getNumeroSommet(source);
-        auto numero_destination = unReseau.getNumeroSommet(destination);
-
-        // Tableaux pour stocker les distances minimales et les prédécesseurs des sommets
-        std::vector<float> distances(unReseau.getNombreSommets(), MAX);
-        std::vector<unsigned int> predecesseurs(unReseau.getNombreSommets(), MAX);
-
-        // Tableau pour indiquer si les sommets ont été solutionnés ou non
-        std::vector<bool> solutionnes(unReseau.getNombreSommets(), false);
-
-        // Initialisation de la distance de la source à 0
-        distances[numero_source] = 0.0;
-
-        // Boucle principale de l'algorithme de Dijkstra
-        for (auto i = 0; i < unReseau.getNombreSommets(); i++) {
-
-            float minimum = MAX;
-            unsigned int voisin = 0;
+        if (!fichierSortie.is_open())
+            throw std::logic_error("ReseauInterurbain::sauvegarderReseau: Le fichier n'est pas ouvert !");
 
-            // Recherche du sommet non solutionné avec la distance minimale
-            for (auto j = 0; j < unReseau.getNombreSommets(); j++) {
-                if (!solutionnes[j] && distances[j] < minimum) {
-                    minimum = distances[j];
-                    voisin = j;
-                }
+        auto texte = [](float valeur)
+        {
+            std::ostringstream oss;
+            for (int precision = 6; precision <= 9; ++precision)
+            {
+                oss.str("");
+                oss << std::setprecision(precision) << valeur;
+                std::istringstream iss(oss.str());
+                float relue;
+                if (iss >> relue && relue == valeur)
+                    break;
             }
+            return oss.str();
+        };
 
-            // Marquer le sommet comme solutionné
-            solutionnes[voisin] = true;
+        size_t n = getNombreVilles();
+        fichierSortie << "Reseau Interurbain: " << nomReseau << "\n" << n << " villes\nListe des villes:\n";
+        for (size_t ville = 0; ville < n; ++ville)
+            fichierSortie << getNomVille(ville) << "\n";
+        fichierSortie << "Liste des trajets:";
 
-            // Parcourir les sommets adjacents au sommet solutionné
-            for (auto v : unReseau.listerSommetsAdjacents(voisin)) {
-                if (!solutionnes[v]) {
-                    float tmp;
-                    if (dureeCout) {
-                        // Calculer la distance temporaire en ajoutant la durée de l'arc au sommet solutionné
-                        tmp = distances[voisin] + unReseau.getPonderationsArc(voisin, v).duree;
-                    }
-                    else {
-                        // Calculer la distance temporaire en ajoutant le coût de l'arc au sommet solutionné
-                        tmp = distances[voisin] + unReseau.getPonderationsArc(voisin, v).cout;
-                    }
-                    // Mettre à jour la distance minimale et le prédécesseur si la distance temporaire est plus petite
-                    if (tmp < distances[v]) {
-                        distances[v] = tmp;
-                        predecesseurs[v] = voisin;
-                    }
-                }
+        // Le lecteur attend trois lignes par trajet après chaque fin de ligne : pas de fin de ligne finale
+        VueAdjacence vue = unReseau.construireVueAdjacence();
+        for (size_t ville = 0; ville < n; ++ville)
+        {
+            size_t u = versInterne.empty() ? ville : versInterne[ville];
+            for (size_t a = vue.debut[u]; a < vue.debut[u + 1]; ++a)
+            {
+                fichierSortie << "\n" << unReseau.getNomSommet(u) << "\n" << unReseau.getNomSommet(vue.destinations[a])
+                              << "\n" << texte(vue.durees[a]) << " " << texte(vue.couts[a]);
             }
         }
+    }
 
-        // Construction du chemin trouvé
-        Chemin cheminTrouve;
+    /**
+     * @brief Ouvre le journal des modifications après avoir restauré l'état qu'il complète.
+     * @param cheminBase Le fichier de l'instantané binaire.
+     * @param cheminJournal Le fichier du journal.
+     * @param seuilCompaction La taille du journal (octets) qui déclenche une compaction (0 = jamais).
+     * @throws std::logic_error Si un fichier est illisible ou corrompu, ou si une modification rejouée échoue.
+     */
+    void ReseauInterurbain::ouvrirJournal(const std::string& cheminBase, const std::string& cheminJournal,
+                                          size_t seuilCompaction)
+    {
+        fermerJournal();
 
-        // Vérifier si un chemin a été trouvé jusqu'à la destination
-        if (distances[numero_destination] == MAX)
+        std::string contenu;
+        uint64_t generation = 0;
+        if (JournalMutations::lireFichier(cheminBase, contenu))
         {
-            cheminTrouve.reussi = false;
+            generation = chargerInstantane(contenu);
         }
         else
         {
-            cheminTrouve.reussi = true;
-            if (dureeCout)
-            {
-                cheminTrouve.dureeTotale = distances[numero_destination];
-            }
-            else
-            {
-                cheminTrouve.coutTotal = distances[numero_destination];
-            }
-
-            // Reconstruction du chemin en remontant les prédécesseurs depuis la destination jusqu'à la source
-            auto sentinelle = numero_destination;
-            std::stack<std::string> villes;
-
-            while (sentinelle != numero_source) {
-                villes.push(unReseau.getNomSommet(sentinelle));
-                sentinelle = predecesseurs[sentinelle];
-            }
+            JournalMutations::ecrireFichierAtomique(cheminBase, instantane(generation));
+        }
 
-            // Ajouter la source et les villes du chemin dans l'objet Chemin
-            cheminTrouve.listeVilles.push_back(source);
-            while (!villes.empty())
-            {
-                cheminTrouve.listeVilles.push_back(villes.top());
-                villes.pop();
-            }
+        std::vector<Mutation> existantes;
+        std::unique_ptr<JournalMutations> ouvert(new JournalMutations(cheminJournal, generation, existantes));
+        for (const auto& mutation : existantes)
+        {
+            appliquer(mutation);
         }
 
-        //Renvoie le chemin trouvé
-        return cheminTrouve;
+        journal = std::move(ouvert);
+        this->cheminBase = cheminBase;
+        generationBase = generation;
+        this->seuilCompaction = seuilCompaction;
     }
 
     /**
-     * @brief Algorithme de Kosaraju pour trouver les composantes fortement connexes du réseau interurbain.
-     * @return Vecteur de vecteurs de chaînes de caractères représentant les composantes fortement connexes.
+     * @brief Écrit sur le disque les modifications journalisées encore en mémoire.
+     * @throws std::logic_error Si aucun journal n'est ouvert ou si l'écriture échoue.
      */
-    std::vector<std::vector<std::string>> ReseauInterurbain::algorithmeKosaraju()
+    void ReseauInterurbain::synchroniserJournal()
     {
-        // Vecteur de composantes fortement connexes
-        std::vector<std::vector<std::string>> composantes;
-
-        // Création du graphe inverse
-        Graphe inverse = unReseau.inverseGraphe();
-
-        // Vecteur pour suivre les sommets visités lors du parcours en profondeur
-        std::vector<bool> sommetsVisites(inverse.getNombreSommets(), false);
-
-        // Parcours en profondeur du graphe inverse
-        auto pile = Graphe::parcoursProfondeur(inverse);
-
-        while (!pile.empty())
+        if (!journal)
         {
-            // Récupération du sommet en haut de la pile
-            auto sommet = pile.top();
-            pile.pop();
-
-            // Vérification si le sommet a déjà été visité
-            if (!sommetsVisites[sommet])
-            {
-                // Exploration du sommet et récupération des sommets de la composante fortement connexe
-                std::stack<unsigned int> resultat;
-                Graphe::explore(sommet, inverse, sommetsVisites, resultat);
-
-                // Création d'une nouvelle composante fortement connexe
-                std::vector<std::string> composante;
-                while (!resultat.empty())
-                {
-                    // Ajout du nom du sommet à la composante
-                    composante.push_back(unReseau.getNomSommet(resultat.top()));
-                    resultat.pop();
-                }
-
-                // Ajout de la composante au vecteur de composantes
-                composantes.push_back(composante);
-            }
+            throw std::logic_error("synchroniserJournal : aucun journal ouvert");
         }
+        journal->synchroniser();
+    }
 
-        return composantes;
+    /**
+     * @brief Intègre le journal dans un nouvel instantané puis vide le journal.
+     * L'instantané de génération g + 1 est écrit (de façon atomique) avant que le journal ne soit vidé :
+     * après un arrêt entre les deux, le journal de génération g est reconnu comme déjà intégré.
+     * @throws std::logic_error Si aucun journal n'est ouvert ou si l'écriture échoue.
+     */
+    void ReseauInterurbain::compacterJournal()
+    {
+        if (!journal)
+        {
+            throw std::logic_error("compacterJournal : aucun journal ouvert");
+        }
+        JournalMutations::ecrireFichierAtomique(cheminBase, instantane(generationBase + 1));
+        generationBase++;
+        journal->reinitialiser(generationBase);
     }
 
-/**
- * @brief Renvoie le nom du réseau interurbain.
- * @return Le nom du réseau interurbain.
- */
+    /**
+     * @brief Synchronise puis ferme le journal.
+     */
+    void ReseauInterurbain::fermerJournal()
+    {
+        if (journal)
+        {
+            journal->synchroniser();
+            journal.reset();
+        }
+    }
+
+    /**
+     * @brief Enregistre une modification déjà appliquée, puis compacte si le journal dépasse le seuil.
+     * @param mutation La modification.
+     */
+    void ReseauInterurbain::journaliser(const Mutation& mutation)
+    {
+        if (!journal)
+            return;
+        journal->ajouter(mutation);
+        if (seuilCompaction != 0 && journal->getTaille() >= seuilCompaction)
+        {
+            compacterJournal();
+        }
+    }
+
+    /**
+     * @brief Sérialise le réseau : en-tête, nom, noms des villes et trajets (numéros externes), somme de contrôle.
+     * @param generation La génération de l'instantané.
+     * @return Le contenu binaire de l'instantané.
+     */
+    std::string ReseauInterurbain::instantane(uint64_t generation) const
+    {
+        std::string contenu(SIGNATURE_INSTANTANE, sizeof(SIGNATURE_INSTANTANE));
+        ecrireBinaire(contenu, generation);
+        ecrireBinaire(contenu, static_cast<uint32_t>(nomReseau.size()));
+        contenu += nomReseau;
+
+        size_t n = getNombreVilles();
+        ecrireBinaire(contenu, static_cast<uint32_t>(n));
+        for (size_t ville = 0; ville < n; ++ville)
+        {
+            const std::string& nom = getNomVille(ville);
+            ecrireBinaire(contenu, static_cast<uint32_t>(nom.size()));
+            contenu += nom;
+        }
+
+        VueAdjacence vue = unReseau.construireVueAdjacence();
+        ecrireBinaire(contenu, static_cast<uint64_t>(vue.destinations.size()));
+        for (size_t u = 0; u < n; ++u)
+        {
+            for (size_t a = vue.debut[u]; a < vue.debut[u + 1]; ++a)
+            {
+                unsigned int v = vue.destinations[a];
+                ecrireBinaire(contenu, static_cast<uint32_t>(versExterne.empty() ? u : versExterne[u]));
+                ecrireBinaire(contenu, static_cast<uint32_t>(versExterne.empty() ? v : versExterne[v]));
+                ecrireBinaire(contenu, vue.durees[a]);
+                ecrireBinaire(contenu, vue.couts[a]);
+            }
+        }
+
+        ecrireBinaire(contenu, JournalMutations::sommeControle(contenu.data(), contenu.size()));
+        return contenu;
+    }
+
+    /**
+     * @brief Remplace le réseau par le contenu d'un instantané (villes dans l'ordre de leurs numéros).
+     * @param contenu Le contenu binaire de l'instantané.
+     * @return La génération de l'instantané.
+     * @throws std::logic_error Si l'instantané est tronqué ou corrompu.
+     */
+    uint64_t ReseauInterurbain::chargerInstantane(const std::string& contenu)
+    {
+        uint32_t somme;
+        size_t fin = contenu.size() - sizeof(somme);
+        if (contenu.size() < sizeof(SIGNATURE_INSTANTANE) + sizeof(somme)
+            || contenu.compare(0, sizeof(SIGNATURE_INSTANTANE), SIGNATURE_INSTANTANE, sizeof(SIGNATURE_INSTANTANE)) != 0)
+        {
+            throw std::logic_error("chargerInstantane : ce n'est pas un instantané de réseau");
+        }
+        std::memcpy(&somme, contenu.data() + fin, sizeof(somme));
+        if (somme != JournalMutations::sommeControle(contenu.data(), fin))
+        {
+            throw std::logic_error("chargerInstantane : instantané corrompu");
+        }
+
+        size_t position = sizeof(SIGNATURE_INSTANTANE);
+        auto texte = [&](std::string& valeur)
+        {
+            uint32_t longueur = lireBinaire<uint32_t>(contenu, position, fin);
+            if (fin - position < longueur)
+                throw std::logic_error("chargerInstantane : instantané tronqué");
+            valeur.assign(contenu, position, longueur);
+            position += longueur;
+        };
+
+        uint64_t generation = lireBinaire<uint64_t>(contenu, position, fin);
+        std::string nom;
+        texte(nom);
+        uint32_t n = lireBinaire<uint32_t>(contenu, position, fin);
+
+        unReseau.resize(0);
+        resize(n);
+        nomReseau = nom;
+        for (uint32_t ville = 0; ville < n; ++ville)
+        {
+            texte(nom);
+            unReseau.nommer(ville, nom);
+        }
+
+        uint64_t nbArcs = lireBinaire<uint64_t>(contenu, position, fin);
+        for (uint64_t a = 0; a < nbArcs; ++a)
+        {
+            uint32_t source = lireBinaire<uint32_t>(contenu, position, fin);
+            uint32_t destination = lireBinaire<uint32_t>(contenu, position, fin);
+            float duree = lireBinaire<float>(contenu, position, fin);
+            float cout = lireBinaire<float>(contenu, position, fin);
+            unReseau.ajouterArc(source, destination, duree, cout);
+        }
+        return generation;
+    }
+
+    /**
+     * @brief Algorithme Djikstra pour la recherche du chemin le plus court ou le moins coûteux entre deux villes du réseau.
+     * Le moteur (dense ou tas) est choisi automatiquement selon la taille du réseau.
+     * @param source La ville de départ.
+     * @param destination La ville d'arrivée.
+     * @param dureeCout Indicateur spécifiant si le critère de recherche est la durée (true) ou le coût (false).
+     * @return Le chemin trouvé.
+     * @throws std::logic_error Si la ville source est hors du réseau, si la ville destination est hors du réseau, ou si tous les arcs ne sont pas non négatifs.
+     */
+    Chemin ReseauInterurbain::rechercheCheminDijkstra(const std::string& source, const std::string& destination, bool dureeCout) const
+    {
+        return rechercheCheminDijkstra(source, destination, dureeCout, MoteurRecherche::Automatique);
+    }
+
+    /**
+     * @brief Recherche du plus court chemin entre deux villes avec le moteur demandé.
+     * @param source La ville de départ.
+     * @param destination La ville d'arrivée.
+     * @param dureeCout Indicateur spécifiant si le critère de recherche est la durée (true) ou le coût (false).
+     * @param moteur Le moteur à utiliser.
+     * @return Le chemin trouvé.
+     * @throws std::logic_error Si la ville source ou destination est hors du réseau, ou si un arc est négatif.
+     */
+    Chemin ReseauInterurbain::rechercheCheminDijkstra(const std::string& source, const std::string& destination, bool dureeCout,
+                                                      MoteurRecherche moteur) const
+    {
+        if (moteur == MoteurRecherche::Reference)
+        {
+            return rechercheCheminReference(source, destination, dureeCout);
+        }
+
+        // getNumeroSommet lance logic_error si la ville est absente du réseau
+        size_t numeroSource = unReseau.getNumeroSommet(source);
+        size_t numeroDestination = unReseau.getNumeroSommet(destination);
+
+        static thread_local TamponChemin tampon;
+        float total;
+        Chemin cheminTrouve;
+        cheminTrouve.dureeTotale = 0.0;
+        cheminTrouve.coutTotal = 0.0;
+        cheminTrouve.reussi = calculerChemin(numeroSource, numeroDestination, dureeCout, moteur, tampon, total);
+
+        if (cheminTrouve.reussi)
+        {
+            if (dureeCout)
+            {
+                cheminTrouve.dureeTotale = total;
+            }
+            else
+            {
+                cheminTrouve.coutTotal = total;
+            }
+
+            cheminTrouve.listeVilles.reserve(tampon.sommets.size());
+            for (auto sommet : tampon.sommets)
+            {
+                cheminTrouve.listeVilles.push_back(unReseau.getNomSommet(sommet));
+            }
+        }
+
+        return cheminTrouve;
+    }
+
+    /**
+     * @brief Recherche du plus court chemin entre deux villes désignées par leurs numéros, sans copier de noms.
+     * @param origine Le numéro de la ville de départ.
+     * @param destination Le numéro de la ville d'arrivée.
+     * @param dureeCout Indicateur spécifiant si le critère de recherche est la durée (true) ou le coût (false).
+     * @param tampon Le tampon de l'appelant qui reçoit les villes et les pondérations de chaque trajet.
+     * @param moteur Le moteur à utiliser.
+     * @return Le chemin trouvé, qui référence le tampon.
+     * @throws std::logic_error Si un numéro est hors du réseau, si un arc est négatif ou si moteur vaut Reference.
+     */
+    CheminIds ReseauInterurbain::rechercheCheminIds(size_t origine, size_t destination, bool dureeCout,
+                                                    TamponChemin& tampon, MoteurRecherche moteur) const
+    {
+        if (origine >= getNombreVilles() || destination >= getNombreVilles())
+        {
+            throw std::logic_error("rechercheCheminIds : ville hors du réseau");
+        }
+        if (!versInterne.empty())
+        {
+            origine = versInterne[origine];
+            destination = versInterne[destination];
+        }
+        if (moteur == MoteurRecherche::Reference)
+        {
+            throw std::logic_error("rechercheCheminIds : le moteur de référence n'est disponible que par noms");
+        }
+
+        CheminIds cheminTrouve;
+        cheminTrouve.tampon = &tampon;
+        cheminTrouve.graphe = &unReseau;
+        cheminTrouve.versExterne = versExterne.empty() ? nullptr : &versExterne;
+        cheminTrouve.reussi = calculerChemin(origine, destination, dureeCout, moteur, tampon, cheminTrouve.total);
+        return cheminTrouve;
+    }
+
+    /**
+     * @brief Calcule le plus court chemin avec le moteur demandé et l'écrit dans le tampon.
+     * @param source Le numéro du sommet de départ.
+     * @param destination Le numéro du sommet d'arrivée.
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @param moteur Le moteur à utiliser (tous sauf Reference). Automatique lit l'arbre de la source si elle est suivie.
+     * @param tampon Reçoit les sommets du chemin et la pondération de chaque trajet.
+     * @param total Reçoit la durée ou le coût total.
+     * @return true si la destination est atteignable.
+     * @throws std::logic_error Si un arc est négatif.
+     */
+    bool ReseauInterurbain::calculerChemin(size_t source, size_t destination, bool dureeCout, MoteurRecherche moteur,
+                                           TamponChemin& tampon, float& total) const
+    {
+        tampon.sommets.clear();
+        tampon.troncons.clear();
+        total = 0.0;
+
+        CacheVue courante = vueCourante();
+        if (!courante.nonNegatifs)
+        {
+            throw std::logic_error("rechercheCheminDijkstra : les arcs ne sont pas tous non négatifs");
+        }
+        std::shared_ptr<const ArbreDynamique> arbre;
+        if (moteur == MoteurRecherche::Automatique || moteur == MoteurRecherche::Dynamique)
+        {
+            arbre = arbreSuivi(source, dureeCout);
+            if (arbre)
+            {
+                moteur = MoteurRecherche::Dynamique;
+            }
+            else if (moteur == MoteurRecherche::Dynamique)
+            {
+                throw std::logic_error("rechercheCheminDijkstra : l'origine n'est pas suivie");
+            }
+            else
+            {
+                moteur = moteurAutomatique();
+            }
+        }
+
+        if (moteur == MoteurRecherche::Dynamique)
+        {
+            // Lecture dans l'arbre de l'origine suivie
+            total = arbre->getDistance(destination);
+            if (total == INFINI)
+            {
+                total = 0.0;
+                return false;
+            }
+            for (size_t sentinelle = destination; sentinelle != source; sentinelle = arbre->getPredecesseur(sentinelle))
+            {
+                tampon.sommets.push_back(static_cast<unsigned int>(sentinelle));
+            }
+            tampon.sommets.push_back(static_cast<unsigned int>(source));
+            std::reverse(tampon.sommets.begin(), tampon.sommets.end());
+        }
+        else if (moteur == MoteurRecherche::ToutesPaires)
+        {
+            // Lecture dans la table, puis on suit les prochains sommets jusqu'à la destination
+            auto table = tableCourante();
+            const std::vector<float>& distances = dureeCout ? table->durees : table->couts;
+            const std::vector<unsigned int>& suivants = dureeCout ? table->suivantsDuree : table->suivantsCout;
+            total = distances[source * table->n + destination];
+            if (total == INFINI)
+            {
+                total = 0.0;
+                return false;
+            }
+            tampon.sommets.push_back(static_cast<unsigned int>(source));
+            for (size_t sommet = source; sommet != destination; )
+            {
+                if (tampon.sommets.size() > table->n)
+                {
+                    throw std::logic_error("rechercheCheminDijkstra : les prochains sommets de la table bouclent");
+                }
+                sommet = suivants[sommet * table->n + destination];
+                tampon.sommets.push_back(static_cast<unsigned int>(sommet));
+            }
+        }
+        else if (moteur == MoteurRecherche::Etiquettes)
+        {
+            // Fusion des étiquettes, puis dépliage du chemin par les voisins vers le meilleur hub
+            auto etiquettes = etiquettesCourantes(dureeCout);
+            if (!etiquettes->chemin(static_cast<unsigned int>(source), static_cast<unsigned int>(destination),
+                                    tampon.sommets))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            // Réponse immédiate quand aucun chemin n'existe, sans explorer la partie atteignable du réseau
+            if (!atteignable(*indexCourant(), source, destination))
+            {
+                return false;
+            }
+
+            // Espaces de travail réutilisés d'une requête à l'autre par chaque thread
+            static thread_local std::vector<float> distances;
+            static thread_local std::vector<unsigned int> predecesseurs;
+            if (moteur == MoteurRecherche::Dense)
+            {
+                dijkstraDense(*matriceCourante(), source, destination, dureeCout, distances, predecesseurs);
+            }
+            else
+            {
+                dijkstraTas(*courante.vue, source, destination, dureeCout, distances, predecesseurs);
+            }
+            if (distances[destination] == INFINI)
+            {
+                return false;
+            }
+            total = distances[destination];
+
+            // Remonter de la destination jusqu'à la source, puis renverser
+            for (size_t sentinelle = destination; sentinelle != source; sentinelle = predecesseurs[sentinelle])
+            {
+                tampon.sommets.push_back(static_cast<unsigned int>(sentinelle));
+            }
+            tampon.sommets.push_back(static_cast<unsigned int>(source));
+            std::reverse(tampon.sommets.begin(), tampon.sommets.end());
+        }
+
+        // Pondération de chaque trajet du chemin, sommées dans l'ordre du chemin comme le fait Dijkstra
+        const VueAdjacence& vue = *courante.vue;
+        const std::vector<float>& poids = vue.ponderations(dureeCout);
+        float somme = 0.0;
+        for (size_t i = 0; i + 1 < tampon.sommets.size(); ++i)
+        {
+            unsigned int u = tampon.sommets[i];
+            size_t a = vue.debut[u];
+            while (vue.destinations[a] != tampon.sommets[i + 1])
+            {
+                ++a;
+            }
+            tampon.troncons.push_back(poids[a]);
+            somme += poids[a];
+        }
+
+        // La valeur de la table ou des étiquettes peut différer d'un ulp (autre ordre d'addition) : on retourne
+        // la somme du chemin
+        if (moteur == MoteurRecherche::ToutesPaires || moteur == MoteurRecherche::Etiquettes)
+        {
+            total = somme;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Choisit le moteur le moins coûteux pour le réseau courant.
+     * Le balayage dense coûte environ V² / 8 opérations vectorielles, le tas (V + E) log V;
+     * le mode dense est retenu tant que la matrice reste petite et que le balayage n'est pas plus cher.
+     * Si la table de toutes les paires est activée (et le réseau assez petit), elle est toujours préférée, puis
+     * les étiquettes de hubs si elles sont activées.
+     * @return Le moteur retenu.
+     */
+    MoteurRecherche ReseauInterurbain::moteurAutomatique() const
+    {
+        double n = unReseau.getNombreSommets();
+        double m = unReseau.getNombreArcs();
+        if (toutesPairesActive && n <= SEUIL_TOUTES_PAIRES)
+        {
+            return MoteurRecherche::ToutesPaires;
+        }
+        if (etiquettesActives)
+        {
+            return MoteurRecherche::Etiquettes;
+        }
+        if (n <= SEUIL_DENSE && n * n <= 32.0 * (n + m) * std::log2(n + 2.0))
+        {
+            return MoteurRecherche::Dense;
+        }
+        return MoteurRecherche::Tas;
+    }
+
+    /**
+     * @brief Active ou désactive la table de toutes les paires.
+     * @param active true pour répondre aux recherches par lecture dans la table.
+     * @param nbThreads Le nombre de threads utilisés pour construire la table (0 = tous les coeurs).
+     */
+    void ReseauInterurbain::activerTableToutesPaires(bool active, unsigned int nbThreads)
+    {
+        std::lock_guard<std::mutex> verrou(verrouCaches);
+        toutesPairesActive = active;
+        threadsToutesPaires = nbThreads;
+        if (!active)
+        {
+            cacheToutesPaires.reset();
+        }
+    }
+
+    /**
+     * @brief Modifie les pondérations d'un trajet et répare les arbres des origines suivies.
+     * @param source La ville de départ du trajet.
+     * @param destination La ville d'arrivée du trajet.
+     * @param duree La nouvelle durée du trajet.
+     * @param cout Le nouveau coût du trajet.
+     * @throws std::logic_error Si une ville est absente du réseau ou si le trajet n'existe pas.
+     */
+    void ReseauInterurbain::modifierPonderations(const std::string& source, const std::string& destination,
+                                                 float duree, float cout)
+    {
+        Mutation mutation;
+        mutation.type = TypeMutation::ModificationPonderations;
+        mutation.source = static_cast<uint32_t>(getNumeroVille(source));
+        mutation.destination = static_cast<uint32_t>(getNumeroVille(destination));
+        mutation.duree = duree;
+        mutation.cout = cout;
+        appliquer(mutation);
+        journaliser(mutation);
+    }
+
+    /**
+     * @brief Ajoute une origine dont les arbres des plus courts chemins sont maintenus.
+     * @param origine La ville d'origine.
+     * @throws std::logic_error Si la ville est absente du réseau.
+     */
+    void ReseauInterurbain::suivreOrigine(const std::string& origine)
+    {
+        size_t ville = getNumeroVille(origine);
+
+        std::lock_guard<std::mutex> verrou(verrouCaches);
+        for (const auto& suivie : originesSuivies)
+        {
+            if (suivie.ville == ville)
+                return;
+        }
+
+        // Arbres construits au premier besoin (version 0 : périmés)
+        OrigineSuivie suivie;
+        suivie.ville = ville;
+        suivie.version = 0;
+        originesSuivies.push_back(suivie);
+    }
+
+    /**
+     * @brief Retourne l'arbre d'une origine suivie, reconstruit s'il ne correspond plus au graphe.
+     * @param source Le numéro interne de l'origine.
+     * @param dureeCout Le critère.
+     * @return L'arbre, ou nullptr si l'origine n'est pas suivie.
+     */
+    std::shared_ptr<const ArbreDynamique> ReseauInterurbain::arbreSuivi(size_t source, bool dureeCout) const
+    {
+        std::lock_guard<std::mutex> verrou(verrouCaches);
+        const size_t n = getNombreVilles();
+        for (auto& suivie : originesSuivies)
+        {
+            if (suivie.ville >= n)
+                continue;
+            size_t interne = versInterne.empty() ? suivie.ville : versInterne[suivie.ville];
+            if (interne != source)
+                continue;
+            if (!suivie.arbreDuree || suivie.version != unReseau.getVersion())
+            {
+                if (!vuesArbres || versionVuesArbres != unReseau.getVersion())
+                {
+                    // Les arbres périmés libèrent l'ancienne copie; ils seront reconstruits sur la nouvelle
+                    for (auto& autre : originesSuivies)
+                    {
+                        if (autre.version != unReseau.getVersion())
+                        {
+                            autre.arbreDuree.reset();
+                            autre.arbreCout.reset();
+                        }
+                    }
+                    vuesArbres.reset();
+                    vuesArbres = std::make_shared<VuesArbres>(unReseau);
+                    versionVuesArbres = unReseau.getVersion();
+                }
+                suivie.arbreDuree = std::make_shared<ArbreDynamique>(vuesArbres, source, true);
+                suivie.arbreCout = std::make_shared<ArbreDynamique>(vuesArbres, source, false);
+                suivie.version = unReseau.getVersion();
+            }
+            return dureeCout ? suivie.arbreDuree : suivie.arbreCout;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Balayage scalaire O(V²) d'origine, conservé comme référence pour les autres moteurs.
+     * @param source La ville de départ.
+     * @param destination La ville d'arrivée.
+     * @param dureeCout Indicateur spécifiant si le critère de recherche est la durée (true) ou le coût (false).
+     * @return Le chemin trouvé.
+     * @throws std::logic_error Si la ville source est hors du réseau, si la ville destination est hors du réseau, ou si tous les arcs ne sont pas non négatifs.
+     */
+    Chemin ReseauInterurbain::rechercheCheminReference(const std::string& source, const std::string& destination, bool dureeCout) const
+    {
+        // Vérifier si la ville source est hors du réseau
+        if (static_cast<int>(unReseau.getNumeroSommet(source)) > unReseau.getNombreSommets())
+        {
+            throw std::logic_error("rechercheCheminDijkstra : source hors du réseau");
+        }
+        // Vérifier si la ville destination est hors du réseau
+        if (static_cast<int>(unReseau.getNumeroSommet(destination)) > unReseau.getNombreSommets())
+        {
+            throw std::logic_error("rechercheCheminDijkstra : destination hors réseau");
+        }
+        // Vérifier si tous les arcs sont non négatifs
+        if (!unReseau.arcsSontNonNegatifs())
+        {
+            throw std::logic_error("rechercheCheminDijkstra : les arcs ne sont pas tous non négatifs");
+        }
+        // Récupérer les numéros de sommet correspondant à la source et à la destination
+        auto numero_source = unReseau.getNumeroSommet(source);
+        auto numero_destination = unReseau.getNumeroSommet(destination);
+
+        // Tableaux pour stocker les distances minimales et les prédécesseurs des sommets
+        std::vector<float> distances(unReseau.getNombreSommets(), MAX);
+        std::vector<unsigned int> predecesseurs(unReseau.getNombreSommets(), MAX);
+
+        // Tableau pour indiquer si les sommets ont été solutionnés ou non
+        std::vector<bool> solutionnes(unReseau.getNombreSommets(), false);
+
+        // Initialisation de la distance de la source à 0
+        distances[numero_source] = 0.0;
+
+        // Boucle principale de l'algorithme de Dijkstra
+        for (auto i = 0; i < unReseau.getNombreSommets(); i++) {
+
+            float minimum = MAX;
+            unsigned int voisin = 0;
+
+            // Recherche du sommet non solutionné avec la distance minimale
+            for (auto j = 0; j < unReseau.getNombreSommets(); j++) {
+                if (!solutionnes[j] && distances[j] < minimum) {
+                    minimum = distances[j];
+                    voisin = j;
+                }
+            }
+
+            // Marquer le sommet comme solutionné
+            solutionnes[voisin] = true;
+
+            // Parcourir les sommets adjacents au sommet solutionné
+            for (auto v : unReseau.listerSommetsAdjacents(voisin)) {
+                if (!solutionnes[v]) {
+                    float tmp;
+                    if (dureeCout) {
+                        // Calculer la distance temporaire en ajoutant la durée de l'arc au sommet solutionné
+                        tmp = distances[voisin] + unReseau.getPonderationsArc(voisin, v).duree;
+                    }
+                    else {
+                        // Calculer la distance temporaire en ajoutant le coût de l'arc au sommet solutionné
+                        tmp = distances[voisin] + unReseau.getPonderationsArc(voisin, v).cout;
+                    }
+                    // Mettre à jour la distance minimale et le prédécesseur si la distance temporaire est plus petite
+                    if (tmp < distances[v]) {
+                        distances[v] = tmp;
+                        predecesseurs[v] = voisin;
+                    }
+                }
+            }
+        }
+
+        // Construction du chemin trouvé
+        Chemin cheminTrouve;
+
+        // Vérifier si un chemin a été trouvé jusqu'à la destination
+        if (distances[numero_destination] == MAX)
+        {
+            cheminTrouve.reussi = false;
+        }
+        else
+        {
+            cheminTrouve.reussi = true;
+            if (dureeCout)
+            {
+                cheminTrouve.dureeTotale = distances[numero_destination];
+            }
+            else
+            {
+                cheminTrouve.coutTotal = distances[numero_destination];
+            }
+
+            // Reconstruction du chemin en remontant les prédécesseurs depuis la destination jusqu'à la source
+            auto sentinelle = numero_destination;
+            std::stack<std::string> villes;
+
+            while (sentinelle != numero_source) {
+                villes.push(unReseau.getNomSommet(sentinelle));
+                sentinelle = predecesseurs[sentinelle];
+            }
+
+            // Ajouter la source et les villes du chemin dans l'objet Chemin
+            cheminTrouve.listeVilles.push_back(source);
+            while (!villes.empty())
+            {
+                cheminTrouve.listeVilles.push_back(villes.top());
+                villes.pop();
+            }
+        }
+
+        //Renvoie le chemin trouvé
+        return cheminTrouve;
+    }
+
+    /**
+     * @brief Retourne la vue d'adjacence du graphe, reconstruite si le graphe a changé depuis le dernier appel.
+     * @return La vue et l'indicateur de pondérations non négatives pour la version courante.
+     */
+    ReseauInterurbain::CacheVue ReseauInterurbain::vueCourante() const
+    {
+        std::lock_guard<std::mutex> verrou(verrouCaches);
+        if (!cacheVue.vue || cacheVue.version != unReseau.getVersion())
+        {
+            cacheVue.vue = std::make_shared<const VueAdjacence>(unReseau.construireVueAdjacence());
+            cacheVue.inverse = std::make_shared<const VueAdjacence>(unReseau.construireVueAdjacence(true));
+            cacheVue.nonNegatifs = unReseau.arcsSontNonNegatifs();
+            cacheVue.version = unReseau.getVersion();
+        }
+        return cacheVue;
+    }
+
+    /**
+     * @brief Retourne la matrice dense des pondérations, reconstruite si le graphe a changé.
+     * @return La matrice des deux critères.
+     * @throws std::logic_error Si le réseau dépasse SEUIL_DENSE villes.
+     */
+    std::shared_ptr<const ReseauInterurbain::MatriceDense> ReseauInterurbain::matriceCourante() const
+    {
+        CacheVue courante = vueCourante();
+
+        std::lock_guard<std::mutex> verrou(verrouCaches);
+        if (cacheDense && versionDense == courante.version)
+        {
+            return cacheDense;
+        }
+
+        const VueAdjacence& vue = *courante.vue;
+        if (vue.nbSommets() > SEUIL_DENSE)
+        {
+            throw std::logic_error("matriceCourante : réseau trop grand pour le moteur dense");
+        }
+
+        auto matrice = std::make_shared<MatriceDense>();
+        matrice->n = vue.nbSommets();
+        matrice->pas = (matrice->n + 7) / 8 * 8;
+        matrice->durees.assign(matrice->n * matrice->pas, INFINI);
+        matrice->couts.assign(matrice->n * matrice->pas, INFINI);
+        for (size_t s = 0; s < matrice->n; ++s)
+        {
+            for (size_t a = vue.debut[s]; a < vue.debut[s + 1]; ++a)
+            {
+                matrice->durees[s * matrice->pas + vue.destinations[a]] = vue.durees[a];
+                matrice->couts[s * matrice->pas + vue.destinations[a]] = vue.couts[a];
+            }
+        }
+
+        cacheDense = matrice;
+        versionDense = courante.version;
+        return cacheDense;
+    }
+
+    /**
+     * @brief Active ou désactive l'index d'étiquettes de hubs.
+     * @param active true pour répondre aux recherches par les étiquettes.
+     */
+    void ReseauInterurbain::activerEtiquettesHubs(bool active)
+    {
+        std::lock_guard<std::mutex> verrou(verrouCaches);
+        etiquettesActives = active;
+        if (!active)
+        {
+            cacheEtiquettesDuree.reset();
+            cacheEtiquettesCout.reset();
+        }
+    }
+
+    /**
+     * @brief Distance entre deux villes lue dans l'index d'étiquettes de hubs.
+     * @param origine Le numéro de la ville de départ.
+     * @param destination Le numéro de la ville d'arrivée.
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @return La distance, +infini si aucun chemin n'existe.
+     * @throws std::logic_error Si une ville est hors du réseau ou si un arc est négatif.
+     */
+    float ReseauInterurbain::distanceEtiquettes(size_t origine, size_t destination, bool dureeCout) const
+    {
+        if (origine >= getNombreVilles() || destination >= getNombreVilles())
+        {
+            throw std::logic_error("distanceEtiquettes : ville hors du réseau");
+        }
+        if (!versInterne.empty())
+        {
+            origine = versInterne[origine];
+            destination = versInterne[destination];
+        }
+        return etiquettesCourantes(dureeCout)->distance(static_cast<unsigned int>(origine),
+                                                        static_cast<unsigned int>(destination));
+    }
+
+    /**
+     * @brief Retourne l'index d'étiquettes de hubs d'un critère, reconstruit si le graphe a changé.
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @return L'index de la version courante du graphe.
+     * @throws std::logic_error Si un arc est négatif.
+     */
+    std::shared_ptr<const EtiquettesHubs> ReseauInterurbain::etiquettesCourantes(bool dureeCout) const
+    {
+        CacheVue courante = vueCourante();
+
+        std::lock_guard<std::mutex> verrou(verrouCaches);
+        std::shared_ptr<const EtiquettesHubs>& cache = dureeCout ? cacheEtiquettesDuree : cacheEtiquettesCout;
+        unsigned long& version = dureeCout ? versionEtiquettesDuree : versionEtiquettesCout;
+        if (cache && version == courante.version)
+        {
+            return cache;
+        }
+        if (!courante.nonNegatifs)
+        {
+            throw std::logic_error("etiquettesCourantes : les arcs ne sont pas tous non négatifs");
+        }
+
+        cache = std::make_shared<EtiquettesHubs>(*courante.vue, *courante.inverse, dureeCout);
+        version = courante.version;
+        return cache;
+    }
+
+    /**
+     * @brief Distances de plusieurs origines vers toutes les villes, par balayages PHAST.
+     * @param origines Les numéros des villes de départ.
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @param distances Reçoit une ligne de getNombreVilles() distances par origine.
+     * @param nbThreads Le nombre de threads (0 = tous les coeurs).
+     * @throws std::logic_error Si une origine est hors du réseau ou si un arc est négatif.
+     */
+    void ReseauInterurbain::distancesMultiOrigines(const std::vector<size_t>& origines, bool dureeCout,
+                                                   std::vector<float>& distances, unsigned int nbThreads) const
+    {
+        const size_t n = getNombreVilles();
+        std::vector<unsigned int> sources(origines.size());
+        for (size_t i = 0; i < origines.size(); ++i)
+        {
+            if (origines[i] >= n)
+            {
+                throw std::logic_error("distancesMultiOrigines : ville hors du réseau");
+            }
+            sources[i] = static_cast<unsigned int>(versInterne.empty() ? origines[i] : versInterne[origines[i]]);
+        }
+
+        balayageCourant(dureeCout)->calculer(sources, distances, nbThreads);
+        if (!versExterne.empty())
+        {
+            std::vector<float> ligne(n);
+            for (size_t i = 0; i < origines.size(); ++i)
+            {
+                float* distancesOrigine = distances.data() + i * n;
+                for (size_t v = 0; v < n; ++v)
+                    ligne[versExterne[v]] = distancesOrigine[v];
+                std::copy(ligne.begin(), ligne.end(), distancesOrigine);
+            }
+        }
+    }
+
+    /**
+     * @brief Retourne la hiérarchie de contraction d'un critère, reconstruite si le graphe a changé.
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @return La hiérarchie de la version courante du graphe.
+     * @throws std::logic_error Si un arc est négatif.
+     */
+    std::shared_ptr<const BalayagePhast> ReseauInterurbain::balayageCourant(bool dureeCout) const
+    {
+        CacheVue courante = vueCourante();
+
+        std::lock_guard<std::mutex> verrou(verrouCaches);
+        std::shared_ptr<const BalayagePhast>& cache = dureeCout ? cacheBalayageDuree : cacheBalayageCout;
+        unsigned long& version = dureeCout ? versionBalayageDuree : versionBalayageCout;
+        if (cache && version == courante.version)
+        {
+            return cache;
+        }
+        if (!courante.nonNegatifs)
+        {
+            throw std::logic_error("balayageCourant : les arcs ne sont pas tous non négatifs");
+        }
+
+        cache = std::make_shared<BalayagePhast>(*courante.vue, dureeCout);
+        version = courante.version;
+        return cache;
+    }
+
+    /**
+     * @brief Plus court chemin pour une pondération combinée, par le planificateur à cellules.
+     * @param origine La ville de départ.
+     * @param destination La ville d'arrivée.
+     * @param coefDuree Le coefficient de la durée.
+     * @param coefCout Le coefficient du coût.
+     * @return Le chemin trouvé, avec sa durée et son coût totaux.
+     * @throws std::logic_error Si une ville est hors du réseau ou si une pondération de la métrique est négative.
+     */
+    Chemin ReseauInterurbain::rechercheCheminPersonnalise(const std::string& origine, const std::string& destination,
+                                                          float coefDuree, float coefCout) const
+    {
+        // getNumeroSommet lance logic_error si la ville est absente du réseau
+        size_t numeroSource = unReseau.getNumeroSommet(origine);
+        size_t numeroDestination = unReseau.getNumeroSommet(destination);
+
+        std::shared_ptr<const PlanificateurCellules> planificateur;
+        auto metrique = metriqueCourante(coefDuree, coefCout, planificateur);
+
+        static thread_local std::vector<unsigned int> sommets;
+        float total;
+        Chemin cheminTrouve;
+        cheminTrouve.dureeTotale = 0.0;
+        cheminTrouve.coutTotal = 0.0;
+        cheminTrouve.reussi = planificateur->chemin(*metrique, static_cast<unsigned int>(numeroSource),
+                                                    static_cast<unsigned int>(numeroDestination), sommets, total);
+        if (cheminTrouve.reussi)
+        {
+            cheminTrouve.listeVilles.reserve(sommets.size());
+            for (size_t i = 0; i < sommets.size(); ++i)
+            {
+                if (i > 0)
+                {
+                    Ponderations p = unReseau.getPonderationsArc(sommets[i - 1], sommets[i]);
+                    cheminTrouve.dureeTotale += p.duree;
+                    cheminTrouve.coutTotal += p.cout;
+                }
+                cheminTrouve.listeVilles.push_back(unReseau.getNomSommet(sommets[i]));
+            }
+        }
+        return cheminTrouve;
+    }
+
+    /**
+     * @brief Retourne une métrique personnalisée du graphe courant. La partition est refaite si la topologie a
+     * changé; les métriques gardées sont oubliées dès que le graphe change.
+     * @param coefDuree Le coefficient de la durée.
+     * @param coefCout Le coefficient du coût.
+     * @param planificateur Reçoit le planificateur de la topologie courante.
+     * @return La métrique de la version courante du graphe.
+     * @throws std::logic_error Si une pondération de la métrique est négative.
+     */
+    std::shared_ptr<const MetriqueCellules> ReseauInterurbain::metriqueCourante(float coefDuree, float coefCout,
+                                                                                std::shared_ptr<const PlanificateurCellules>& planificateur) const
+    {
+        CacheVue courante = vueCourante();
+        unsigned long topologie = unReseau.getVersionTopologie();
+
+        std::lock_guard<std::mutex> verrou(verrouCaches);
+        if (!cachePlanificateur || versionPlanificateur != topologie)
+        {
+            cachePlanificateur = std::make_shared<PlanificateurCellules>(courante.vue, courante.inverse);
+            versionPlanificateur = topologie;
+            cacheMetriques.clear();
+        }
+        if (versionMetriques != courante.version)
+        {
+            cacheMetriques.clear();
+            versionMetriques = courante.version;
+        }
+        planificateur = cachePlanificateur;
+
+        for (const auto& metrique : cacheMetriques)
+        {
+            if (metrique->coefDuree == coefDuree && metrique->coefCout == coefCout)
+            {
+                return metrique;
+            }
+        }
+        auto metrique = cachePlanificateur->personnaliser(*courante.vue, *courante.inverse, coefDuree, coefCout);
+        if (cacheMetriques.size() >= NB_METRIQUES_CELLULES)
+        {
+            cacheMetriques.erase(cacheMetriques.begin());
+        }
+        cacheMetriques.push_back(metrique);
+        return metrique;
+    }
+
+    /**
+     * @brief Retourne la table de toutes les paires, reconstruite (Floyd-Warshall par blocs) si le graphe a changé.
+     * @return La table des deux critères.
+     * @throws std::logic_error Si un arc est négatif ou si le réseau dépasse SEUIL_TOUTES_PAIRES villes.
+     */
+    std::shared_ptr<const ReseauInterurbain::TableToutesPaires> ReseauInterurbain::tableCourante() const
+    {
+        CacheVue courante = vueCourante();
+
+        std::lock_guard<std::mutex> verrou(verrouCaches);
+        if (cacheToutesPaires && versionToutesPaires == courante.version)
+        {
+            return cacheToutesPaires;
+        }
+
+        const VueAdjacence& vue = *courante.vue;
+        if (!courante.nonNegatifs)
+        {
+            throw std::logic_error("tableCourante : les arcs ne sont pas tous non négatifs");
+        }
+        if (vue.nbSommets() > SEUIL_TOUTES_PAIRES)
+        {
+            throw std::logic_error("tableCourante : réseau trop grand pour la table de toutes les paires");
+        }
+
+        auto table = std::make_shared<TableToutesPaires>();
+        size_t n = vue.nbSommets();
+        table->n = n;
+        table->durees.assign(n * n, INFINI);
+        table->couts.assign(n * n, INFINI);
+        table->suivantsDuree.assign(n * n, AUCUN);
+        for (size_t s = 0; s < n; ++s)
+        {
+            table->durees[s * n + s] = 0.0;
+            table->couts[s * n + s] = 0.0;
+            table->suivantsDuree[s * n + s] = static_cast<unsigned int>(s);
+            for (size_t a = vue.debut[s]; a < vue.debut[s + 1]; ++a)
+            {
+                size_t d = vue.destinations[a];
+                if (d == s)
+                    continue;
+                table->durees[s * n + d] = vue.durees[a];
+                table->couts[s * n + d] = vue.couts[a];
+                table->suivantsDuree[s * n + d] = static_cast<unsigned int>(d);
+            }
+        }
+        table->suivantsCout = table->suivantsDuree;
+
+        floydWarshallParBlocs(n, table->durees, table->suivantsDuree, threadsToutesPaires);
+        floydWarshallParBlocs(n, table->couts, table->suivantsCout, threadsToutesPaires);
+
+        cacheToutesPaires = table;
+        versionToutesPaires = courante.version;
+        return cacheToutesPaires;
+    }
+
+    /**
+     * @brief Dijkstra par balayage de la matrice dense.
+     * Les sommets solutionnés sont masqués en mettant leur clé à +infini, ce qui permet de chercher le minimum
+     * et de relâcher une ligne complète sans branchement (8 sommets à la fois avec AVX2).
+     * @param matrice La matrice dense des pondérations.
+     * @param source Le numéro du sommet de départ.
+     * @param destination Le numéro du sommet d'arrivée (la recherche s'arrête dès qu'il est solutionné).
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @param distances Reçoit les distances depuis la source (+infini si non atteint).
+     * @param predecesseurs Reçoit le prédécesseur de chaque sommet (UINT_MAX si aucun).
+     */
+    void ReseauInterurbain::dijkstraDense(const MatriceDense& matrice, size_t source, size_t destination, bool dureeCout,
+                                          std::vector<float>& distances, std::vector<unsigned int>& predecesseurs) const
+    {
+        const size_t pas = matrice.pas;
+        const float* poids = dureeCout ? matrice.durees.data() : matrice.couts.data();
+
+        // Espaces de travail réutilisés d'une requête à l'autre par chaque thread
+        static thread_local VecteurAligne<float> dist;
+        static thread_local VecteurAligne<float> cles;
+        static thread_local VecteurAligne<unsigned int> pred;
+        dist.assign(pas, INFINI);
+        cles.assign(pas, INFINI);
+        pred.assign(pas, AUCUN);
+
+        dist[source] = 0.0;
+        cles[source] = 0.0;
+
+        for (size_t i = 0; i < matrice.n; ++i)
+        {
+            size_t u = indiceMinimum(cles.data(), pas);
+            float distanceU = cles[u];
+            if (distanceU == INFINI)
+            {
+                break;	// Plus aucun sommet atteignable
+            }
+
+            // Marquer le sommet comme solutionné
+            cles[u] = INFINI;
+            if (u == destination)
+            {
+                break;
+            }
+            relacherLigne(poids + u * pas, distanceU, static_cast<unsigned int>(u),
+                          dist.data(), cles.data(), pred.data(), pas);
+        }
+
+        distances.assign(dist.begin(), dist.begin() + matrice.n);
+        predecesseurs.assign(pred.begin(), pred.begin() + matrice.n);
+    }
+
+    /**
+     * @brief Dijkstra avec un tas binaire sur la vue d'adjacence.
+     * @param vue La vue d'adjacence du graphe.
+     * @param source Le numéro du sommet de départ.
+     * @param destination Le numéro du sommet d'arrivée (la recherche s'arrête dès qu'il est solutionné).
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @param distances Reçoit les distances depuis la source (+infini si non atteint).
+     * @param predecesseurs Reçoit le prédécesseur de chaque sommet (UINT_MAX si aucun).
+     */
+    void ReseauInterurbain::dijkstraTas(const VueAdjacence& vue, size_t source, size_t destination, bool dureeCout,
+                                        std::vector<float>& distances, std::vector<unsigned int>& predecesseurs) const
+    {
+        typedef std::pair<float, unsigned int> Entree;
+        const std::vector<float>& poids = vue.ponderations(dureeCout);
+
+        distances.assign(vue.nbSommets(), INFINI);
+        predecesseurs.assign(vue.nbSommets(), AUCUN);
+        std::vector<bool> solutionnes(vue.nbSommets(), false);
+        std::priority_queue<Entree, std::vector<Entree>, std::greater<Entree> > tas;
+
+        distances[source] = 0.0;
+        tas.push(Entree(0.0f, static_cast<unsigned int>(source)));
+
+        while (!tas.empty())
+        {
+            unsigned int u = tas.top().second;
+            tas.pop();
+
+            // Une entrée périmée : le sommet a déjà été solutionné avec une meilleure distance
+            if (solutionnes[u])
+            {
+                continue;
+            }
+            solutionnes[u] = true;
+            if (u == destination)
+            {
+                break;
+            }
+
+            for (size_t a = vue.debut[u]; a < vue.debut[u + 1]; ++a)
+            {
+                unsigned int v = vue.destinations[a];
+                float tmp = distances[u] + poids[a];
+                if (tmp < distances[v])
+                {
+                    distances[v] = tmp;
+                    predecesseurs[v] = u;
+                    tas.push(Entree(tmp, v));
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Algorithme de Kosaraju pour trouver les composantes fortement connexes du réseau interurbain.
+     * Les composantes sont celles de l'index d'accessibilité (calculées une fois par version du réseau).
+     * @return Vecteur de vecteurs de chaînes de caractères représentant les composantes fortement connexes.
+     */
+    std::vector<std::vector<std::string>> ReseauInterurbain::algorithmeKosaraju()
+    {
+        auto index = indexCourant();
+
+        // Vecteur de composantes fortement connexes
+        std::vector<std::vector<std::string>> composantes(index->nbComposantes);
+        for (size_t sommet = 0; sommet < index->composante.size(); ++sommet)
+        {
+            composantes[index->composante[sommet]].push_back(unReseau.getNomSommet(sommet));
+        }
+
+        return composantes;
+    }
+
+    /**
+     * @brief Kosaraju itératif sur les vues d'adjacence.
+     * Un premier parcours en profondeur du graphe inverse donne l'ordre de fin de visite; les sommets sont
+     * ensuite repris du dernier terminé au premier, et chaque parcours du graphe direct lancé depuis un sommet
+     * non visité délimite une composante. La première composante trouvée est un puits du graphe des composantes.
+     * @param vue La vue d'adjacence du graphe.
+     * @param inverse La vue d'adjacence du graphe inverse.
+     * @param composante Reçoit le numéro de composante de chaque sommet.
+     * @return Le nombre de composantes.
+     */
+    size_t ReseauInterurbain::composantesFortementConnexes(const VueAdjacence& vue, const VueAdjacence& inverse,
+                                                           std::vector<unsigned int>& composante)
+    {
+        size_t n = vue.nbSommets();
+
+        // Premier parcours (graphe inverse) : ordre de fin de visite, avec une pile explicite (sommet, prochain arc)
+        std::vector<unsigned int> ordreFin;
+        ordreFin.reserve(n);
+        std::vector<bool> sommetsVisites(n, false);
+        std::vector<std::pair<unsigned int, size_t> > pile;
+        for (size_t depart = 0; depart < n; ++depart)
+        {
+            if (sommetsVisites[depart])
+                continue;
+            sommetsVisites[depart] = true;
+            pile.push_back(std::make_pair(static_cast<unsigned int>(depart), inverse.debut[depart]));
+            while (!pile.empty())
+            {
+                unsigned int sommet = pile.back().first;
+                size_t& arc = pile.back().second;
+                if (arc < inverse.debut[sommet + 1])
+                {
+                    unsigned int voisin = inverse.destinations[arc++];
+                    if (!sommetsVisites[voisin])
+                    {
+                        sommetsVisites[voisin] = true;
+                        pile.push_back(std::make_pair(voisin, inverse.debut[voisin]));
+                    }
+                }
+                else
+                {
+                    ordreFin.push_back(sommet);
+                    pile.pop_back();
+                }
+            }
+        }
+
+        // Second parcours (graphe direct) dans l'ordre de fin décroissant
+        composante.assign(n, AUCUN);
+        unsigned int nbComposantes = 0;
+        std::vector<unsigned int> aVisiter;
+        for (auto itr = ordreFin.rbegin(); itr != ordreFin.rend(); ++itr)
+        {
+            if (composante[*itr] != AUCUN)
+                continue;
+            composante[*itr] = nbComposantes;
+            aVisiter.push_back(*itr);
+            while (!aVisiter.empty())
+            {
+                unsigned int sommet = aVisiter.back();
+                aVisiter.pop_back();
+                for (size_t a = vue.debut[sommet]; a < vue.debut[sommet + 1]; ++a)
+                {
+                    unsigned int voisin = vue.destinations[a];
+                    if (composante[voisin] == AUCUN)
+                    {
+                        composante[voisin] = nbComposantes;
+                        aVisiter.push_back(voisin);
+                    }
+                }
+            }
+            nbComposantes++;
+        }
+
+        return nbComposantes;
+    }
+
+    /**
+     * @brief Villes atteignables depuis une origine sans dépasser un budget de durée ou de coût.
+     * @param origine La ville de départ.
+     * @param budget La durée (heures) ou le coût ($) maximal.
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @return Les noms des villes atteignables, par distance croissante.
+     * @throws std::logic_error Si l'origine est absente du réseau ou si un arc est négatif.
+     */
+    std::vector<std::string> ReseauInterurbain::villesAtteignables(const std::string& origine, float budget,
+                                                                   bool dureeCout) const
+    {
+        size_t source = unReseau.getNumeroSommet(origine);
+        CacheVue courante = vueCourante();
+        if (!courante.nonNegatifs)
+        {
+            throw std::logic_error("villesAtteignables : les arcs ne sont pas tous non négatifs");
+        }
+
+        EspaceRecherche espace;
+        std::vector<unsigned int> atteintes;
+        rechercheBornee(*courante.vue, source, budget, dureeCout, espace, atteintes);
+
+        std::vector<std::string> villes;
+        villes.reserve(atteintes.size());
+        for (auto sommet : atteintes)
+        {
+            villes.push_back(unReseau.getNomSommet(sommet));
+        }
+        return villes;
+    }
+
+    /**
+     * @brief Villes atteignables depuis plusieurs origines, calculées en parallèle.
+     * @param origines Les numéros des villes de départ.
+     * @param budget La durée (heures) ou le coût ($) maximal.
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @param nbThreads Le nombre de threads (0 = tous les coeurs).
+     * @return Pour chaque origine, les numéros triés des villes atteignables.
+     * @throws std::logic_error Si une origine est hors du réseau ou si un arc est négatif.
+     */
+    std::vector<std::vector<unsigned int> > ReseauInterurbain::villesAtteignables(const std::vector<size_t>& origines,
+                                                                                 float budget, bool dureeCout,
+                                                                                 unsigned int nbThreads) const
+    {
+        for (auto origine : origines)
+        {
+            if (origine >= getNombreVilles())
+            {
+                throw std::logic_error("villesAtteignables : origine hors du réseau");
+            }
+        }
+        CacheVue courante = vueCourante();
+        if (!courante.nonNegatifs)
+        {
+            throw std::logic_error("villesAtteignables : les arcs ne sont pas tous non négatifs");
+        }
+
+        std::vector<std::vector<unsigned int> > resultats(origines.size());
+        std::vector<EspaceRecherche> espaces(nombreThreads(nbThreads));
+        executerEnParallele(origines.size(), [&](size_t i, unsigned int numeroThread)
+        {
+            size_t source = versInterne.empty() ? origines[i] : versInterne[origines[i]];
+            std::vector<unsigned int>& atteintes = resultats[i];
+            rechercheBornee(*courante.vue, source, budget, dureeCout, espaces[numeroThread], atteintes);
+            if (!versExterne.empty())
+            {
+                for (auto& sommet : atteintes)
+                    sommet = versExterne[sommet];
+            }
+            std::sort(atteintes.begin(), atteintes.end());
+        }, nbThreads);
+
+        return resultats;
+    }
+
+    /**
+     * @brief Dijkstra arrêté dès que la plus petite distance non solutionnée dépasse le budget.
+     * @param vue La vue d'adjacence.
+     * @param source Le sommet de départ (numéro interne).
+     * @param budget La distance maximale.
+     * @param dureeCout Le critère.
+     * @param espace L'espace de travail (laissé propre pour la recherche suivante).
+     * @param atteintes Reçoit les sommets atteignables par distance croissante.
+     */
+    void ReseauInterurbain::rechercheBornee(const VueAdjacence& vue, size_t source, float budget, bool dureeCout,
+                                            EspaceRecherche& espace, std::vector<unsigned int>& atteintes)
+    {
+        typedef std::pair<float, unsigned int> Entree;
+        const std::vector<float>& poids = vue.ponderations(dureeCout);
+        if (espace.distances.size() != vue.nbSommets())
+        {
+            espace.distances.assign(vue.nbSommets(), INFINI);
+        }
+
+        atteintes.clear();
+        espace.tas.clear();
+        espace.touches.clear();
+        if (budget < 0)
+        {
+            return;
+        }
+
+        espace.distances[source] = 0.0;
+        espace.touches.push_back(static_cast<unsigned int>(source));
+        espace.tas.push_back(Entree(0.0f, static_cast<unsigned int>(source)));
+        while (!espace.tas.empty())
+        {
+            std::pop_heap(espace.tas.begin(), espace.tas.end(), std::greater<Entree>());
+            Entree entree = espace.tas.back();
+            espace.tas.pop_back();
+
+            unsigned int u = entree.second;
+            if (entree.first > espace.distances[u])
+            {
+                continue;	// Entrée périmée
+            }
+            atteintes.push_back(u);
+
+            for (size_t a = vue.debut[u]; a < vue.debut[u + 1]; ++a)
+            {
+                unsigned int v = vue.destinations[a];
+                float tmp = entree.first + poids[a];
+                // Les sommets au-delà du budget ne sont jamais mis dans le tas
+                if (tmp <= budget && tmp < espace.distances[v])
+                {
+                    if (espace.distances[v] == INFINI)
+                    {
+                        espace.touches.push_back(v);
+                    }
+                    espace.distances[v] = tmp;
+                    espace.tas.push_back(Entree(tmp, v));
+                    std::push_heap(espace.tas.begin(), espace.tas.end(), std::greater<Entree>());
+                }
+            }
+        }
+
+        // Remettre à +infini seulement ce qui a été touché
+        for (auto sommet : espace.touches)
+        {
+            espace.distances[sommet] = INFINI;
+        }
+    }
+
+    /**
+     * @brief Hub le plus proche de chaque ville.
+     * Tous les hubs sont placés à distance 0 dans un même tas, puis Dijkstra parcourt le graphe inverse :
+     * la distance obtenue pour une ville est celle de la ville vers le hub le plus proche, et chaque ville
+     * hérite du hub de son prédécesseur.
+     * @param hubs Les noms des hubs (dépôts, pôles de correspondance).
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @return Pour chaque ville (par numéro), son hub le plus proche et la distance.
+     * @throws std::logic_error Si un hub est absent du réseau ou si un arc est négatif.
+     */
+    std::vector<HubLePlusProche> ReseauInterurbain::hubsLesPlusProches(const std::vector<std::string>& hubs,
+                                                                       bool dureeCout) const
+    {
+        typedef std::pair<float, unsigned int> Entree;
+
+        CacheVue courante = vueCourante();
+        if (!courante.nonNegatifs)
+        {
+            throw std::logic_error("hubsLesPlusProches : les arcs ne sont pas tous non négatifs");
+        }
+        const VueAdjacence& inverse = *courante.inverse;
+        const std::vector<float>& poids = inverse.ponderations(dureeCout);
+        size_t n = inverse.nbSommets();
+
+        std::vector<float> distances(n, INFINI);
+        std::vector<unsigned int> hubDe(n, AUCUN);
+        std::priority_queue<Entree, std::vector<Entree>, std::greater<Entree> > tas;
+        for (const auto& nom : hubs)
+        {
+            unsigned int hub = static_cast<unsigned int>(unReseau.getNumeroSommet(nom));
+            if (distances[hub] != 0.0f)
+            {
+                distances[hub] = 0.0;
+                hubDe[hub] = hub;
+                tas.push(Entree(0.0f, hub));
+            }
+        }
+
+        while (!tas.empty())
+        {
+            Entree entree = tas.top();
+            tas.pop();
+            unsigned int u = entree.second;
+            if (entree.first > distances[u])
+            {
+                continue;	// Entrée périmée
+            }
+            for (size_t a = inverse.debut[u]; a < inverse.debut[u + 1]; ++a)
+            {
+                unsigned int v = inverse.destinations[a];
+                float tmp = distances[u] + poids[a];
+                if (tmp < distances[v])
+                {
+                    distances[v] = tmp;
+                    hubDe[v] = hubDe[u];
+                    tas.push(Entree(tmp, v));
+                }
+            }
+        }
+
+        // Résultat indexé par numéro externe
+        std::vector<HubLePlusProche> resultat(n);
+        for (size_t sommet = 0; sommet < n; ++sommet)
+        {
+            size_t ville = versExterne.empty() ? sommet : versExterne[sommet];
+            resultat[ville].distance = distances[sommet];
+            if (hubDe[sommet] == AUCUN)
+                resultat[ville].hub = n;
+            else
+                resultat[ville].hub = versExterne.empty() ? hubDe[sommet] : versExterne[hubDe[sommet]];
+        }
+        return resultat;
+    }
+
+    /**
+     * @brief Plus courts chemins depuis une ville vers toutes les autres (Dijkstra avec tas, sans arrêt anticipé).
+     * @param origine Le numéro de la ville de départ.
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @param distances Reçoit la distance de chaque ville (+infini si non atteignable).
+     * @param predecesseurs Reçoit le prédécesseur de chaque ville (UINT_MAX si aucun).
+     * @throws std::logic_error Si l'origine est hors du réseau ou si un arc est négatif.
+     */
+    void ReseauInterurbain::plusCourtsCheminsDepuis(size_t origine, bool dureeCout, std::vector<float>& distances,
+                                                    std::vector<unsigned int>& predecesseurs) const
+    {
+        if (origine >= getNombreVilles())
+        {
+            throw std::logic_error("plusCourtsCheminsDepuis : origine hors du réseau");
+        }
+        CacheVue courante = vueCourante();
+        if (!courante.nonNegatifs)
+        {
+            throw std::logic_error("plusCourtsCheminsDepuis : les arcs ne sont pas tous non négatifs");
+        }
+
+        size_t source = versInterne.empty() ? origine : versInterne[origine];
+        dijkstraTas(*courante.vue, source, courante.vue->nbSommets(), dureeCout, distances, predecesseurs);
+        predecesseursCanoniques(*courante.vue, *courante.inverse, source, dureeCout, distances, predecesseurs, 1);
+        versNumerosExternes(distances, predecesseurs);
+    }
+
+    /**
+     * @brief Plus courts chemins depuis une ville vers toutes les autres, par delta-stepping parallèle.
+     * @param origine Le numéro de la ville de départ.
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @param distances Reçoit la distance de chaque ville (+infini si non atteignable).
+     * @param predecesseurs Reçoit le prédécesseur de chaque ville (UINT_MAX si aucun).
+     * @param nbThreads Le nombre de threads (0 = tous les coeurs).
+     * @throws std::logic_error Si l'origine est hors du réseau ou si un arc est négatif.
+     */
+    void ReseauInterurbain::plusCourtsCheminsDepuisParallele(size_t origine, bool dureeCout,
+                                                             std::vector<float>& distances,
+                                                             std::vector<unsigned int>& predecesseurs,
+                                                             unsigned int nbThreads) const
+    {
+        if (origine >= getNombreVilles())
+        {
+            throw std::logic_error("plusCourtsCheminsDepuisParallele : origine hors du réseau");
+        }
+        CacheVue courante = vueCourante();
+        if (!courante.nonNegatifs)
+        {
+            throw std::logic_error("plusCourtsCheminsDepuisParallele : les arcs ne sont pas tous non négatifs");
+        }
+
+        size_t source = versInterne.empty() ? origine : versInterne[origine];
+        DeltaStepping moteur(nbThreads);
+        moteur.calculer(*courante.vue, source, dureeCout, distances);
+        predecesseursCanoniques(*courante.vue, *courante.inverse, source, dureeCout, distances, predecesseurs,
+                                nbThreads);
+        versNumerosExternes(distances, predecesseurs);
+    }
+
+    /**
+     * @brief Choisit un prédécesseur pour chaque sommet atteint à partir des seules distances.
+     * Deux moteurs qui calculent les mêmes distances obtiennent ainsi le même arbre, quel que soit l'ordre
+     * de leurs relâchements. Les sommets dont tous les prédécesseurs possibles sont à la même distance (arcs
+     * de poids nul) sont rattachés par un parcours en largeur depuis les sommets déjà rattachés, par numéro croissant.
+     * @param vue La vue d'adjacence du graphe.
+     * @param inverse La vue d'adjacence du graphe inverse.
+     * @param source Le sommet de départ.
+     * @param dureeCout Le critère.
+     * @param distances Les distances depuis source.
+     * @param predecesseurs Reçoit le prédécesseur de chaque sommet (UINT_MAX si aucun).
+     * @param nbThreads Le nombre de threads du premier passage (0 = tous les coeurs).
+     */
+    void ReseauInterurbain::predecesseursCanoniques(const VueAdjacence& vue, const VueAdjacence& inverse,
+                                                    size_t source, bool dureeCout,
+                                                    const std::vector<float>& distances,
+                                                    std::vector<unsigned int>& predecesseurs, unsigned int nbThreads)
+    {
+        const size_t n = inverse.nbSommets();
+        const size_t TAILLE_BLOC = 4096;
+        const std::vector<float>& poidsInverse = inverse.ponderations(dureeCout);
+        predecesseurs.assign(n, AUCUN);
+
+        executerEnParallele((n + TAILLE_BLOC - 1) / TAILLE_BLOC, [&](size_t bloc, unsigned int)
+        {
+            size_t fin = std::min(n, (bloc + 1) * TAILLE_BLOC);
+            for (size_t v = bloc * TAILLE_BLOC; v < fin; ++v)
+            {
+                if (v == source || distances[v] == INFINI)
+                    continue;
+                for (size_t a = inverse.debut[v]; a < inverse.debut[v + 1]; ++a)
+                {
+                    unsigned int u = inverse.destinations[a];
+                    if (distances[u] < distances[v] && distances[u] + poidsInverse[a] == distances[v]
+                        && u < predecesseurs[v])
+                    {
+                        predecesseurs[v] = u;
+                    }
+                }
+            }
+        }, nbThreads);
+
+        // Sommets atteints uniquement par des arcs qui n'augmentent pas la distance
+        const std::vector<float>& poids = vue.ponderations(dureeCout);
+        std::vector<unsigned int> file;
+        for (size_t v = 0; v < n; ++v)
+        {
+            if (v == source || predecesseurs[v] != AUCUN)
+                file.push_back(static_cast<unsigned int>(v));
+        }
+        for (size_t i = 0; i < file.size(); ++i)
+        {
+            unsigned int u = file[i];
+            for (size_t a = vue.debut[u]; a < vue.debut[u + 1]; ++a)
+            {
+                unsigned int v = vue.destinations[a];
+                if (v != source && predecesseurs[v] == AUCUN && distances[v] != INFINI
+                    && distances[u] + poids[a] == distances[v])
+                {
+                    predecesseurs[v] = u;
+                    file.push_back(v);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Réordonne des tableaux indexés par sommet interne selon les numéros de villes.
+     * @param distances Les distances (indice interne, puis externe).
+     * @param predecesseurs Les prédécesseurs (indice et valeur internes, puis externes).
+     */
+    void ReseauInterurbain::versNumerosExternes(std::vector<float>& distances,
+                                                std::vector<unsigned int>& predecesseurs) const
+    {
+        if (versExterne.empty())
+            return;
+
+        std::vector<float> distancesExternes(distances.size());
+        std::vector<unsigned int> predecesseursExternes(predecesseurs.size());
+        for (size_t sommet = 0; sommet < distances.size(); ++sommet)
+        {
+            distancesExternes[versExterne[sommet]] = distances[sommet];
+            predecesseursExternes[versExterne[sommet]] =
+                    predecesseurs[sommet] == AUCUN ? AUCUN : versExterne[predecesseurs[sommet]];
+        }
+        distances.swap(distancesExternes);
+        predecesseurs.swap(predecesseursExternes);
+    }
+
+    /**
+     * @brief Vérifie s'il existe un chemin entre deux villes.
+     * @param origine La ville de départ.
+     * @param destination La ville d'arrivée.
+     * @return true si destination est atteignable depuis origine.
+     * @throws std::logic_error Si origine ou destination est absente du réseau.
+     */
+    bool ReseauInterurbain::estAtteignable(const std::string& origine, const std::string& destination) const
+    {
+        return atteignable(*indexCourant(), unReseau.getNumeroSommet(origine), unReseau.getNumeroSommet(destination));
+    }
+
+    /**
+     * @brief Ajoute un trajet et met à jour les composantes incrémentales.
+     * @param source La ville de départ du trajet.
+     * @param destination La ville d'arrivée du trajet.
+     * @param duree La durée du trajet.
+     * @param cout Le coût du trajet.
+     * @throws std::logic_error Si une ville est absente du réseau ou si le trajet existe déjà.
+     */
+    void ReseauInterurbain::ajouterArc(const std::string& source, const std::string& destination,
+                                       float duree, float cout)
+    {
+        Mutation mutation;
+        mutation.type = TypeMutation::AjoutArc;
+        mutation.source = static_cast<uint32_t>(getNumeroVille(source));
+        mutation.destination = static_cast<uint32_t>(getNumeroVille(destination));
+        mutation.duree = duree;
+        mutation.cout = cout;
+        appliquer(mutation);
+        journaliser(mutation);
+    }
+
+    /**
+     * @brief Retire un trajet; les composantes seront recalculées au prochain besoin.
+     * @param source La ville de départ du trajet.
+     * @param destination La ville d'arrivée du trajet.
+     * @throws std::logic_error Si une ville est absente du réseau ou si le trajet n'existe pas.
+     */
+    void ReseauInterurbain::enleverArc(const std::string& source, const std::string& destination)
+    {
+        Mutation mutation;
+        mutation.type = TypeMutation::RetraitArc;
+        mutation.source = static_cast<uint32_t>(getNumeroVille(source));
+        mutation.destination = static_cast<uint32_t>(getNumeroVille(destination));
+        appliquer(mutation);
+        journaliser(mutation);
+    }
+
+    /**
+     * @brief Donne un nom à une ville.
+     * @param numero Le numéro de la ville (ordre du fichier).
+     * @param nom Le nouveau nom.
+     * @throws std::logic_error Si la ville est hors du réseau.
+     */
+    void ReseauInterurbain::nommer(size_t numero, const std::string& nom)
+    {
+        Mutation mutation;
+        mutation.type = TypeMutation::Nommer;
+        mutation.source = static_cast<uint32_t>(numero);
+        mutation.destination = 0;
+        mutation.nom = nom;
+        appliquer(mutation);
+        journaliser(mutation);
+    }
+
+    /**
+     * @brief Applique une modification au graphe et met à jour les structures incrémentales.
+     * Les arbres des origines suivies sont réparés après un changement de pondérations, les composantes
+     * incrémentales après un ajout de trajet; les autres structures seront reconstruites au prochain besoin.
+     * @param mutation La modification (numéros de villes externes).
+     * @throws std::logic_error Si une ville est hors du réseau ou si le graphe refuse la modification.
+     */
+    void ReseauInterurbain::appliquer(const Mutation& mutation)
+    {
+        size_t n = getNombreVilles();
+        if (mutation.source >= n || (mutation.type != TypeMutation::Nommer && mutation.destination >= n))
+        {
+            throw std::logic_error("ReseauInterurbain : ville hors du réseau");
+        }
+        size_t source = versInterne.empty() ? mutation.source : versInterne[mutation.source];
+        size_t destination = versInterne.empty() ? mutation.destination : versInterne[mutation.destination];
+
+        switch (mutation.type)
+        {
+            case TypeMutation::AjoutArc:
+            {
+                unsigned long avant = unReseau.getVersionTopologie();
+                unReseau.ajouterArc(source, destination, mutation.duree, mutation.cout);
+
+                std::lock_guard<std::mutex> verrou(verrouCaches);
+                if (composantesSuivies && versionComposantes == avant)
+                {
+                    composantesSuivies->ajouterArc(source, destination);
+                    versionComposantes = unReseau.getVersionTopologie();
+                }
+                break;
+            }
+            case TypeMutation::RetraitArc:
+                unReseau.enleverArc(source, destination);
+                break;
+            case TypeMutation::Nommer:
+                unReseau.nommer(source, mutation.nom);
+                break;
+            case TypeMutation::ModificationPonderations:
+            {
+                float duree = mutation.duree;
+                float cout = mutation.cout;
+                unsigned long avant = unReseau.getVersion();
+                unReseau.modifierPonderations(source, destination, duree, cout);
+
+                // Mettre à jour une seule fois la copie partagée, puis réparer les arbres à jour; les autres seront
+                // reconstruits à leur prochaine utilisation
+                std::lock_guard<std::mutex> verrou(verrouCaches);
+                if (!vuesArbres || versionVuesArbres != avant)
+                    break;
+                if (duree < 0 || cout < 0)
+                {
+                    // Reconstruits (et refusés) à la prochaine recherche
+                    vuesArbres.reset();
+                    for (auto& suivie : originesSuivies)
+                    {
+                        suivie.arbreDuree.reset();
+                        suivie.arbreCout.reset();
+                    }
+                    break;
+                }
+                Ponderations anciennes = vuesArbres->modifier(source, destination, duree, cout);
+                versionVuesArbres = unReseau.getVersion();
+                for (auto& suivie : originesSuivies)
+                {
+                    if (!suivie.arbreDuree || suivie.version != avant)
+                        continue;
+                    suivie.arbreDuree->reparer(source, destination, anciennes);
+                    suivie.arbreCout->reparer(source, destination, anciennes);
+                    suivie.version = unReseau.getVersion();
+                }
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief Active ou désactive le maintien incrémental des composantes fortement connexes.
+     * @param active true pour maintenir les composantes lors des ajouts de trajets.
+     */
+    void ReseauInterurbain::activerComposantesIncrementales(bool active)
+    {
+        std::lock_guard<std::mutex> verrou(verrouCaches);
+        composantesIncrementales = active;
+        if (!active)
+        {
+            composantesSuivies.reset();
+        }
+    }
+
+    /**
+     * @brief Vérifie si deux villes sont dans la même composante fortement connexe.
+     * @param ville1 La première ville.
+     * @param ville2 La seconde ville.
+     * @return true si chacune est atteignable depuis l'autre.
+     * @throws std::logic_error Si une ville est absente du réseau.
+     */
+    bool ReseauInterurbain::memeComposante(const std::string& ville1, const std::string& ville2) const
+    {
+        size_t u = unReseau.getNumeroSommet(ville1);
+        size_t v = unReseau.getNumeroSommet(ville2);
+        {
+            std::lock_guard<std::mutex> verrou(verrouCaches);
+            if (composantesSuivies && versionComposantes == unReseau.getVersionTopologie())
+            {
+                return composantesSuivies->memeComposante(u, v);
+            }
+        }
+        auto index = indexCourant();
+        return index->composante[u] == index->composante[v];
+    }
+
+    /**
+     * @brief Retourne le nombre de composantes fortement connexes.
+     * @return Le nombre de composantes de la version courante du réseau.
+     */
+    size_t ReseauInterurbain::getNombreComposantes() const
+    {
+        {
+            std::lock_guard<std::mutex> verrou(verrouCaches);
+            if (composantesSuivies && versionComposantes == unReseau.getVersionTopologie())
+            {
+                return composantesSuivies->getNombreComposantes();
+            }
+        }
+        return indexCourant()->nbComposantes;
+    }
+
+    /**
+     * @brief Calcule la centralité d'intermédiarité des villes et des trajets.
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @param nbEchantillons Le nombre d'origines tirées au hasard (0 : toutes).
+     * @param graine La graine du tirage.
+     * @param nbThreads Le nombre de threads (0 = tous les coeurs).
+     * @return Les scores des villes (numéros de villes) et les trajets par score décroissant.
+     * @throws std::logic_error Si un arc est négatif.
+     */
+    CentraliteReseau ReseauInterurbain::centralite(bool dureeCout, size_t nbEchantillons, uint32_t graine,
+                                                   unsigned int nbThreads) const
+    {
+        CacheVue courante = vueCourante();
+        if (!courante.nonNegatifs)
+        {
+            throw std::logic_error("centralite : les arcs ne sont pas tous non négatifs");
+        }
+        const VueAdjacence& vue = *courante.vue;
+
+        ScoresCentralite scores;
+        Centralite moteur(nbThreads);
+        moteur.calculer(vue, dureeCout, scores, nbEchantillons, graine);
+
+        CentraliteReseau resultat;
+        resultat.nbSources = scores.nbSources;
+        resultat.villes.resize(scores.sommets.size());
+        for (size_t v = 0; v < scores.sommets.size(); ++v)
+            resultat.villes[versExterne.empty() ? v : versExterne[v]] = scores.sommets[v];
+
+        resultat.trajets.reserve(scores.arcs.size());
+        for (size_t u = 0; u < vue.nbSommets(); ++u)
+        {
+            for (size_t a = vue.debut[u]; a < vue.debut[u + 1]; ++a)
+            {
+                unsigned int v = vue.destinations[a];
+                ScoreTrajet trajet = {versExterne.empty() ? u : versExterne[u],
+                                      versExterne.empty() ? v : versExterne[v], scores.arcs[a]};
+                resultat.trajets.push_back(trajet);
+            }
+        }
+        std::sort(resultat.trajets.begin(), resultat.trajets.end(), [](const ScoreTrajet& a, const ScoreTrajet& b)
+        {
+            if (a.score != b.score)
+                return a.score > b.score;
+            return a.source != b.source ? a.source < b.source : a.destination < b.destination;
+        });
+        return resultat;
+    }
+
+    /**
+     * @brief Évalue des scénarios de fermeture de trajets sans modifier le réseau.
+     * @param scenarios Pour chaque scénario, les trajets fermés (numéros de villes).
+     * @param paires Les paires origine-destination évaluées (numéros de villes).
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @param nbThreads Le nombre de threads (0 = tous les coeurs).
+     * @return Les distances et composantes de référence, et l'effet de chaque scénario.
+     * @throws std::logic_error Si une ville est hors du réseau, si un trajet fermé n'existe pas ou si un arc est négatif.
+     */
+    AnalyseFermetures ReseauInterurbain::analyserFermetures(const std::vector<std::vector<PaireVilles> >& scenarios,
+                                                            const std::vector<PaireVilles>& paires, bool dureeCout,
+                                                            unsigned int nbThreads) const
+    {
+        const size_t n = getNombreVilles();
+        auto interne = [this, n](size_t ville)
+        {
+            if (ville >= n)
+            {
+                throw std::logic_error("analyserFermetures : ville hors du réseau");
+            }
+            return static_cast<unsigned int>(versInterne.empty() ? ville : versInterne[ville]);
+        };
+
+        CacheVue courante = vueCourante();
+        if (!courante.nonNegatifs)
+        {
+            throw std::logic_error("analyserFermetures : les arcs ne sont pas tous non négatifs");
+        }
+
+        std::vector<std::pair<unsigned int, unsigned int> > pairesInternes;
+        for (const auto& paire : paires)
+            pairesInternes.push_back(std::make_pair(interne(paire.origine), interne(paire.destination)));
+        SimulateurFermetures simulateur(courante.vue, dureeCout, pairesInternes, nbThreads);
+
+        std::vector<std::vector<size_t> > arcsFermes(scenarios.size());
+        for (size_t s = 0; s < scenarios.size(); ++s)
+        {
+            for (const auto& trajet : scenarios[s])
+                arcsFermes[s].push_back(simulateur.indiceArc(interne(trajet.origine), interne(trajet.destination)));
+        }
+
+        AnalyseFermetures analyse;
+        simulateur.evaluer(arcsFermes, analyse.scenarios);
+        analyse.distancesReference = simulateur.getDistancesReference();
+        analyse.nbComposantesReference = simulateur.getNombreComposantesReference();
+
+        // Composantes par numéro de ville, numérotées par ordre de première ville
+        for (auto& impact : analyse.scenarios)
+        {
+            std::vector<unsigned int> numero(impact.nbComposantes, AUCUN);
+            std::vector<unsigned int> composante(n);
+            unsigned int prochain = 0;
+            for (size_t ville = 0; ville < n; ++ville)
+            {
+                unsigned int c = impact.composante[versInterne.empty() ? ville : versInterne[ville]];
+                if (numero[c] == AUCUN)
+                    numero[c] = prochain++;
+                composante[ville] = numero[c];
+            }
+            impact.composante.swap(composante);
+        }
+        return analyse;
+    }
+
+    /**
+     * @brief Retourne l'index d'accessibilité, reconstruit si le graphe a changé.
+     * La fermeture transitive est calculée composante par composante dans l'ordre des numéros : les successeurs
+     * d'une composante ont tous un numéro inférieur, leurs lignes sont donc déjà complètes.
+     * @return L'index de la version courante du graphe.
+     */
+    std::shared_ptr<const ReseauInterurbain::IndexAtteignabilite> ReseauInterurbain::indexCourant() const
+    {
+        // L'accessibilité ne dépend pas des noms ni des pondérations : l'index suit la version de la topologie
+        CacheVue courante = vueCourante();
+        unsigned long topologie = unReseau.getVersionTopologie();
+        {
+            std::lock_guard<std::mutex> verrou(verrouCaches);
+            if (cacheAtteignabilite && versionAtteignabilite == topologie)
+            {
+                return cacheAtteignabilite;
+            }
+        }
+
+        const VueAdjacence& vue = *courante.vue;
+        size_t n = vue.nbSommets();
+        auto index = std::make_shared<IndexAtteignabilite>();
+
+        // Composantes : lues dans les composantes incrémentales si elles sont à jour, sinon recalculées
+        bool calculees = false;
+        {
+            std::lock_guard<std::mutex> verrou(verrouCaches);
+            if (composantesSuivies && versionComposantes == topologie)
+            {
+                index->nbComposantes = composantesSuivies->numeroter(index->composante);
+                calculees = true;
+            }
+        }
+        if (!calculees)
+        {
+            if (n >= SEUIL_COMPOSANTES_PARALLELES)
+            {
+                ComposantesParalleles moteur;
+                index->nbComposantes = moteur.calculer(vue, *courante.inverse, index->composante);
+            }
+            else
+            {
+                index->nbComposantes = composantesFortementConnexes(vue, *courante.inverse, index->composante);
+            }
+
+            std::lock_guard<std::mutex> verrou(verrouCaches);
+            if (composantesIncrementales)
+            {
+                composantesSuivies = std::make_shared<ComposantesDynamiques>(vue, index->composante,
+                                                                             index->nbComposantes);
+                versionComposantes = topologie;
+            }
+        }
+        size_t nbComposantes = index->nbComposantes;
+
+        // Regrouper les sommets par composante
+        std::vector<size_t> debutMembres(nbComposantes + 1, 0);
+        for (size_t s = 0; s < n; ++s)
+            debutMembres[index->composante[s] + 1]++;
+        for (size_t c = 0; c < nbComposantes; ++c)
+            debutMembres[c + 1] += debutMembres[c];
+        std::vector<unsigned int> membres(n);
+        std::vector<size_t> position(debutMembres.begin(), debutMembres.end() - 1);
+        for (size_t s = 0; s < n; ++s)
+            membres[position[index->composante[s]]++] = static_cast<unsigned int>(s);
+
+        // Graphe des composantes sans doublons (marque = dernière composante ayant ajouté ce successeur)
+        std::vector<unsigned int> marque(nbComposantes, AUCUN);
+        index->debutComposantes.assign(1, 0);
+        for (size_t c = 0; c < nbComposantes; ++c)
+        {
+            for (size_t m = debutMembres[c]; m < debutMembres[c + 1]; ++m)
+            {
+                unsigned int u = membres[m];
+                for (size_t a = vue.debut[u]; a < vue.debut[u + 1]; ++a)
+                {
+                    unsigned int cv = index->composante[vue.destinations[a]];
+                    if (cv != c && marque[cv] != c)
+                    {
+                        marque[cv] = static_cast<unsigned int>(c);
+                        index->successeurs.push_back(cv);
+                    }
+                }
+            }
+            index->debutComposantes.push_back(index->successeurs.size());
+        }
+
+        // Fermeture transitive en bitsets
+        index->motsParLigne = 0;
+        if (nbComposantes <= SEUIL_FERMETURE)
+        {
+            size_t mots = (nbComposantes + 63) / 64;
+            index->motsParLigne = mots;
+            index->fermeture.assign(nbComposantes * mots, 0);
+            for (size_t c = 0; c < nbComposantes; ++c)
+            {
+                uint64_t* ligne = &index->fermeture[c * mots];
+                ligne[c / 64] |= uint64_t(1) << (c % 64);
+                for (size_t a = index->debutComposantes[c]; a < index->debutComposantes[c + 1]; ++a)
+                {
+                    const uint64_t* ligneSuccesseur = &index->fermeture[index->successeurs[a] * mots];
+                    for (size_t w = 0; w < mots; ++w)
+                        ligne[w] |= ligneSuccesseur[w];
+                }
+            }
+        }
+
+        std::lock_guard<std::mutex> verrou(verrouCaches);
+        cacheAtteignabilite = index;
+        versionAtteignabilite = topologie;
+        return cacheAtteignabilite;
+    }
+
+    /**
+     * @brief Vérifie avec l'index si destination est atteignable depuis source.
+     * @param index L'index d'accessibilité.
+     * @param source Le numéro du sommet de départ.
+     * @param destination Le numéro du sommet d'arrivée.
+     * @return true si un chemin existe.
+     */
+    bool ReseauInterurbain::atteignable(const IndexAtteignabilite& index, size_t source, size_t destination) const
+    {
+        unsigned int cs = index.composante[source];
+        unsigned int cd = index.composante[destination];
+        if (cs == cd)
+            return true;
+        if (cd > cs)
+            return false;	// Les arcs entre composantes vont toujours vers un numéro inférieur
+        if (index.motsParLigne != 0)
+            return (index.fermeture[cs * index.motsParLigne + cd / 64] >> (cd % 64)) & 1;
+
+        // Sans fermeture matérialisée : parcours du graphe des composantes, limité aux numéros >= cd
+        std::vector<bool> visitees(cs + 1, false);
+        std::vector<unsigned int> aVisiter(1, cs);
+        visitees[cs] = true;
+        while (!aVisiter.empty())
+        {
+            unsigned int c = aVisiter.back();
+            aVisiter.pop_back();
+            for (size_t a = index.debutComposantes[c]; a < index.debutComposantes[c + 1]; ++a)
+            {
+                unsigned int suivante = index.successeurs[a];
+                if (suivante == cd)
+                    return true;
+                if (suivante > cd && !visitees[suivante])
+                {
+                    visitees[suivante] = true;
+                    aVisiter.push_back(suivante);
+                }
+            }
+        }
+        return false;
+    }
+
+/**
+ * @brief Renvoie le nom du réseau interurbain.
+ * @return Le nom du réseau interurbain.
+ */
     std::string ReseauInterurbain::getNomReseau() const {
         return nomReseau;
     }
@@ -288,4 +2679,39 @@ namespace TP2
         return unReseau.getNombreSommets();
     }
 
+    const Graphe& ReseauInterurbain::getGraphe() const
+    {
+        return unReseau;
+    }
+
+    std::shared_ptr<const VueAdjacence> ReseauInterurbain::getVueAdjacence() const
+    {
+        return vueCourante().vue;
+    }
+
+/**
+ * @brief Renvoie le numéro d'une ville dans l'ordre du fichier.
+ * @param nom Le nom de la ville.
+ * @return Le numéro externe de la ville.
+ * @throws std::logic_error Si la ville n'existe pas dans le réseau.
+ */
+    size_t ReseauInterurbain::getNumeroVille(const std::string& nom) const {
+        size_t numero = unReseau.getNumeroSommet(nom);
+        return versExterne.empty() ? numero : versExterne[numero];
+    }
+
+/**
+ * @brief Renvoie le nom d'une ville à partir de son numéro dans l'ordre du fichier.
+ * @param numero Le numéro externe de la ville.
+ * @return Le nom de la ville.
+ * @throws std::logic_error Si le numéro est hors du réseau.
+ */
+    const std::string& ReseauInterurbain::getNomVille(size_t numero) const {
+        if (numero >= getNombreVilles())
+        {
+            throw std::logic_error("getNomVille : ville hors du réseau");
+        }
+        return unReseau.getNomSommet(versInterne.empty() ? numero : versInterne[numero]);
+    }
+
 }//Fin du namespace TP2
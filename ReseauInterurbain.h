@@ -17,6 +17,17 @@
 #include <vector>
 #include <list>
 #include <cfloat>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include "AllocateurAligne.h"
+#include "ArbreDynamique.h"
+#include "BalayagePhast.h"
+#include "ComposantesDynamiques.h"
+#include "EtiquettesHubs.h"
+#include "JournalMutations.h"
+#include "PlanificateurCellules.h"
+#include "SimulateurFermetures.h"
 //vous pouvez inclure d'autres librairies de la STL si vous pensez les utiliser
 
 
@@ -38,6 +49,94 @@ namespace TP2
         bool reussi;				// Un booléen qui vaut true si le chemin a été trouvé, false sinon
     };
 
+    // Tampon fourni par l'appelant aux recherches par numéros de villes.
+    // Réutilisé d'une requête à l'autre, il évite toute allocation une fois sa capacité atteinte.
+    struct TamponChemin
+    {
+        std::vector<unsigned int> sommets;	// Les numéros des villes du chemin, de l'origine à la destination
+        std::vector<float> troncons;		// troncons[i] : pondération du trajet sommets[i] -> sommets[i + 1]
+    };
+
+    // Résultat d'une recherche par numéros de villes. Ne copie aucun nom : les sommets sont lus dans le tampon
+    // de l'appelant et les noms, résolus à la demande, sont des références dans la table des noms du graphe
+    // (valides tant que le tampon et le réseau ne sont pas modifiés).
+    struct CheminIds
+    {
+        const TamponChemin* tampon;
+        const Graphe* graphe;
+        const std::vector<unsigned int>* versExterne;	// Numéros externes des sommets internes (nullptr : identité)
+        float total;	// Durée ou coût total selon le critère de la recherche
+        bool reussi;	// true si le chemin a été trouvé
+
+        size_t nombreSommets() const { return tampon->sommets.size(); }
+        unsigned int sommet(size_t i) const
+        {
+            return versExterne ? (*versExterne)[tampon->sommets[i]] : tampon->sommets[i];
+        }
+        float troncon(size_t i) const { return tampon->troncons[i]; }
+        const std::string& nomVille(size_t i) const { return graphe->getNomSommet(tampon->sommets[i]); }
+    };
+
+    // Ordre de numérotation interne des villes. Les numéros vus par l'utilisateur (ordre du fichier) ne changent pas;
+    // seul l'emplacement des villes en mémoire change, pour que les voisins d'une ville soient proches les uns des autres.
+    enum class OrdreSommets
+    {
+        Fichier,				// Ordre du fichier (aucune renumérotation)
+        ParcoursLargeur,		// Ordre d'un parcours en largeur du graphe non orienté sous-jacent
+        CuthillMcKeeInverse		// Cuthill-McKee inverse : parcours en largeur par degrés croissants, renversé
+    };
+
+    // Hub le plus proche d'une ville (voir ReseauInterurbain::hubsLesPlusProches)
+    struct HubLePlusProche
+    {
+        size_t hub;			// Numéro du hub le plus proche; nombre de villes si aucun hub n'est atteignable
+        float distance;		// Durée ou coût de la ville jusqu'à ce hub (+infini si aucun)
+    };
+
+    // Score d'intermédiarité d'un trajet (voir ReseauInterurbain::centralite)
+    struct ScoreTrajet
+    {
+        size_t source;			// Numéros des villes du trajet
+        size_t destination;
+        double score;
+    };
+
+    // Centralité d'intermédiarité des villes et des trajets d'un réseau
+    struct CentraliteReseau
+    {
+        std::vector<double> villes;			// villes[v] : plus courts chemins passant par la ville v (extrémités exclues)
+        std::vector<ScoreTrajet> trajets;	// Tous les trajets, par score décroissant
+        size_t nbSources;					// Nombre d'origines parcourues (toutes, ou l'échantillon)
+    };
+
+    // Deux villes désignées par leur numéro : paire origine-destination ou trajet
+    struct PaireVilles
+    {
+        size_t origine;
+        size_t destination;
+    };
+
+    // Résultat de ReseauInterurbain::analyserFermetures
+    struct AnalyseFermetures
+    {
+        std::vector<float> distancesReference;	// Distance de chaque paire sans fermeture
+        size_t nbComposantesReference;
+        std::vector<ImpactFermeture> scenarios;	// Un par scénario; composantes indexées par numéro de ville et
+                                                // numérotées dans l'ordre des villes (comparables d'un scénario à l'autre)
+    };
+
+    // Moteur utilisé par rechercheCheminDijkstra pour calculer le plus court chemin
+    enum class MoteurRecherche
+    {
+        Automatique,	// Choisit Dense ou Tas selon le nombre de villes et de trajets
+        Reference,	// Balayage scalaire O(V²) d'origine
+        Dense,		// Balayage vectorisé O(V²) sur une matrice de pondérations
+        Tas,		// File de priorité sur la vue d'adjacence, O((V + E) log V)
+        ToutesPaires,	// Lecture dans la table de toutes les paires (voir activerTableToutesPaires)
+        Dynamique,		// Lecture dans l'arbre d'une origine suivie (voir suivreOrigine)
+        Etiquettes		// Fusion des étiquettes de hubs (voir activerEtiquettesHubs)
+    };
+
     class ReseauInterurbain{
 
     public:
@@ -45,6 +144,21 @@ namespace TP2
         std::string getNomReseau() const;
 
         size_t getNombreVilles() const;
+
+        // Accès en lecture au graphe (numéros internes : voir renumeroterVilles)
+        const Graphe& getGraphe() const;
+
+        // Vue d'adjacence du graphe (numéros internes), partagée avec les moteurs de recherche; reconstruite
+        // seulement si le graphe a changé
+        std::shared_ptr<const VueAdjacence> getVueAdjacence() const;
+
+        // Retourne le numéro d'une ville (ordre du fichier, indépendant de la renumérotation interne)
+        // Exception logic_error si nom n'existe pas dans le réseau
+        size_t getNumeroVille(const std::string& nom) const;
+
+        // Retourne le nom d'une ville à partir de son numéro
+        // Exception logic_error si numero supérieur au nombre de villes
+        const std::string& getNomVille(size_t numero) const;
         // Constructeur
         ReseauInterurbain(std::string nomReseau, size_t nbVilles = 10);
 
@@ -52,6 +166,8 @@ namespace TP2
         ~ReseauInterurbain();
 
         // Change la taille du réseau en utilisant un nombre de villes = nouvelleTaille
+        // Les origines suivies hors du nouveau réseau sont abandonnées
+        // Un réseau renuméroté est d'abord remis dans l'ordre du fichier
         void resize(size_t nouvelleTaille);
 
         //Ne touchez pas à cette fonction !
@@ -66,7 +182,40 @@ namespace TP2
         // fichierEntree est ouvert corectement.
         // fichierEntree n'est pas fermé par la fonction.
         // Exception logic_error si fichierEntree n'est pas ouvert correctement.
-        void chargerReseau(std::ifstream & fichierEntree);
+        // ordre : renumérotation interne appliquée après le chargement (voir OrdreSommets).
+        // Les trajets sont analysés par morceaux sur nbThreads threads (0 = tous les coeurs).
+        void chargerReseau(std::ifstream & fichierEntree, OrdreSommets ordre = OrdreSommets::Fichier,
+                           unsigned int nbThreads = 0);
+
+        // Écrit le réseau au format texte lu par chargerReseau (villes dans l'ordre de leurs numéros)
+        // Exception logic_error si fichierSortie n'est pas ouvert correctement
+        void sauvegarderReseau(std::ofstream & fichierSortie) const;
+
+        // Rend les modifications persistantes. Charge l'instantané binaire cheminBase (ou l'écrit à partir du réseau
+        // courant s'il n'existe pas), rejoue le journal cheminJournal, puis y enregistre chaque modification faite par
+        // ajouterArc, enleverArc, nommer et modifierPonderations. Les modifications sont écrites par groupes : voir
+        // synchroniserJournal. seuilCompaction : taille du journal (octets) qui déclenche compacterJournal (0 = jamais).
+        // Exception logic_error si un fichier est illisible ou corrompu, ou si une modification rejouée échoue
+        void ouvrirJournal(const std::string& cheminBase, const std::string& cheminJournal, size_t seuilCompaction = 0);
+
+        // Écrit sur le disque les modifications journalisées encore en mémoire
+        // Exception logic_error si aucun journal n'est ouvert ou si l'écriture échoue
+        void synchroniserJournal();
+
+        // Intègre le journal dans un nouvel instantané, puis vide le journal
+        // Exception logic_error si aucun journal n'est ouvert ou si l'écriture échoue
+        void compacterJournal();
+
+        // Synchronise et ferme le journal; les modifications suivantes ne sont plus journalisées
+        void fermerJournal();
+
+        // Vide les caches (vue d'adjacence, matrice dense, tables, index). Ils sont reconstruits au prochain besoin;
+        // utile pour mesurer les temps de calcul sans l'effet des caches.
+        void viderCaches();
+
+        // Renumérote les villes en mémoire pour améliorer la localité des recherches.
+        // Les numéros utilisés par getNumeroVille et rechercheCheminIds restent ceux du fichier.
+        void renumeroterVilles(OrdreSommets ordre);
 
         // Trouve le plus court chemin entre une ville source et une ville destination en utilsiant l'algorithme de Dijkstra
         // si dureeCout = true, on utilise la durée comme pondération au niveau des trajets
@@ -74,10 +223,137 @@ namespace TP2
         // Exception std::logic_error si origine et/ou destination absent du réseau
         Chemin rechercheCheminDijkstra(const std::string& origine, const std::string& destination, bool dureeCout) const;
 
+        // Même recherche, en imposant le moteur utilisé
+        Chemin rechercheCheminDijkstra(const std::string& origine, const std::string& destination, bool dureeCout,
+                                       MoteurRecherche moteur) const;
+
+        // Même recherche à partir des numéros de villes; le chemin est écrit dans le tampon de l'appelant.
+        // MoteurRecherche::Reference n'est pas disponible par numéros.
+        // Exception std::logic_error si origine et/ou destination absent du réseau
+        CheminIds rechercheCheminIds(size_t origine, size_t destination, bool dureeCout, TamponChemin& tampon,
+                                     MoteurRecherche moteur = MoteurRecherche::Automatique) const;
+
+        // Retourne le moteur que choisit MoteurRecherche::Automatique pour le réseau courant
+        MoteurRecherche moteurAutomatique() const;
+
+        // Active la table de toutes les paires : les distances et le prochain sommet de chaque plus court chemin
+        // sont précalculés pour les deux critères, et rechercheCheminDijkstra devient une simple lecture.
+        // La table est construite à la première recherche, puis reconstruite automatiquement si le réseau change.
+        // Ignorée au-delà de SEUIL_TOUTES_PAIRES villes.
+        void activerTableToutesPaires(bool active, unsigned int nbThreads = 0);
+
+        // Active l'index d'étiquettes de hubs (voir EtiquettesHubs) : une distance devient la fusion de deux
+        // étiquettes triées, et le chemin est déplié à partir des étiquettes. L'index d'un critère est construit à
+        // sa première utilisation, puis reconstruit si le réseau change : il convient à un réseau stable.
+        void activerEtiquettesHubs(bool active);
+
+        // Distance de origine à destination (numéros de villes) lue dans l'index d'étiquettes de hubs, construit
+        // au besoin, même si l'index n'est pas activé pour rechercheCheminDijkstra. +infini si aucun chemin.
+        // Exception std::logic_error si une ville est hors du réseau ou si un arc est négatif
+        float distanceEtiquettes(size_t origine, size_t destination, bool dureeCout) const;
+
+        // Distances de chaque origine vers toutes les villes : distances[i * getNombreVilles() + v] reçoit la
+        // distance de origines[i] à la ville v (+infini si elle n'est pas atteignable). Les origines sont traitées
+        // par groupes de BalayagePhast::LARGEUR dans un même balayage de la hiérarchie de contraction, construite à
+        // la première utilisation d'un critère puis reconstruite si le réseau change.
+        // Exception std::logic_error si une origine est hors du réseau ou si un arc est négatif
+        void distancesMultiOrigines(const std::vector<size_t>& origines, bool dureeCout, std::vector<float>& distances,
+                                    unsigned int nbThreads = 0) const;
+
+        // Plus court chemin pour la pondération coefDuree * duree + coefCout * cout (voir PlanificateurCellules).
+        // La partition en cellules est calculée une fois par topologie; une nouvelle métrique, ou un changement de
+        // pondérations, ne demande qu'une personnalisation. Les dernières métriques personnalisées sont gardées.
+        // Exception std::logic_error si origine et/ou destination absent du réseau, ou si une pondération est négative
+        Chemin rechercheCheminPersonnalise(const std::string& origine, const std::string& destination,
+                                           float coefDuree, float coefCout) const;
+
+        // Donne un nom à une ville à partir de son numéro (ordre du fichier)
+        // Exception logic_error si numero supérieur au nombre de villes
+        void nommer(size_t numero, const std::string& nom);
+
+        // Modifie les pondérations d'un trajet existant (retard, changement de tarif).
+        // Les arbres des origines suivies sont réparés incrémentalement plutôt que recalculés.
+        // Exception logic_error si source et/ou destination absent du réseau, ou si le trajet n'existe pas
+        void modifierPonderations(const std::string& source, const std::string& destination, float duree, float cout);
+
+        // Maintient en permanence les plus courts chemins (deux critères) depuis origine. Les recherches depuis
+        // cette origine deviennent une lecture, et modifierPonderations ne répare que la partie touchée des arbres.
+        // Exception logic_error si origine absent du réseau
+        void suivreOrigine(const std::string& origine);
+
         // Trouve l’ensemble des composantes fortement connexes en utilisant l'algorithme de Kosaraju
         // Retourne un vecteur de vecteurs de chaînes caractères. Chaque sous-vecteur représente une composante.
         std::vector<std::vector<std::string> > algorithmeKosaraju();
 
+        // Retourne les villes atteignables depuis origine avec une durée (dureeCout = true) ou un coût total
+        // inférieur ou égal à budget, par distance croissante (origine comprise). La recherche s'arrête au budget.
+        // Exception std::logic_error si origine absent du réseau ou si un arc est négatif
+        std::vector<std::string> villesAtteignables(const std::string& origine, float budget, bool dureeCout) const;
+
+        // Version par lots : resultats[i] contient les numéros (triés) des villes atteignables depuis origines[i].
+        // Les origines sont réparties sur nbThreads threads (0 = tous les coeurs), chacun réutilisant son espace de travail.
+        // Exception std::logic_error si une origine est hors du réseau ou si un arc est négatif
+        std::vector<std::vector<unsigned int> > villesAtteignables(const std::vector<size_t>& origines, float budget,
+                                                                  bool dureeCout, unsigned int nbThreads = 0) const;
+
+        // Pour chaque ville (indice = numéro de la ville), le hub de la liste hubs le plus proche en partant de la
+        // ville, et sa distance. Une seule recherche multi-sources sur le graphe inverse, O((V + E) log V).
+        // Exception std::logic_error si un hub est absent du réseau ou si un arc est négatif
+        std::vector<HubLePlusProche> hubsLesPlusProches(const std::vector<std::string>& hubs, bool dureeCout) const;
+
+        // Plus courts chemins depuis origine vers toutes les villes (indices et valeurs = numéros de villes).
+        // distances[v] : +infini si v n'est pas atteignable; predecesseurs[v] : UINT_MAX pour l'origine et les villes
+        // non atteignables. Parmi les prédécesseurs possibles, le choix est fixé par les seules distances (voir
+        // predecesseursCanoniques) : les deux versions retournent exactement les mêmes tableaux.
+        // Exception std::logic_error si origine est hors du réseau ou si un arc est négatif
+        void plusCourtsCheminsDepuis(size_t origine, bool dureeCout, std::vector<float>& distances,
+                                     std::vector<unsigned int>& predecesseurs) const;
+
+        // Même calcul par delta-stepping sur nbThreads threads (0 = tous les coeurs), pour les très grands réseaux
+        void plusCourtsCheminsDepuisParallele(size_t origine, bool dureeCout, std::vector<float>& distances,
+                                              std::vector<unsigned int>& predecesseurs, unsigned int nbThreads = 0) const;
+
+        // Vérifie en O(1) s'il existe un chemin de origine vers destination, à l'aide de la fermeture transitive
+        // du graphe des composantes fortement connexes (construite au premier appel, puis après chaque modification).
+        // Exception std::logic_error si origine et/ou destination absent du réseau
+        bool estAtteignable(const std::string& origine, const std::string& destination) const;
+
+        // Ajoute un trajet entre deux villes existantes. Si les composantes incrémentales sont actives et à jour,
+        // elles sont mises à jour sans recalcul (fusion des composantes si le trajet ferme un circuit).
+        // Exception logic_error si source et/ou destination absent du réseau, ou si le trajet existe déjà
+        void ajouterArc(const std::string& source, const std::string& destination, float duree, float cout);
+
+        // Retire un trajet. Les composantes sont recalculées à la prochaine requête.
+        // Exception logic_error si source et/ou destination absent du réseau, ou si le trajet n'existe pas
+        void enleverArc(const std::string& source, const std::string& destination);
+
+        // Active le maintien incrémental des composantes fortement connexes lors des ajouts de trajets :
+        // memeComposante devient une lecture et l'index d'accessibilité n'a plus à recalculer les composantes.
+        void activerComposantesIncrementales(bool active);
+
+        // Vérifie si deux villes sont dans la même composante fortement connexe
+        // Exception std::logic_error si origine et/ou destination absent du réseau
+        bool memeComposante(const std::string& ville1, const std::string& ville2) const;
+
+        // Retourne le nombre de composantes fortement connexes du réseau
+        size_t getNombreComposantes() const;
+
+        // Centralité d'intermédiarité (Brandes) des villes et des trajets pour le critère dureeCout, calculée en
+        // parallèle sur les origines (nbThreads : 0 = tous les coeurs). nbEchantillons > 0 : estimation à partir
+        // de ce nombre d'origines tirées au hasard avec graine, pour les grands réseaux.
+        // Exception std::logic_error si un arc est négatif
+        CentraliteReseau centralite(bool dureeCout, size_t nbEchantillons = 0, uint32_t graine = 0,
+                                    unsigned int nbThreads = 0) const;
+
+        // Évalue des scénarios de fermeture de trajets (scenarios[i] : trajets fermés, source -> destination) sur
+        // les distances des paires données et sur les composantes fortement connexes, sans modifier le réseau :
+        // les trajets fermés sont masqués sur un instantané de la vue d'adjacence. Scénarios évalués en parallèle.
+        // Exception std::logic_error si une ville est hors du réseau, si un trajet fermé n'existe pas ou si un arc
+        // est négatif
+        AnalyseFermetures analyserFermetures(const std::vector<std::vector<PaireVilles> >& scenarios,
+                                             const std::vector<PaireVilles>& paires, bool dureeCout,
+                                             unsigned int nbThreads = 0) const;
+
         //Vous pouvez ajoutez d'autres méthodes publiques si vous sentez leur nécessité
 
     private:
@@ -91,8 +367,200 @@ namespace TP2
 
         const float MAX = FLT_MAX;
 
+        // Au-delà de ce nombre de villes, la matrice dense n'est jamais construite (4 Mo par critère)
+        static const size_t SEUIL_DENSE = 1024;
+
+        // Matrice des pondérations pour le moteur dense. Chaque ligne compte pas >= n colonnes
+        // (multiple de 8); les arcs absents et les colonnes de remplissage valent +infini.
+        struct MatriceDense
+        {
+            size_t n;
+            size_t pas;
+            VecteurAligne<float> durees;
+            VecteurAligne<float> couts;
+        };
+
+        // Au-delà de ce nombre de villes, la table de toutes les paires n'est pas utilisée (16 Mo)
+        static const size_t SEUIL_TOUTES_PAIRES = 1024;
+
+        // Nombre de métriques personnalisées gardées par rechercheCheminPersonnalise
+        static const size_t NB_METRIQUES_CELLULES = 4;
+
+        // Distances et prochains sommets entre toutes les paires, pour les deux critères (matrices n x n)
+        struct TableToutesPaires
+        {
+            size_t n;
+            std::vector<float> durees;
+            std::vector<float> couts;
+            std::vector<unsigned int> suivantsDuree;
+            std::vector<unsigned int> suivantsCout;
+        };
+
+        // Au-delà de ce nombre de composantes, la fermeture transitive n'est pas matérialisée (32 Mo)
+        // et estAtteignable parcourt le graphe des composantes.
+        static const size_t SEUIL_FERMETURE = 16384;
+
+        // À partir de ce nombre de villes, les composantes sont calculées en parallèle (ComposantesParalleles)
+        static const size_t SEUIL_COMPOSANTES_PARALLELES = 65536;
+
+        // Composantes fortement connexes et accessibilité entre composantes
+        struct IndexAtteignabilite
+        {
+            std::vector<unsigned int> composante;	// Composante de chaque sommet. Les arcs du graphe des composantes
+                                                // vont toujours d'une composante vers une composante de numéro inférieur.
+            size_t nbComposantes;
+            std::vector<size_t> debutComposantes;	// Graphe des composantes (CSR), sans doublons
+            std::vector<unsigned int> successeurs;
+            size_t motsParLigne;				// 0 si la fermeture n'est pas matérialisée
+            std::vector<uint64_t> fermeture;	// Ligne c : bit d à 1 si la composante c atteint la composante d
+        };
+
+        // Arbres des plus courts chemins d'une origine suivie
+        struct OrigineSuivie
+        {
+            size_t ville;						// Numéro externe de l'origine
+            std::shared_ptr<ArbreDynamique> arbreDuree;
+            std::shared_ptr<ArbreDynamique> arbreCout;
+            unsigned long version;				// Version du graphe décrite par les arbres
+        };
+
+        // Espace de travail d'une recherche bornée, réutilisé d'une origine à l'autre : seules les distances
+        // des sommets touchés sont remises à +infini
+        struct EspaceRecherche
+        {
+            std::vector<float> distances;
+            std::vector<unsigned int> touches;
+            std::vector<std::pair<float, unsigned int> > tas;
+        };
+
+        // Vue d'adjacence du graphe pour une version donnée
+        struct CacheVue
+        {
+            std::shared_ptr<const VueAdjacence> vue;
+            std::shared_ptr<const VueAdjacence> inverse;	// Vue du graphe inverse
+            bool nonNegatifs;
+            unsigned long version;
+        };
+
+        std::vector<unsigned int> versInterne;	// Numéro interne de chaque ville (vide : identité)
+        std::vector<unsigned int> versExterne;	// Numéro externe de chaque sommet interne (vide : identité)
+
+        mutable std::mutex verrouCaches;	// Protège les caches ci-dessous
+        mutable CacheVue cacheVue;
+        mutable std::shared_ptr<const MatriceDense> cacheDense;
+        mutable unsigned long versionDense;
+        mutable std::shared_ptr<const TableToutesPaires> cacheToutesPaires;
+        mutable unsigned long versionToutesPaires;
+        mutable std::shared_ptr<const EtiquettesHubs> cacheEtiquettesDuree;
+        mutable std::shared_ptr<const EtiquettesHubs> cacheEtiquettesCout;
+        mutable unsigned long versionEtiquettesDuree;
+        mutable unsigned long versionEtiquettesCout;
+        mutable std::shared_ptr<const BalayagePhast> cacheBalayageDuree;
+        mutable std::shared_ptr<const BalayagePhast> cacheBalayageCout;
+        mutable unsigned long versionBalayageDuree;
+        mutable unsigned long versionBalayageCout;
+        mutable std::shared_ptr<PlanificateurCellules> cachePlanificateur;
+        mutable unsigned long versionPlanificateur;	// Version de la topologie partitionnée
+        mutable std::vector<std::shared_ptr<const MetriqueCellules> > cacheMetriques;	// Du plus ancien au plus récent
+        mutable unsigned long versionMetriques;
+        mutable std::shared_ptr<const IndexAtteignabilite> cacheAtteignabilite;
+        mutable unsigned long versionAtteignabilite;
+        mutable std::vector<OrigineSuivie> originesSuivies;
+        mutable std::shared_ptr<VuesArbres> vuesArbres;	// Copie du graphe lue par les arbres de toutes les origines
+        mutable unsigned long versionVuesArbres;
+        mutable std::shared_ptr<ComposantesDynamiques> composantesSuivies;	// Composantes incrémentales
+        mutable unsigned long versionComposantes;	// Version de la topologie décrite par composantesSuivies
+        bool composantesIncrementales;
+
+        std::unique_ptr<JournalMutations> journal;	// Journal des modifications (nullptr : pas de journal)
+        std::string cheminBase;					// Instantané que le journal complète
+        uint64_t generationBase;
+        size_t seuilCompaction;
+        bool toutesPairesActive;
+        unsigned int threadsToutesPaires;
+        bool etiquettesActives;
+
         //Vous pouvez ajoutez d'autres méthodes privées si vous sentez leur nécessité
 
+        // Le balayage scalaire O(V²) d'origine (MoteurRecherche::Reference)
+        Chemin rechercheCheminReference(const std::string& source, const std::string& destination, bool dureeCout) const;
+
+        // Retourne la vue d'adjacence du graphe, reconstruite si le graphe a changé
+        CacheVue vueCourante() const;
+
+        // Retourne la matrice dense du graphe, reconstruite si le graphe a changé
+        std::shared_ptr<const MatriceDense> matriceCourante() const;
+
+        // Retourne la table de toutes les paires, reconstruite si le graphe a changé
+        std::shared_ptr<const TableToutesPaires> tableCourante() const;
+
+        // Retourne l'index d'étiquettes de hubs d'un critère, reconstruit si le graphe a changé
+        std::shared_ptr<const EtiquettesHubs> etiquettesCourantes(bool dureeCout) const;
+
+        // Retourne la hiérarchie de contraction d'un critère, reconstruite si le graphe a changé
+        std::shared_ptr<const BalayagePhast> balayageCourant(bool dureeCout) const;
+
+        // Retourne la métrique personnalisée (coefDuree, coefCout) de la version courante du graphe, et dans
+        // planificateur la partition à laquelle elle se rapporte
+        std::shared_ptr<const MetriqueCellules> metriqueCourante(float coefDuree, float coefCout,
+                                                                 std::shared_ptr<const PlanificateurCellules>& planificateur) const;
+
+        // Retourne l'arbre de l'origine suivie source (numéro interne) pour un critère, reconstruit s'il est périmé.
+        // Retourne nullptr si source n'est pas suivie.
+        std::shared_ptr<const ArbreDynamique> arbreSuivi(size_t source, bool dureeCout) const;
+
+        // Dijkstra depuis source, arrêté au budget; atteintes reçoit les sommets solutionnés par distance croissante
+        static void rechercheBornee(const VueAdjacence& vue, size_t source, float budget, bool dureeCout,
+                                    EspaceRecherche& espace, std::vector<unsigned int>& atteintes);
+
+        // Retourne l'index d'accessibilité, reconstruit si le graphe a changé
+        std::shared_ptr<const IndexAtteignabilite> indexCourant() const;
+
+        // Vérifie avec l'index si le sommet destination est atteignable depuis le sommet source
+        bool atteignable(const IndexAtteignabilite& index, size_t source, size_t destination) const;
+
+        // Kosaraju itératif : numérote les composantes fortement connexes du graphe (vue et vue inverse),
+        // les puits du graphe des composantes en premier. Retourne le nombre de composantes.
+        static size_t composantesFortementConnexes(const VueAdjacence& vue, const VueAdjacence& inverse,
+                                                   std::vector<unsigned int>& composante);
+
+        // Dijkstra par balayage de la matrice dense; s'arrête dès que destination est solutionnée
+        void dijkstraDense(const MatriceDense& matrice, size_t source, size_t destination, bool dureeCout,
+                           std::vector<float>& distances, std::vector<unsigned int>& predecesseurs) const;
+
+        // Dijkstra avec un tas binaire sur la vue d'adjacence; s'arrête dès que destination est solutionnée
+        void dijkstraTas(const VueAdjacence& vue, size_t source, size_t destination, bool dureeCout,
+                         std::vector<float>& distances, std::vector<unsigned int>& predecesseurs) const;
+
+        // Déduit les prédécesseurs des distances : le plus petit sommet u tel que distances[u] + poids(u, v) = distances[v]
+        // et distances[u] < distances[v]; les sommets restants (arcs de poids nul) sont rattachés par un parcours en
+        // largeur. inverse et vue sont les vues du graphe inverse et du graphe.
+        static void predecesseursCanoniques(const VueAdjacence& vue, const VueAdjacence& inverse, size_t source,
+                                            bool dureeCout, const std::vector<float>& distances,
+                                            std::vector<unsigned int>& predecesseurs, unsigned int nbThreads);
+
+        // Remet distances et predecesseurs (numéros internes) dans l'ordre des numéros de villes
+        void versNumerosExternes(std::vector<float>& distances, std::vector<unsigned int>& predecesseurs) const;
+
+        // Applique une modification (numéros de villes externes) sans la journaliser
+        // Exception logic_error si une ville est hors du réseau ou si le graphe refuse la modification
+        void appliquer(const Mutation& mutation);
+
+        // Enregistre une modification appliquée dans le journal (s'il est ouvert), puis compacte au besoin
+        void journaliser(const Mutation& mutation);
+
+        // Sérialise le réseau en instantané binaire
+        std::string instantane(uint64_t generation) const;
+
+        // Remplace le réseau par le contenu d'un instantané et retourne sa génération
+        // Exception logic_error si l'instantané est corrompu
+        uint64_t chargerInstantane(const std::string& contenu);
+
+        // Calcule le plus court chemin avec le moteur demandé et l'écrit dans le tampon.
+        // Retourne false (tampon vide) si la destination n'est pas atteignable.
+        bool calculerChemin(size_t source, size_t destination, bool dureeCout, MoteurRecherche moteur,
+                            TamponChemin& tampon, float& total) const;
+
 
     };
 
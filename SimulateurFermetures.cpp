@@ -0,0 +1,404 @@
+/**
+ * \file SimulateurFermetures.cpp
+ * \brief Implémentation de l'analyse de scénarios de fermeture.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include <algorithm>
+#include <climits>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+
+#include "SimulateurFermetures.h"
+
+namespace TP2
+{
+
+    namespace
+    {
+        const float INFINI = std::numeric_limits<float>::infinity();
+        const unsigned int AUCUN = UINT_MAX;
+    }
+
+    struct SimulateurFermetures::Espace
+    {
+        std::vector<uint8_t> ferme;				// Masque des arcs du scénario courant
+
+        // Dijkstra
+        std::vector<float> distances;
+        std::vector<unsigned int> arcPredecesseur;
+        std::vector<uint8_t> solutionne;
+        std::vector<uint8_t> cible;
+        std::vector<unsigned int> touches;		// Sommets dont la distance a changé
+        std::vector<std::pair<float, unsigned int> > tas;
+
+        // Tarjan
+        std::vector<unsigned int> index;
+        std::vector<unsigned int> bas;
+        std::vector<unsigned int> pile;
+        std::vector<std::pair<unsigned int, size_t> > appels;	// (sommet, prochain arc)
+        std::vector<unsigned int> cibles;
+
+        Espace(size_t n, size_t m) : ferme(m, 0), distances(n, INFINI), arcPredecesseur(n, AUCUN), solutionne(n, 0),
+                                     cible(n, 0), index(n), bas(n)
+        {
+        }
+    };
+
+    /**
+     * @brief Constructeur : calcule les distances, les chemins et les composantes de référence.
+     * @param vue La vue d'adjacence (conservée pendant toute la vie du simulateur).
+     * @param dureeCout Le critère (durée si true, coût sinon).
+     * @param paires Les paires (origine, destination) à évaluer.
+     * @param nbThreads Le nombre de threads (0 = tous les coeurs).
+     * @throws std::logic_error Si une paire est hors de la vue ou si un arc est négatif.
+     */
+    SimulateurFermetures::SimulateurFermetures(std::shared_ptr<const VueAdjacence> vue, bool dureeCout,
+                                               const std::vector<std::pair<unsigned int, unsigned int> >& paires,
+                                               unsigned int nbThreads) :
+            vue(vue), poids(&vue->ponderations(dureeCout)), paires(paires), pool(nbThreads)
+    {
+        const size_t n = vue->nbSommets();
+        for (auto p : *poids)
+        {
+            if (p < 0)
+                throw std::logic_error("SimulateurFermetures : les arcs ne sont pas tous non négatifs");
+        }
+        for (const auto& paire : paires)
+        {
+            if (paire.first >= n || paire.second >= n)
+                throw std::logic_error("SimulateurFermetures : paire hors du réseau");
+        }
+
+        for (unsigned int t = 0; t < pool.getNombreThreads(); ++t)
+            espaces.push_back(std::unique_ptr<Espace>(new Espace(n, vue->destinations.size())));
+
+        // Regrouper les paires par origine
+        ordrePaires.resize(paires.size());
+        for (size_t i = 0; i < paires.size(); ++i)
+            ordrePaires[i] = static_cast<unsigned int>(i);
+        std::stable_sort(ordrePaires.begin(), ordrePaires.end(), [&paires](unsigned int a, unsigned int b)
+        {
+            return paires[a].first < paires[b].first;
+        });
+        for (size_t i = 0; i < ordrePaires.size(); ++i)
+        {
+            if (i == 0 || paires[ordrePaires[i]].first != paires[ordrePaires[i - 1]].first)
+                debutGroupes.push_back(i);
+        }
+        debutGroupes.push_back(ordrePaires.size());
+
+        // Distances et chemins de référence, une origine par tâche
+        distancesReference.assign(paires.size(), INFINI);
+        std::vector<std::vector<unsigned int> > chemins(paires.size());
+        pool.executer(debutGroupes.size() - 1, 1, [&](size_t debut, size_t fin, unsigned int numero)
+        {
+            Espace& espace = *espaces[numero];
+            for (size_t g = debut; g < fin; ++g)
+            {
+                espace.cibles.clear();
+                for (size_t k = debutGroupes[g]; k < debutGroupes[g + 1]; ++k)
+                    espace.cibles.push_back(paires[ordrePaires[k]].second);
+                unsigned int origine = paires[ordrePaires[debutGroupes[g]]].first;
+                dijkstra(origine, espace.cibles, espace);
+                for (size_t k = debutGroupes[g]; k < debutGroupes[g + 1]; ++k)
+                {
+                    unsigned int i = ordrePaires[k];
+                    distancesReference[i] = espace.distances[paires[i].second];
+                    if (distancesReference[i] == INFINI)
+                        continue;
+                    for (unsigned int v = paires[i].second; v != origine;)
+                    {
+                        unsigned int arc = espace.arcPredecesseur[v];
+                        chemins[i].push_back(arc);
+                        v = static_cast<unsigned int>(std::upper_bound(this->vue->debut.begin(),
+                                                                       this->vue->debut.end(), arc)
+                                                      - this->vue->debut.begin() - 1);
+                    }
+                }
+                effacer(espace);
+            }
+        });
+
+        debutChemins.assign(paires.size() + 1, 0);
+        for (size_t i = 0; i < paires.size(); ++i)
+            debutChemins[i + 1] = debutChemins[i] + chemins[i].size();
+        arcsChemins.reserve(debutChemins.back());
+        for (const auto& chemin : chemins)
+            arcsChemins.insert(arcsChemins.end(), chemin.begin(), chemin.end());
+
+        size_t nbComposantes = composantes(*espaces[0], composanteReference);
+        tailleReference.assign(nbComposantes, 0);
+        for (auto c : composanteReference)
+            tailleReference[c]++;
+    }
+
+    SimulateurFermetures::~SimulateurFermetures()
+    {
+    }
+
+    /**
+     * @brief Retourne l'indice dans la vue d'un arc.
+     * @throws std::logic_error Si l'arc n'existe pas.
+     */
+    size_t SimulateurFermetures::indiceArc(unsigned int source, unsigned int destination) const
+    {
+        if (source < vue->nbSommets())
+        {
+            for (size_t a = vue->debut[source]; a < vue->debut[source + 1]; ++a)
+            {
+                if (vue->destinations[a] == destination)
+                    return a;
+            }
+        }
+        throw std::logic_error("SimulateurFermetures::indiceArc : le trajet n'existe pas");
+    }
+
+    /**
+     * @brief Évalue des scénarios de fermeture, répartis entre les threads.
+     * @param scenarios Pour chaque scénario, les indices des arcs fermés.
+     * @param resultats Reçoit l'effet de chaque scénario.
+     * @throws std::logic_error Si un indice d'arc est invalide.
+     */
+    void SimulateurFermetures::evaluer(const std::vector<std::vector<size_t> >& scenarios,
+                                       std::vector<ImpactFermeture>& resultats)
+    {
+        for (const auto& scenario : scenarios)
+        {
+            for (auto arc : scenario)
+            {
+                if (arc >= vue->destinations.size())
+                    throw std::logic_error("SimulateurFermetures::evaluer : indice d'arc invalide");
+            }
+        }
+
+        resultats.resize(scenarios.size());
+        pool.executer(scenarios.size(), 1, [&](size_t debut, size_t fin, unsigned int numero)
+        {
+            Espace& espace = *espaces[numero];
+            for (size_t s = debut; s < fin; ++s)
+            {
+                ImpactFermeture& resultat = resultats[s];
+                for (auto arc : scenarios[s])
+                    espace.ferme[arc] = 1;
+
+                // Ne recalculer que les paires dont le chemin de référence emprunte un arc fermé
+                resultat.distances = distancesReference;
+                for (size_t g = 0; g + 1 < debutGroupes.size(); ++g)
+                {
+                    espace.cibles.clear();
+                    for (size_t k = debutGroupes[g]; k < debutGroupes[g + 1]; ++k)
+                    {
+                        unsigned int i = ordrePaires[k];
+                        for (size_t c = debutChemins[i]; c < debutChemins[i + 1]; ++c)
+                        {
+                            if (espace.ferme[arcsChemins[c]])
+                            {
+                                espace.cibles.push_back(paires[i].second);
+                                break;
+                            }
+                        }
+                    }
+                    if (espace.cibles.empty())
+                        continue;
+
+                    dijkstra(paires[ordrePaires[debutGroupes[g]]].first, espace.cibles, espace);
+                    for (size_t k = debutGroupes[g]; k < debutGroupes[g + 1]; ++k)
+                    {
+                        unsigned int i = ordrePaires[k];
+                        if (espace.cible[paires[i].second])
+                            resultat.distances[i] = espace.distances[paires[i].second];
+                    }
+                    effacer(espace);
+                }
+
+                resultat.nbPairesAllongees = resultat.nbPairesCoupees = 0;
+                for (size_t i = 0; i < paires.size(); ++i)
+                {
+                    if (resultat.distances[i] == distancesReference[i])
+                        continue;
+                    if (resultat.distances[i] == INFINI)
+                        resultat.nbPairesCoupees++;
+                    else
+                        resultat.nbPairesAllongees++;
+                }
+
+                // Une fermeture ne peut que scinder des composantes
+                resultat.nbComposantes = composantes(espace, resultat.composante);
+                std::vector<unsigned int> taille(resultat.nbComposantes, 0);
+                for (auto c : resultat.composante)
+                    taille[c]++;
+                resultat.nbSommetsSepares = 0;
+                for (size_t v = 0; v < resultat.composante.size(); ++v)
+                {
+                    if (taille[resultat.composante[v]] < tailleReference[composanteReference[v]])
+                        resultat.nbSommetsSepares++;
+                }
+
+                for (auto arc : scenarios[s])
+                    espace.ferme[arc] = 0;
+            }
+        });
+    }
+
+    const std::vector<float>& SimulateurFermetures::getDistancesReference() const
+    {
+        return distancesReference;
+    }
+
+    size_t SimulateurFermetures::getNombreComposantesReference() const
+    {
+        return tailleReference.size();
+    }
+
+    /**
+     * @brief Dijkstra depuis une origine, arrêté quand toutes les cibles sont solutionnées.
+     * Une paire recalculée dont la destination n'est plus atteignable oblige à vider le tas.
+     * @param origine Le sommet de départ.
+     * @param cibles Les sommets dont la distance est demandée.
+     * @param espace Les tableaux de travail (masque compris).
+     */
+    void SimulateurFermetures::dijkstra(unsigned int origine, const std::vector<unsigned int>& cibles,
+                                        Espace& espace) const
+    {
+        typedef std::pair<float, unsigned int> Entree;
+        const VueAdjacence& graphe = *vue;
+
+        size_t restantes = 0;
+        for (auto v : cibles)
+        {
+            if (!espace.cible[v])
+            {
+                espace.cible[v] = 1;
+                restantes++;
+            }
+        }
+
+        espace.distances[origine] = 0.0;
+        espace.touches.push_back(origine);
+        espace.tas.push_back(Entree(0.0f, origine));
+        while (!espace.tas.empty() && restantes > 0)
+        {
+            std::pop_heap(espace.tas.begin(), espace.tas.end(), std::greater<Entree>());
+            unsigned int u = espace.tas.back().second;
+            espace.tas.pop_back();
+            if (espace.solutionne[u])
+                continue;
+            espace.solutionne[u] = 1;
+            if (espace.cible[u])
+                restantes--;
+
+            for (size_t a = graphe.debut[u]; a < graphe.debut[u + 1]; ++a)
+            {
+                if (espace.ferme[a])
+                    continue;
+                unsigned int v = graphe.destinations[a];
+                float tmp = espace.distances[u] + (*poids)[a];
+                if (tmp < espace.distances[v])
+                {
+                    if (espace.distances[v] == INFINI)
+                        espace.touches.push_back(v);
+                    espace.distances[v] = tmp;
+                    espace.arcPredecesseur[v] = static_cast<unsigned int>(a);
+                    espace.tas.push_back(Entree(tmp, v));
+                    std::push_heap(espace.tas.begin(), espace.tas.end(), std::greater<Entree>());
+                }
+            }
+        }
+
+        // Les cibles non atteintes gardent une distance infinie; elles sont démarquées par effacer
+        for (auto v : cibles)
+        {
+            if (espace.distances[v] == INFINI)
+                espace.touches.push_back(v);
+        }
+    }
+
+    void SimulateurFermetures::effacer(Espace& espace)
+    {
+        for (auto v : espace.touches)
+        {
+            espace.distances[v] = INFINI;
+            espace.arcPredecesseur[v] = AUCUN;
+            espace.solutionne[v] = 0;
+            espace.cible[v] = 0;
+        }
+        espace.touches.clear();
+        espace.tas.clear();
+    }
+
+    /**
+     * @brief Composantes fortement connexes par Tarjan itératif, en ignorant les arcs fermés.
+     * Un sommet visité sans composante est sur la pile de Tarjan.
+     * @param espace Les tableaux de travail (masque compris).
+     * @param composante Reçoit la composante de chaque sommet.
+     * @return Le nombre de composantes.
+     */
+    size_t SimulateurFermetures::composantes(Espace& espace, std::vector<unsigned int>& composante) const
+    {
+        const VueAdjacence& graphe = *vue;
+        const size_t n = graphe.nbSommets();
+        composante.assign(n, AUCUN);
+        std::fill(espace.index.begin(), espace.index.end(), AUCUN);
+        unsigned int compteur = 0;
+        unsigned int nbComposantes = 0;
+
+        for (size_t racine = 0; racine < n; ++racine)
+        {
+            if (espace.index[racine] != AUCUN)
+                continue;
+            espace.index[racine] = espace.bas[racine] = compteur++;
+            espace.pile.push_back(static_cast<unsigned int>(racine));
+            espace.appels.push_back(std::make_pair(static_cast<unsigned int>(racine), graphe.debut[racine]));
+
+            while (!espace.appels.empty())
+            {
+                unsigned int v = espace.appels.back().first;
+                size_t a = espace.appels.back().second;
+                if (a < graphe.debut[v + 1])
+                {
+                    espace.appels.back().second++;
+                    if (espace.ferme[a])
+                        continue;
+                    unsigned int w = graphe.destinations[a];
+                    if (espace.index[w] == AUCUN)
+                    {
+                        espace.index[w] = espace.bas[w] = compteur++;
+                        espace.pile.push_back(w);
+                        espace.appels.push_back(std::make_pair(w, graphe.debut[w]));
+                    }
+                    else if (composante[w] == AUCUN)
+                    {
+                        espace.bas[v] = std::min(espace.bas[v], espace.index[w]);
+                    }
+                    continue;
+                }
+
+                if (espace.bas[v] == espace.index[v])
+                {
+                    unsigned int w;
+                    do
+                    {
+                        w = espace.pile.back();
+                        espace.pile.pop_back();
+                        composante[w] = nbComposantes;
+                    } while (w != v);
+                    nbComposantes++;
+                }
+                espace.appels.pop_back();
+                if (!espace.appels.empty())
+                {
+                    unsigned int parent = espace.appels.back().first;
+                    espace.bas[parent] = std::min(espace.bas[parent], espace.bas[v]);
+                }
+            }
+        }
+        return nbComposantes;
+    }
+
+}//Fin du namespace TP2
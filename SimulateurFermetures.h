@@ -0,0 +1,104 @@
+/**
+ * \file SimulateurFermetures.h
+ * \brief Analyse de scénarios de fermeture de trajets sur un instantané du graphe.
+ * \author El hadji Djime Nimaga
+ * \version 0.1
+ * \date juin-juillet 2023
+ *
+ *
+ */
+
+#include "Graphe.h"
+#include "Parallelisme.h"
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#ifndef _SIMULATEURFERMETURES__H
+#define _SIMULATEURFERMETURES__H
+
+namespace TP2
+{
+
+    // Effet d'un scénario de fermeture
+    struct ImpactFermeture
+    {
+        std::vector<float> distances;		// Distance de chaque paire avec les trajets fermés (+infini si coupée)
+        size_t nbPairesAllongees;			// Paires encore reliées, mais par un chemin plus long
+        size_t nbPairesCoupees;				// Paires reliées sans la fermeture, plus du tout avec
+        size_t nbComposantes;				// Composantes fortement connexes avec les trajets fermés
+        std::vector<unsigned int> composante;	// Composante de chaque sommet avec les trajets fermés
+        size_t nbSommetsSepares;			// Sommets dont la composante a perdu des membres
+    };
+
+/**
+ * \class SimulateurFermetures
+ * \brief Évalue des scénarios de fermeture de trajets sans modifier ni copier le graphe
+ *
+ * Le simulateur garde une vue d'adjacence partagée (un instantané : le réseau peut changer pendant l'analyse)
+ * et, pour chaque scénario, un masque d'un octet par arc. Les distances de référence des paires
+ * origine-destination et l'arc de chaque chemin de référence sont calculés une seule fois : une fermeture ne
+ * peut qu'allonger les distances, si bien qu'une paire dont le chemin de référence n'emprunte aucun trajet
+ * fermé garde sa distance. Seules les autres sont recalculées, par un Dijkstra par origine qui s'arrête dès
+ * que toutes ses destinations sont solutionnées. Les composantes sont recalculées par Tarjan en ignorant les
+ * arcs masqués. Les scénarios sont répartis entre les threads, chacun avec son masque et ses tableaux.
+ */
+    class SimulateurFermetures
+    {
+    public:
+
+        // Prépare l'analyse des paires (origine, destination), en numéros de la vue, pour le critère dureeCout.
+        // nbThreads : taille du pool de travail (0 = tous les coeurs)
+        // Exception logic_error si une paire est hors de la vue ou si un arc est négatif
+        SimulateurFermetures(std::shared_ptr<const VueAdjacence> vue, bool dureeCout,
+                             const std::vector<std::pair<unsigned int, unsigned int> >& paires,
+                             unsigned int nbThreads = 0);
+
+        ~SimulateurFermetures();
+
+        // Indice dans la vue de l'arc source -> destination
+        // Exception logic_error si l'arc n'existe pas
+        size_t indiceArc(unsigned int source, unsigned int destination) const;
+
+        // Évalue chaque scénario (liste d'indices d'arcs fermés); resultats[i] décrit scenarios[i]
+        // Exception logic_error si un indice d'arc est invalide
+        void evaluer(const std::vector<std::vector<size_t> >& scenarios, std::vector<ImpactFermeture>& resultats);
+
+        // Distances de chaque paire sans fermeture
+        const std::vector<float>& getDistancesReference() const;
+
+        size_t getNombreComposantesReference() const;
+
+    private:
+
+        // Tableaux de travail d'un thread (définis dans SimulateurFermetures.cpp)
+        struct Espace;
+
+        std::shared_ptr<const VueAdjacence> vue;
+        const std::vector<float>* poids;
+        std::vector<std::pair<unsigned int, unsigned int> > paires;
+        std::vector<unsigned int> ordrePaires;		// Indices des paires triées par origine
+        std::vector<size_t> debutGroupes;			// Paires de l'origine g : ordrePaires[debutGroupes[g]..debutGroupes[g+1])
+        std::vector<float> distancesReference;
+        std::vector<size_t> debutChemins;			// Arcs du chemin de référence de la paire i :
+        std::vector<unsigned int> arcsChemins;		// arcsChemins[debutChemins[i]..debutChemins[i+1])
+        std::vector<unsigned int> composanteReference;
+        std::vector<unsigned int> tailleReference;	// Nombre de sommets de chaque composante de référence
+        std::vector<std::unique_ptr<Espace> > espaces;
+        PoolTravail pool;
+
+        // Dijkstra depuis origine en ignorant les arcs fermés de l'espace; s'arrête quand tous les sommets cibles
+        // sont solutionnés. Les distances et les arcs prédécesseurs restent dans l'espace jusqu'à effacer.
+        void dijkstra(unsigned int origine, const std::vector<unsigned int>& cibles, Espace& espace) const;
+
+        // Remet à l'état initial les sommets touchés par le dernier dijkstra
+        static void effacer(Espace& espace);
+
+        // Tarjan itératif en ignorant les arcs fermés. Retourne le nombre de composantes.
+        size_t composantes(Espace& espace, std::vector<unsigned int>& composante) const;
+    };
+
+}//Fin du namespace
+
+#endif